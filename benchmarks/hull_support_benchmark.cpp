@@ -0,0 +1,154 @@
+// 3D QuickHull: correctness of the hill-climbing support mapping and its speed against a scan of the vertices.
+//
+// Build from the repository root, e.g.:
+//     g++ -std=c++11 -O2 -Iinclude benchmarks/hull_support_benchmark.cpp src/*.cpp src/data_structures/*.cpp -pthread -o hull_support_benchmark
+//
+// For every point distribution it builds the hull and checks its structure: faces that are not convex polygons,
+// edges whose adjacent face rises above the plane of the other one (concave edges) and vertices with less than three
+// edges. Then it compares `ConvexHull::support` on random directions with a brute-force scan of the hull vertices and
+// of the input points, and prints the number of wrong answers and the time per query of both. It returns 1 if any
+// check fails.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+#include "../include/QuickHull.hh"
+
+using namespace Geometry;
+
+namespace {
+
+    using Cloud = std::vector<Vec3>;
+    using Generator = std::function<Vec3(std::mt19937&)>;
+
+    struct Defects {
+        std::size_t nonconvex_faces = 0, concave_edges = 0, thin_vertices = 0;
+    };
+
+    // Structural checks, with `tolerance` as the allowed distance from a plane
+    Defects check_structure(const ConvexHull& hull, float tolerance) {
+        Defects defects;
+        const std::vector<Vec3>& v = hull.getVertices();
+        const std::vector<ConvexHull::HalfEdge>& edges = hull.getEdges();
+        const std::vector<ConvexHull::Face>& faces = hull.getFaces();
+        for(std::size_t f = 0; f < faces.size(); ++f) {
+            std::vector<int> polygon = hull.face_vertices(f);
+            bool convex = true;
+            for(std::size_t i = 0; i < polygon.size(); ++i) {
+                const Vec3& a = v[polygon[i]];
+                const Vec3& b = v[polygon[(i + 1) % polygon.size()]];
+                // Every vertex of the face on the inner side of every edge, in the plane of the face
+                Vec3 inward = cross(faces[f].normal, b - a);
+                float length = std::sqrt(inward * inward);
+                for(int k : polygon)
+                    if(inward * (v[k] - a) < -tolerance * length)
+                        convex = false;
+            }
+            defects.nonconvex_faces += convex ? 0 : 1;
+        }
+        for(const ConvexHull::HalfEdge& e : edges) {
+            // The face across the edge must not rise above the plane of this one
+            const ConvexHull::Face& face = faces[e.face];
+            for(int k : hull.face_vertices(edges[e.twin].face))
+                if(face.normal * v[k] - face.offset > tolerance) {
+                    ++defects.concave_edges;
+                    break;
+                }
+        }
+        std::vector<int> degree(v.size(), 0);
+        for(const ConvexHull::HalfEdge& e : edges)
+            ++degree[e.origin];
+        for(int d : degree)
+            defects.thin_vertices += d < 3 ? 1 : 0;
+        return defects;
+    }
+
+    float max_dot(const std::vector<Vec3>& points, const Vec3& d) {
+        float best = -std::numeric_limits<float>::infinity();
+        for(const Vec3& p : points)
+            best = std::max(best, d * p);
+        return best;
+    }
+}
+
+int main() {
+    std::mt19937 random(7);
+    std::uniform_real_distribution<float> uniform(-1.0f, 1.0f);
+    std::normal_distribution<float> normal;
+
+    std::vector<std::pair<std::string, Generator>> distributions = {
+        { "sphere surface", [&](std::mt19937& r) {
+            float x = normal(r), y = normal(r), z = normal(r), l = std::sqrt(x * x + y * y + z * z);
+            return Vec3(x / l, y / l, z / l);
+        } },
+        { "slab 1000:1:0.01", [&](std::mt19937& r) { return Vec3(500.0f * uniform(r), 0.5f * uniform(r), 0.005f * uniform(r)); } },
+        { "cube", [&](std::mt19937& r) { return Vec3(uniform(r), uniform(r), uniform(r)); } },
+        { "gaussian", [&](std::mt19937& r) { return Vec3(normal(r), normal(r), normal(r)); } },
+        { "integer grid", [&](std::mt19937& r) {
+            return Vec3(std::floor(8.0f * uniform(r)), std::floor(8.0f * uniform(r)), std::floor(8.0f * uniform(r)));
+        } },
+    };
+    const std::size_t sizes[] = { 1000, 100000 };
+    const std::size_t queries = 20000;
+
+    bool failed = false;
+    std::printf("%-16s %6s | %6s %6s | %8s %8s %8s | %6s %6s | %8s %8s\n", "distribution", "points", "verts", "faces",
+                "nonconv", "concave", "thin", "wrong", "outside", "climb ns", "scan ns");
+    for(const auto& distribution : distributions) {
+        for(std::size_t n : sizes) {
+            Cloud cloud(n);
+            for(Vec3& p : cloud)
+                p = distribution.second(random);
+            ConvexHull hull = QuickHull::quick_hull_3D(cloud);
+            const std::vector<Vec3>& vertices = hull.getVertices();
+
+            // Scale of the coordinates, for the tolerances of the checks
+            float extent = 0.0f;
+            for(const Vec3& p : cloud)
+                extent = std::max(extent, std::abs(p.x) + std::abs(p.y) + std::abs(p.z));
+            float tolerance = 1e-6f * extent;
+            Defects defects = check_structure(hull, tolerance);
+
+            std::vector<Vec3> directions(queries);
+            for(Vec3& d : directions)
+                d = Vec3(normal(random), normal(random), normal(random));
+
+            std::size_t wrong = 0, outside = 0;
+            for(const Vec3& d : directions) {
+                float climbed = d * hull.support(d);
+                float length = std::sqrt(d * d);
+                if(climbed < max_dot(vertices, d) - tolerance * length)
+                    ++wrong;
+                if(climbed < max_dot(cloud, d) - tolerance * length)
+                    ++outside;
+            }
+
+            // Timing: hill climbing from the previous answer (temporal coherence) against a scan of the vertices
+            float sink = 0.0f;
+            auto start = std::chrono::steady_clock::now();
+            int previous = 0;
+            for(const Vec3& d : directions) {
+                previous = hull.support_index(d, previous);
+                sink += vertices[previous].x;
+            }
+            auto middle = std::chrono::steady_clock::now();
+            for(const Vec3& d : directions)
+                sink += max_dot(vertices, d);
+            auto stop = std::chrono::steady_clock::now();
+            double climb = std::chrono::duration<double, std::nano>(middle - start).count() / queries;
+            double scan = std::chrono::duration<double, std::nano>(stop - middle).count() / queries;
+
+            std::printf("%-16s %6zu | %6zu %6zu | %8zu %8zu %8zu | %6zu %6zu | %8.1f %8.1f%s\n", distribution.first.c_str(), n,
+                        hull.vertex_count(), hull.face_count(), defects.nonconvex_faces, defects.concave_edges, defects.thin_vertices,
+                        wrong, outside, climb, scan, sink == 12345.0f ? " " : "");
+            failed = failed || wrong > 0 || outside > 0 || defects.nonconvex_faces > 0 || defects.concave_edges > 0 || defects.thin_vertices > 0;
+        }
+    }
+    std::printf(failed ? "FAILED\n" : "OK\n");
+    return failed ? 1 : 0;
+}
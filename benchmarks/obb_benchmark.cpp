@@ -0,0 +1,133 @@
+// OBB builders: volume and build time of the AABB, the PCA box and the hull-based boxes.
+//
+// Build from the repository root, e.g.:
+//     g++ -std=c++11 -O2 -Iinclude benchmarks/obb_benchmark.cpp src/*.cpp src/data_structures/*.cpp -pthread -o obb_benchmark
+//
+// Every cloud is rotated at random. For every point distribution it prints the mean volume of the AABB and the volume
+// of each OBB relative to it, averaged over the clouds (lower is tighter), and the build time per cloud.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+#include "../include/data_structures/OBB.hh"
+
+using namespace Geometry;
+
+namespace {
+
+    using Cloud = std::vector<Point3D>;
+    using Generator = std::function<Vec3(std::mt19937&)>;
+
+    float volume(const OBB& box) {
+        Point3D h = box.getHalfwidth();
+        return 8.0f * h.getX() * h.getY() * h.getZ();
+    }
+
+    // Volume of the axis-aligned box of the cloud, the baseline the OBBs replace
+    float aabb_volume(const Cloud& cloud) {
+        float lo[3] = { cloud[0][0], cloud[0][1], cloud[0][2] }, hi[3] = { lo[0], lo[1], lo[2] };
+        for(const Point3D& p : cloud)
+            for(int i = 0; i < 3; ++i) {
+                lo[i] = std::min(lo[i], p[i]);
+                hi[i] = std::max(hi[i], p[i]);
+            }
+        return (hi[0] - lo[0]) * (hi[1] - lo[1]) * (hi[2] - lo[2]);
+    }
+
+    // Builds a box of every cloud with `build`, returning the volumes and the average time per cloud
+    template <typename Builder>
+    std::vector<float> run(std::vector<Cloud>& clouds, Builder build, double& microseconds) {
+        std::vector<float> volumes;
+        auto start = std::chrono::steady_clock::now();
+        for(Cloud& cloud : clouds)
+            volumes.push_back(build(cloud));
+        auto stop = std::chrono::steady_clock::now();
+        microseconds = std::chrono::duration<double, std::micro>(stop - start).count() / clouds.size();
+        return volumes;
+    }
+
+    double mean(const std::vector<float>& volumes) {
+        double mean = 0.0;
+        for(float v : volumes)
+            mean += v / volumes.size();
+        return mean;
+    }
+
+    double mean_ratio(const std::vector<float>& volumes, const std::vector<float>& reference) {
+        double mean = 0.0;
+        for(std::size_t i = 0; i < volumes.size(); ++i)
+            mean += (reference[i] > 0.0f ? volumes[i] / reference[i] : 1.0) / volumes.size();
+        return mean;
+    }
+
+    // Uniformly distributed rotation (from a random unit quaternion)
+    Mat3 random_rotation(std::mt19937& random) {
+        std::normal_distribution<float> normal;
+        float w = normal(random), x = normal(random), y = normal(random), z = normal(random);
+        float l = std::sqrt(w * w + x * x + y * y + z * z);
+        w /= l; x /= l; y /= l; z /= l;
+        return Mat3(1 - 2 * (y * y + z * z), 2 * (x * y - w * z), 2 * (x * z + w * y),
+                    2 * (x * y + w * z), 1 - 2 * (x * x + z * z), 2 * (y * z - w * x),
+                    2 * (x * z - w * y), 2 * (y * z + w * x), 1 - 2 * (x * x + y * y));
+    }
+}
+
+int main() {
+    std::mt19937 random(2024);
+    std::uniform_real_distribution<float> uniform(-1.0f, 1.0f);
+    std::normal_distribution<float> normal;
+
+    std::vector<std::pair<std::string, Generator>> distributions = {
+        { "box 8:2:1", [&](std::mt19937& r) { return Vec3(8.0f * uniform(r), 2.0f * uniform(r), uniform(r)); } },
+        { "cylinder 6:1", [&](std::mt19937& r) {
+            float a = 3.14159265f * uniform(r);
+            return Vec3(6.0f * uniform(r), std::cos(a), std::sin(a));
+        } },
+        { "ellipsoid 8:2:1", [&](std::mt19937& r) { return Vec3(8.0f * normal(r), 2.0f * normal(r), normal(r)); } },
+        { "sphere surface", [&](std::mt19937& r) {
+            float x = normal(r), y = normal(r), z = normal(r), l = std::sqrt(x * x + y * y + z * z);
+            return Vec3(x / l, y / l, z / l);
+        } },
+        { "L-shaped part", [&](std::mt19937& r) {
+            // Uneven sampling: a dense long arm and a sparse short one
+            return uniform(r) < 0.8f ? Vec3(4.0f + 4.0f * uniform(r), 0.5f * uniform(r), 0.5f * uniform(r))
+                                     : Vec3(0.5f * uniform(r), 3.0f + 3.0f * uniform(r), 0.5f * uniform(r));
+        } },
+    };
+    const std::size_t sizes[] = { 256, 16384 };
+
+    std::printf("%-16s %6s | %-16s | %-16s | %-16s | %-16s | %-16s\n", "distribution", "points",
+                "aabb (vol, us)", "eigen (/aabb, us)", "hull 4 faces", "hull 32 faces", "hull 256 faces");
+    for(const auto& distribution : distributions) {
+        for(std::size_t n : sizes) {
+            std::size_t count = std::max<std::size_t>(4, 65536 / n);
+            std::vector<Cloud> clouds(count);
+            for(Cloud& cloud : clouds) {
+                Mat3 rotation = random_rotation(random);
+                for(std::size_t i = 0; i < n; ++i)
+                    cloud.push_back((rotation * distribution.second(random)).toPoint3D());
+            }
+
+            double t_aabb, t_eigen, t_hull4, t_hull32, t_hull256;
+            std::vector<float> aabb = run(clouds, [](Cloud& c) { return aabb_volume(c); }, t_aabb);
+            std::vector<float> eigen = run(clouds, [](Cloud& c) { OBB b; b.eigen_OBB(c.begin(), c.end()); return volume(b); }, t_eigen);
+            std::vector<float> hull4 = run(clouds, [](Cloud& c) { OBB b; b.min_volume_OBB(c.begin(), c.end(), 4); return volume(b); }, t_hull4);
+            std::vector<float> hull32 = run(clouds, [](Cloud& c) { OBB b; b.min_volume_OBB(c.begin(), c.end(), 32); return volume(b); }, t_hull32);
+            std::vector<float> hull256 = run(clouds, [](Cloud& c) { OBB b; b.min_volume_OBB(c.begin(), c.end(), 256); return volume(b); }, t_hull256);
+
+            std::printf("%-16s %6zu | %7.1f %8.1f | %7.3f %8.1f | %7.3f %8.1f | %7.3f %8.1f | %7.3f %8.1f\n",
+                        distribution.first.c_str(), n,
+                        mean(aabb), t_aabb,
+                        mean_ratio(eigen, aabb), t_eigen,
+                        mean_ratio(hull4, aabb), t_hull4,
+                        mean_ratio(hull32, aabb), t_hull32,
+                        mean_ratio(hull256, aabb), t_hull256);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,100 @@
+// Bounding sphere builders: tightness and build time of Ritter, Ritter-eigen and Welzl spheres.
+//
+// Build from the repository root, e.g.:
+//     g++ -std=c++11 -O2 -Iinclude benchmarks/sphere_benchmark.cpp src/*.cpp src/data_structures/*.cpp -pthread -o sphere_benchmark
+//
+// For every point distribution it prints the radius of each builder relative to the exact minimum sphere
+// (Welzl), averaged and worst over the clouds, and the build time per cloud.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+#include "../include/data_structures/Sphere.hh"
+
+using namespace Geometry;
+
+namespace {
+
+    using Cloud = std::vector<Point3D>;
+    using Generator = std::function<Point3D(std::mt19937&)>;
+
+    struct Result {
+        double mean_ratio = 0.0, worst_ratio = 0.0, microseconds = 0.0;
+    };
+
+    // Builds a sphere of every cloud with `build`, returning its radii and the average time per cloud
+    template <typename Builder>
+    std::vector<float> run(std::vector<Cloud>& clouds, Builder build, double& microseconds) {
+        std::vector<float> radii;
+        auto start = std::chrono::steady_clock::now();
+        for(Cloud& cloud : clouds) {
+            Sphere s;
+            build(s, cloud);
+            radii.push_back(s.getRadius());
+        }
+        auto stop = std::chrono::steady_clock::now();
+        microseconds = std::chrono::duration<double, std::micro>(stop - start).count() / clouds.size();
+        return radii;
+    }
+
+    Result compare(const std::vector<float>& radii, const std::vector<float>& exact, double microseconds) {
+        Result r;
+        for(std::size_t i = 0; i < radii.size(); ++i) {
+            double ratio = exact[i] > 0.0f ? radii[i] / exact[i] : 1.0;
+            r.mean_ratio += ratio / radii.size();
+            r.worst_ratio = std::max(r.worst_ratio, ratio);
+        }
+        r.microseconds = microseconds;
+        return r;
+    }
+}
+
+int main() {
+    std::mt19937 random(2024);
+    std::uniform_real_distribution<float> uniform(-1.0f, 1.0f);
+    std::normal_distribution<float> normal;
+
+    std::vector<std::pair<std::string, Generator>> distributions = {
+        { "uniform cube", [&](std::mt19937& r) { return Point3D(uniform(r), uniform(r), uniform(r)); } },
+        { "gaussian", [&](std::mt19937& r) { return Point3D(normal(r), normal(r), normal(r)); } },
+        { "sphere surface", [&](std::mt19937& r) {
+            float x = normal(r), y = normal(r), z = normal(r), l = std::sqrt(x * x + y * y + z * z);
+            return Point3D(x / l, y / l, z / l);
+        } },
+        { "ellipsoid 8:2:1", [&](std::mt19937& r) { return Point3D(8.0f * normal(r), 2.0f * normal(r), normal(r)); } },
+        { "two clusters", [&](std::mt19937& r) {
+            float side = uniform(r) < 0.0f ? -5.0f : 5.0f;
+            return Point3D(side + 0.5f * normal(r), 0.5f * normal(r), 0.5f * normal(r));
+        } },
+    };
+    const std::size_t sizes[] = { 64, 1024, 65536 };
+
+    std::printf("%-16s %7s | %-24s | %-24s | %-24s\n", "distribution", "points", "ritter (mean/worst, us)", "ritter eigen", "welzl (exact)");
+    for(const auto& distribution : distributions) {
+        for(std::size_t n : sizes) {
+            std::size_t count = std::max<std::size_t>(4, 262144 / n);
+            std::vector<Cloud> clouds(count);
+            for(Cloud& cloud : clouds)
+                for(std::size_t i = 0; i < n; ++i)
+                    cloud.push_back(distribution.second(random));
+
+            double t_welzl, t_ritter, t_eigen;
+            std::vector<float> exact = run(clouds, [](Sphere& s, Cloud& c) { s.welzl_sphere(c.begin(), c.end()); }, t_welzl);
+            std::vector<float> ritter_radii = run(clouds, [](Sphere& s, Cloud& c) { s.ritter_sphere(c.begin(), c.end()); }, t_ritter);
+            std::vector<float> eigen_radii = run(clouds, [](Sphere& s, Cloud& c) { s.ritter_eigen_sphere(c.begin(), c.end()); }, t_eigen);
+            Result ritter = compare(ritter_radii, exact, t_ritter);
+            Result eigen = compare(eigen_radii, exact, t_eigen);
+
+            std::printf("%-16s %7zu | %5.3f / %5.3f %9.1f | %5.3f / %5.3f %9.1f | %5.3f / %5.3f %9.1f\n",
+                        distribution.first.c_str(), n,
+                        ritter.mean_ratio, ritter.worst_ratio, ritter.microseconds,
+                        eigen.mean_ratio, eigen.worst_ratio, eigen.microseconds,
+                        1.0, 1.0, t_welzl);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,67 @@
+#ifndef ALIGNED_ALLOCATOR_HH
+#define ALIGNED_ALLOCATOR_HH
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+namespace Geometry {
+
+    /**
+     * @class AlignedAllocator.
+     * @brief Minimal standard allocator that returns memory aligned to `Alignment` bytes. It allows `std::vector` to be used as storage for structure-of-arrays data that is processed by SIMD lanes.
+     * @tparam T Type of the allocated elements.
+     * @tparam Alignment Requested alignment in bytes, must be a power of two.
+     ```
+     // Example:
+     std::vector<float, AlignedAllocator<float, 32>> xs(100);
+     ```
+     */
+    template <typename T, std::size_t Alignment = 32>
+    class AlignedAllocator {
+    public:
+        using value_type = T;
+
+        template <typename U>
+        struct rebind {
+            using other = AlignedAllocator<U, Alignment>;
+        };
+
+        AlignedAllocator() noexcept {}
+
+        template <typename U>
+        AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {}
+
+        /**
+         * @brief Allocates uninitialized storage for `n` objects of type `T`. The original pointer returned by `std::malloc` is stored right before the aligned block so that `deallocate` can release it.
+         * @param n number of objects.
+         * @return Pointer to the aligned storage.
+         */
+        T* allocate(std::size_t n) {
+            void* raw = std::malloc(n * sizeof(T) + Alignment + sizeof(void*));
+            if(raw == nullptr)
+                throw std::bad_alloc();
+            std::uintptr_t start = reinterpret_cast<std::uintptr_t>(raw) + sizeof(void*);
+            std::uintptr_t aligned = (start + Alignment - 1) & ~static_cast<std::uintptr_t>(Alignment - 1);
+            reinterpret_cast<void**>(aligned)[-1] = raw;
+            return reinterpret_cast<T*>(aligned);
+        }
+
+        /**
+         * @brief Releases storage previously obtained from `allocate`.
+         * @param p pointer returned by `allocate`.
+         */
+        void deallocate(T* p, std::size_t) noexcept {
+            if(p != nullptr)
+                std::free(reinterpret_cast<void**>(p)[-1]);
+        }
+
+        template <typename U>
+        bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept { return true; }
+
+        template <typename U>
+        bool operator!=(const AlignedAllocator<U, Alignment>&) const noexcept { return false; }
+    };
+}
+
+#endif
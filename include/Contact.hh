@@ -0,0 +1,132 @@
+#ifndef CONTACT_HH
+#define CONTACT_HH
+#include "Vec3.hh"
+#include "data_structures/AABB.hh"
+#include "data_structures/OBB.hh"
+#include "data_structures/Sphere.hh"
+#include "data_structures/Capsule.hh"
+
+namespace Geometry {
+
+    /**
+     * @brief Contact point between two shapes A and B: the deepest point of each shape inside the other one and the penetration depth along the manifold normal, so that `point_b = point_a - normal * depth`.
+     */
+    struct ContactPoint {
+        /// Point on (the surface of) A.
+        Vec3 point_a;
+        /// Point on (the surface of) B.
+        Vec3 point_b;
+        /// Penetration depth along the normal; negative when the points are separated.
+        float depth;
+    };
+
+    /**
+     * @class ContactManifold.
+     * @brief Contact manifold of a pair of shapes A and B: up to `MAX_POINTS` contact points sharing one normal. Translating B by `normal * depth` of its deepest point separates the shapes.
+     */
+    class ContactManifold {
+    public:
+
+        /**
+         * @brief Maximum number of points of a manifold: 4 points span the contact area of a face-face contact, which is all a solver needs for a stable resting contact.
+         */
+        static const int MAX_POINTS = 4;
+
+        /// Unit normal pointing from A towards B.
+        Vec3 normal;
+        /// Contact points, `count` of them are valid.
+        ContactPoint points[MAX_POINTS];
+        /// Number of contact points.
+        int count;
+
+        ContactManifold() : count(0) {}
+
+        /**
+         * @brief Method that adds the point `p`. When the manifold is full, it drops the point (possibly `p` itself) that keeps the deepest point and the largest contact area with the remaining four.
+         * @param p contact point.
+         * @return `int` value: the slot where `p` was stored, or -1 if `p` was dropped.
+         */
+        int add(const ContactPoint& p);
+
+        /**
+         * @brief Method that returns the deepest penetration depth, or 0 if the manifold is empty.
+         * @return `float` value.
+         */
+        float getDepth() const ;
+    };
+
+    /**
+     * @class ContactGenerator.
+     * @brief Contact manifold generation for the primitive pairs that have a boolean intersection test. Each method returns `false` if the shapes are separated (leaving `manifold` untouched), and otherwise fills `manifold` from scratch with the normal pointing from the first shape to the second one. Box-box contacts are built with the separating axis test of smallest overlap: a face axis gives the incident face of the other box clipped against the reference face (up to 4 points), an edge-edge axis gives the closest points of the two edges.
+     ```
+     // Example:
+     OBB ground(Point3D(0,-1,0), Point3D(1,0,0), Point3D(0,1,0), Point3D(0,0,1), Point3D(10, 1, 10));
+     OBB crate(Point3D(0,0.45f,0), Point3D(1,0,0), Point3D(0,1,0), Point3D(0,0,1), Point3D(0.5f, 0.5f, 0.5f));
+     ContactManifold m;
+     if(ContactGenerator::OBB_OBB(ground, crate, m)) {
+         // m.normal = (0, 1, 0), m.count = 4 (the corners of the bottom face of the crate), depth 0.05 each
+     }
+     ```
+     */
+    class ContactGenerator {
+    private:
+
+        /**
+         * @brief Support method that generates the contacts of two boxes given by center, unit axes and halfwidth.
+         * @return Returns a boolean value.
+         */
+        static bool box_box(const Vec3& ca, const Vec3 ua[3], const Vec3& ea, const Vec3& cb, const Vec3 ub[3], const Vec3& eb, ContactManifold& manifold);
+
+        /**
+         * @brief Support method that generates the contact of a box (center, unit axes, halfwidth) and a sphere, with the normal pointing from the box to the sphere.
+         * @return Returns a boolean value.
+         */
+        static bool box_sphere(const Vec3& c, const Vec3 u[3], const Vec3& e, const Vec3& center, float radius, ContactManifold& manifold);
+
+    public:
+
+        /**
+         * @brief Contact of two spheres: one point. Concentric spheres get the normal (1, 0, 0).
+         * @return Returns a boolean value.
+         */
+        static bool sphere_sphere(const Sphere& a, const Sphere& b, ContactManifold& manifold);
+
+        /**
+         * @brief Contact of a capsule and a sphere: one point.
+         * @return Returns a boolean value.
+         */
+        static bool capsule_sphere(const Capsule& a, const Sphere& b, ContactManifold& manifold);
+
+        /**
+         * @brief Contact of two capsules: two points when their segments are (nearly) parallel and overlap along their length, so that a capsule lying on another one does not roll; one point otherwise.
+         * @return Returns a boolean value.
+         */
+        static bool capsule_capsule(const Capsule& a, const Capsule& b, ContactManifold& manifold);
+
+        /**
+         * @brief Contact of a sphere and an `AABB`: one point.
+         * @return Returns a boolean value.
+         */
+        static bool sphere_AABB(const Sphere& a, const AABB& b, ContactManifold& manifold);
+
+        /**
+         * @brief Contact of a sphere and an `OBB`: one point.
+         * @return Returns a boolean value.
+         */
+        static bool sphere_OBB(const Sphere& a, const OBB& b, ContactManifold& manifold);
+
+        /**
+         * @brief Contact of two `AABB`: up to 4 points, the corners of the overlap of the touching faces.
+         * @return Returns a boolean value.
+         */
+        static bool AABB_AABB(const AABB& a, const AABB& b, ContactManifold& manifold);
+
+        /**
+         * @brief Contact of two `OBB`: up to 4 points (face contact) or one point (edge-edge contact). The axes of the boxes must be unit vectors.
+         * @return Returns a boolean value.
+         */
+        static bool OBB_OBB(const OBB& a, const OBB& b, ContactManifold& manifold);
+    };
+}
+
+#endif
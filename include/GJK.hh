@@ -0,0 +1,159 @@
+#ifndef GJK_HH
+#define GJK_HH
+#include "Vec3.hh"
+#include "SupportMapping.hh"
+
+namespace Geometry {
+
+    /**
+     * @brief Result of a `GJK::query`.
+     */
+    struct GJKResult {
+        /// `true` if the shapes overlap (or touch).
+        bool intersecting;
+        /// Distance between the shapes; 0 when they intersect.
+        float distance;
+        /// Penetration depth computed by EPA; 0 when the shapes are separated.
+        float depth;
+        /// Unit normal pointing from the first shape towards the second one: translating the second shape by `normal * depth` separates them.
+        Vec3 normal;
+        /// Witness points on the first and second shape: the closest points when separated, the deepest points when intersecting.
+        Vec3 point_a, point_b;
+        /// Number of GJK iterations performed.
+        int iterations;
+    };
+
+    /**
+     * @class GJKCache.
+     * @brief Warm-start data of a shape pair, to be kept across frames (e.g. next to the pair in the broadphase). It stores the search directions that produced the final GJK simplex: on the next query the simplex is rebuilt from those directions with the current poses, so a pair that moved little converges in one or two iterations. A default-constructed cache is empty (cold start).
+     */
+    class GJKCache {
+    private:
+        friend class GJK;
+
+        /**
+         * @brief Search directions of the cached simplex vertices.
+         * @param directions
+         */
+        Vec3 directions[4];
+
+        /**
+         * @brief Number of cached vertices.
+         * @param size
+         */
+        int size;
+
+    public:
+        GJKCache() : size(0) {}
+
+        /**
+         * @brief Method that empties the cache, so that the next query starts cold.
+         */
+        void reset() { this->size = 0; }
+
+        /**
+         * @brief Method that returns the number of cached simplex vertices.
+         * @return `int` value.
+         */
+        int getSize() const { return this->size; }
+    };
+
+    /**
+     * @class GJK.
+     * @brief Gilbert-Johnson-Keerthi distance and intersection engine for pairs of convex shapes given by their `SupportMapping`, with Expanding Polytope Algorithm (EPA) penetration depth for intersecting pairs. GJK iterates on a simplex (1 to 4 vertices) of the Minkowski difference A - B, moving it towards the origin: the shapes intersect when the origin is enclosed, otherwise the closest point of the simplex gives their distance and closest points.
+     ```
+     // Example:
+     SphereSupport a(Sphere(Point3D(0,0,0), 1));
+     CapsuleSupport b(Capsule(Point3D(1.5,-1,0), Point3D(1.5,1,0), 0.25f));
+     GJKCache cache;                       // keep it with the pair across frames
+     GJKResult r = GJK::query(a, b, &cache);
+     // r.intersecting = false, r.distance = 0.25, r.normal = (1, 0, 0)
+     ```
+     */
+    class GJK {
+    public:
+
+        /**
+         * @brief Maximum number of GJK iterations.
+         */
+        static const int MAX_ITERATIONS = 64;
+
+        /**
+         * @brief Maximum number of EPA expansions.
+         */
+        static const int MAX_EPA_ITERATIONS = 128;
+
+    private:
+
+        /**
+         * @brief Vertex of the simplex: point `w = a - b` of the Minkowski difference, its support points on the two shapes and the direction that produced it.
+         */
+        struct Vertex {
+            Vec3 w, a, b, direction;
+        };
+
+        /**
+         * @brief Simplex of up to 4 vertices, with the barycentric weights of its point closest to the origin.
+         */
+        struct Simplex {
+            Vertex v[4];
+            float lambda[4];
+            int size;
+        };
+
+        /**
+         * @brief Support method that returns the support vertex of A - B along `direction`.
+         * @return `Vertex` object.
+         */
+        static Vertex support(const SupportMapping& a, const SupportMapping& b, const Vec3& direction);
+
+        /**
+         * @brief Support method that replaces `simplex` with the smallest sub-simplex containing its point closest to the origin, and returns that point. It returns `true` if the origin is inside a (non-degenerate) tetrahedron.
+         * @return Returns a boolean value.
+         */
+        static bool closest_point(Simplex& simplex, Vec3& closest);
+
+        /**
+         * @brief Support method that runs the GJK loop from `simplex` (possibly warm-started). With `boolean_only` it stops as soon as a separating direction is found.
+         * @return Returns a boolean value: `true` if the shapes intersect.
+         */
+        static bool run(const SupportMapping& a, const SupportMapping& b, Simplex& simplex, Vec3& closest, int& iterations, bool boolean_only);
+
+        /**
+         * @brief Support method that rebuilds the simplex from the cache, or from the centers of the shapes when the cache is empty or missing.
+         */
+        static void start(const SupportMapping& a, const SupportMapping& b, const GJKCache* cache, Simplex& simplex);
+
+        /**
+         * @brief Support method that stores the directions of `simplex` into `cache`.
+         */
+        static void store(const Simplex& simplex, GJKCache* cache);
+
+        /**
+         * @brief Support method that computes the penetration depth, normal and witness points of two intersecting shapes with EPA, starting from the final GJK simplex.
+         */
+        static void epa(const SupportMapping& a, const SupportMapping& b, Simplex simplex, GJKResult& result);
+
+    public:
+
+        /**
+         * @brief Boolean intersection test. It stops at the first separating direction, so it is cheaper than `query`.
+         * @param a first shape.
+         * @param b second shape.
+         * @param cache optional warm-start data of the pair, updated on return.
+         * @return Returns a boolean value.
+         */
+        static bool intersect(const SupportMapping& a, const SupportMapping& b, GJKCache* cache = nullptr);
+
+        /**
+         * @brief Full query: distance and closest points when the shapes are separated; penetration depth, normal and deepest points (EPA) when they intersect.
+         * @param a first shape.
+         * @param b second shape.
+         * @param cache optional warm-start data of the pair, updated on return.
+         * @return `GJKResult` object.
+         */
+        static GJKResult query(const SupportMapping& a, const SupportMapping& b, GJKCache* cache = nullptr);
+    };
+}
+
+#endif
@@ -1,11 +1,16 @@
 #ifndef GEOMETRIC_UTILS_HH
 #define GEOMETRIC_UTILS_HH
+#include <algorithm>
 #include <iterator> 
 #include <limits>
 #include <cmath>
+#include <cstddef>
+#include <vector>
 #include "Point3D.hh"
 #include "Point2D.hh"
+#include "Vec3.hh"
 #include "QuickHull.hh"
+#include "ThreadPool.hh"
 
 namespace Geometry {
 
@@ -24,113 +29,253 @@ namespace Geometry {
          * @return `float` value that represent the min or max value.
          */
         static float clamp(const float n, const float min, const float max);
-    public:
 
         /**
-         * @brief Method that returns a `pair<Iterator,Iterator>` that contains the iterators `max` and `min` of the contanier passed as argument (with iterators) of the most distant couple along the direction `dir`.
-         * @tparam `Iterator` Type that represent the Iterators of a container which supports them.`
-         * @param dir direction
+         * @brief Support method for `min_area_rectangle_calipers`: rotating calipers on the convex polygon `polygon` (either orientation; it is reversed in place if clockwise).
+         * @param polygon vertices of a convex polygon, with no repeated or collinear vertices.
+         * @param c `Point2D` that represent the center of the minimum rectangle.
+         * @param out `pair<Point2D, Point2D>` pair object that represent the axes of rectangle's perimeter.
+         * @return `float` value that represent the area of the rectangle.
+         */
+        static float min_area_rectangle_convex(std::vector<Point2D>& polygon, Point2D& c, std::pair<Point2D, Point2D>& out);
+
+        /**
+         * @brief Minimum and maximum of `K` keys over a range of points, with the offsets of the first points that reach them.
+         * @tparam `K` number of keys.
+         */
+        template <int K>
+        struct Extremes {
+            float min[K], max[K];
+            std::size_t min_index[K], max_index[K];
+
+            Extremes() {
+                for(int k = 0; k < K; ++k) {
+                    this->min[k] = std::numeric_limits<float>::infinity();
+                    this->max[k] = -std::numeric_limits<float>::infinity();
+                    this->min_index[k] = this->max_index[k] = 0;
+                }
+            }
+
+            // Keeps the extremes of both; on ties the earlier point wins, as in a sequential scan
+            void merge(const Extremes& other) {
+                for(int k = 0; k < K; ++k) {
+                    if(other.min[k] < this->min[k] || (other.min[k] == this->min[k] && other.min_index[k] < this->min_index[k])) {
+                        this->min[k] = other.min[k];
+                        this->min_index[k] = other.min_index[k];
+                    }
+                    if(other.max[k] > this->max[k] || (other.max[k] == this->max[k] && other.max_index[k] < this->max_index[k])) {
+                        this->max[k] = other.max[k];
+                        this->max_index[k] = other.max_index[k];
+                    }
+                }
+            }
+        };
+
+        /**
+         * @brief Support method that returns the `Extremes` of the keys `key(x, y, z, k)` of the `count` points starting at `first`, numbered from `offset`. The coordinates of `LANES` points at a time are gathered into local arrays and every lane keeps its own extremes with a branch-free body, which the compiler maps onto SIMD registers; the lanes are merged at the end. Points are only read, never copied.
+         * @tparam `K` number of keys.
+         * @param first first point.
+         * @param offset index of the first point.
+         * @param count number of points.
+         * @param key key function.
+         * @return `Extremes<K>` of the keys.
+         */
+        template <int K, typename Iterator, typename Key>
+        static Extremes<K> extremes_of_block(Iterator first, std::size_t offset, std::size_t count, const Key& key) {
+            alignas(32) float x[LANES], y[LANES], z[LANES];
+            alignas(32) float lane_min[K][LANES], lane_max[K][LANES];
+            std::size_t lane_min_index[K][LANES], lane_max_index[K][LANES];
+            for(int k = 0; k < K; ++k)
+                for(std::size_t l = 0; l < LANES; ++l) {
+                    lane_min[k][l] = std::numeric_limits<float>::infinity();
+                    lane_max[k][l] = -std::numeric_limits<float>::infinity();
+                    lane_min_index[k][l] = lane_max_index[k][l] = 0;
+                }
+
+            for(std::size_t i = 0; i < count; i += LANES) {
+                // Gather; the lanes past the end repeat the last point and are masked out below
+                for(std::size_t l = 0; l < LANES; ++l) {
+                    x[l] = first->getX();
+                    y[l] = first->getY();
+                    z[l] = first->getZ();
+                    if(i + l + 1 < count)
+                        ++first;
+                }
+                for(int k = 0; k < K; ++k)
+                    for(std::size_t l = 0; l < LANES; ++l) {
+                        float v = key(x[l], y[l], z[l], k);
+                        bool valid = i + l < count;
+                        bool below = valid & (v < lane_min[k][l]);
+                        bool above = valid & (v > lane_max[k][l]);
+                        lane_min[k][l] = below ? v : lane_min[k][l];
+                        lane_max[k][l] = above ? v : lane_max[k][l];
+                        lane_min_index[k][l] = below ? offset + i + l : lane_min_index[k][l];
+                        lane_max_index[k][l] = above ? offset + i + l : lane_max_index[k][l];
+                    }
+            }
+
+            Extremes<K> result;
+            for(std::size_t l = 0; l < LANES; ++l) {
+                Extremes<K> lane;
+                for(int k = 0; k < K; ++k) {
+                    lane.min[k] = lane_min[k][l];
+                    lane.max[k] = lane_max[k][l];
+                    lane.min_index[k] = lane_min_index[k][l];
+                    lane.max_index[k] = lane_max_index[k][l];
+                }
+                result.merge(lane);
+            }
+            return result;
+        }
+
+        /**
+         * @brief Support method that returns the `Extremes` of the keys `key(x, y, z, k)` of the `count` points starting at `begin`. If `pool` is not `nullptr`, has more than one worker and there are at least 2 * `grain` points, blocks of `grain` points are reduced as parallel tasks and merged in order, so the result is the same of the serial reduction.
+         * @tparam `K` number of keys.
+         * @param begin first point.
+         * @param count number of points.
+         * @param key key function.
+         * @param pool `ThreadPool` that runs the tasks, or `nullptr`.
+         * @param grain number of points per task.
+         * @return `Extremes<K>` of the keys.
+         */
+        template <int K, typename Iterator, typename Key>
+        static Extremes<K> extremes_of_range(Iterator begin, std::size_t count, const Key& key, ThreadPool* pool, std::size_t grain) {
+            if(grain == 0)
+                grain = 1;
+            if(pool == nullptr || pool->size() < 2 || count < 2 * grain)
+                return GeometryUtils::extremes_of_block<K>(begin, 0, count, key);
+            std::size_t blocks = (count + grain - 1) / grain;
+            std::vector<Extremes<K>> partial(blocks);
+            pool->parallel_for(blocks, [&](std::size_t block, std::size_t) {
+                std::size_t first = block * grain, last = std::min(count, first + grain);
+                partial[block] = GeometryUtils::extremes_of_block<K>(std::next(begin, first), first, last - first, key);
+            });
+            for(std::size_t block = 1; block < blocks; ++block)
+                partial[0].merge(partial[block]);
+            return partial[0];
+        }
+
+        /**
+         * @brief Support method for `extreme_points_along_direction`.
+         * @param dir direction.
          * @param begin starting iterator.
-         * @param end ending iterator. 
+         * @param end ending iterator.
+         * @param pool `ThreadPool` that runs the tasks, or `nullptr`.
+         * @param grain number of points per task.
          * @return `pair<Iterator, Iterator>` iterators of the min and max value.
          */
-        template <typename Iterator>
-        inline static std::pair<Iterator, Iterator> extreme_points_along_direction(const Point3D& dir, Iterator begin, Iterator end) {
-            using ValueType = typename std::iterator_traits<Iterator>::value_type;
-            using DifferenceType = typename std::iterator_traits<Iterator>::difference_type;
+        template <typename Direction, typename Iterator>
+        static std::pair<Iterator, Iterator> extreme_points_along_direction(const Direction& dir, Iterator begin, Iterator end, ThreadPool* pool, std::size_t grain) {
+            if(begin == end) // Empty container
+                return std::make_pair(end, end);
+            const float dx = dir.getX(), dy = dir.getY(), dz = dir.getZ();
+            std::size_t count = std::distance(begin, end);
+            Extremes<1> e = GeometryUtils::extremes_of_range<1>(begin, count, [=](float x, float y, float z, int) {
+                // Project vector from origin to point onto direction vector
+                return x * dx + y * dy + z * dz;
+            }, pool, grain);
+            return std::make_pair(std::next(begin, e.min_index[0]), std::next(begin, e.max_index[0]));
+        }
 
-            auto it = begin;
-            if (it == end) // Empty container
+        /**
+         * @brief Support method for `most_separated_points_on_AABB`.
+         * @param begin starting iterator.
+         * @param end ending iterator.
+         * @param pool `ThreadPool` that runs the tasks, or `nullptr`.
+         * @param grain number of points per task.
+         * @return `pair<Iterator, Iterator>` iterators of the min and max value.
+         */
+        template <typename Iterator>
+        static std::pair<Iterator, Iterator> most_separated_points_on_AABB(Iterator begin, Iterator end, ThreadPool* pool, std::size_t grain) {
+            if(begin == end) // Empty container
                 return std::make_pair(end, end);
+            std::size_t count = std::distance(begin, end);
 
-            // int n = points.size(); // Questa riga non è necessaria nella versione con iteratori
-            float maxproj = -std::numeric_limits<float>::max();
-            float minproj = std::numeric_limits<float>::max();
-            DifferenceType current_imin = 0;
-            DifferenceType current_imax = 0;
-            DifferenceType current_index = 0;
-            auto min = it;
-            auto max = it;
-
-            for (; it != end; ++it, ++current_index) {
-                // Project vector from origin to poin onto direction vector
-                float proj = (*it) * dir;
-                // Keep track of least and most distant point(s) along direction vector
-                if(proj > maxproj) {
-                    maxproj = proj;
-                    max = it;
-                }
-                if(proj < minproj) {
-                    minproj = proj;
-                    min = it;
-                }
+            // First find most extreme points along principal axes
+            Extremes<3> e = GeometryUtils::extremes_of_range<3>(begin, count, [](float x, float y, float z, int axis) {
+                return axis == 0 ? x : (axis == 1 ? y : z);
+            }, pool, grain);
+
+            // Compute the squared distances for the three pairs of points and pick the most distant one
+            Iterator min[3], max[3];
+            float dist2[3];
+            for(int axis = 0; axis < 3; ++axis) {
+                min[axis] = std::next(begin, e.min_index[axis]);
+                max[axis] = std::next(begin, e.max_index[axis]);
+                float dx = max[axis]->getX() - min[axis]->getX();
+                float dy = max[axis]->getY() - min[axis]->getY();
+                float dz = max[axis]->getZ() - min[axis]->getZ();
+                dist2[axis] = dx * dx + dy * dy + dz * dz;
             }
-            return std::make_pair(min, max);
+            int axis = 0;
+            if(dist2[1] > dist2[0] && dist2[1] > dist2[2])
+                axis = 1;
+            if(dist2[2] > dist2[0] && dist2[2] > dist2[1])
+                axis = 2;
+            return std::make_pair(min[axis], max[axis]);
         }
 
+    public:
+
         /**
-         * @brief Method that returns a `pair<Iterator,Iterator>` that contains the iterators `max` and `min` of the contanier passed as argument (with iterators) of the most separated points of a `AABB` object.
-         * @tparam `Iterator` Type that represent the Iterators of a container which supports them.
+         * @brief Number of points reduced together by the SIMD lanes of `extreme_points_along_direction` and `most_separated_points_on_AABB`.
+         */
+        static const std::size_t LANES = 8;
+
+        /**
+         * @brief Method that returns a `pair<Iterator,Iterator>` that contains the iterators `max` and `min` of the contanier passed as argument (with iterators) of the most distant couple along the direction `dir`. The projections are reduced `LANES` points at a time with SIMD lanes; on ties the first point is returned.
+         * @tparam `Direction` `Point3D` or `Vec3`.
+         * @tparam `Iterator` Type that represent the Iterators of a container of `Point3D` or `Vec3` objects.
+         * @param dir direction
          * @param begin starting iterator.
          * @param end ending iterator. 
          * @return `pair<Iterator, Iterator>` iterators of the min and max value.
          */
-        template <typename Iterator>
-        inline static std::pair<Iterator, Iterator> most_separated_points_on_AABB(Iterator begin, Iterator end) {
-            using ValueType = typename std::iterator_traits<Iterator>::value_type;
+        template <typename Direction, typename Iterator>
+        inline static std::pair<Iterator, Iterator> extreme_points_along_direction(const Direction& dir, Iterator begin, Iterator end) {
+            return GeometryUtils::extreme_points_along_direction(dir, begin, end, nullptr, 0);
+        }
 
-            auto it = begin;
-            if (it == nullptr)
-                return std::make_pair(end, end); // Empty container
+        /**
+         * @brief Parallel overload of `extreme_points_along_direction`: blocks of `grain` points are reduced as tasks on `pool` and merged in order, so the result is the same of the serial method for any number of threads. Ranges of less than 2 * `grain` points, or a pool with a single worker, are reduced serially.
+         * @tparam `Direction` `Point3D` or `Vec3`.
+         * @tparam `RandomIt` random access iterator of a container of `Point3D` or `Vec3` objects.
+         * @param dir direction
+         * @param begin starting iterator.
+         * @param end ending iterator.
+         * @param pool `ThreadPool` that runs the tasks.
+         * @param grain number of points per task.
+         * @return `pair<RandomIt, RandomIt>` iterators of the min and max value.
+         */
+        template <typename Direction, typename RandomIt>
+        inline static std::pair<RandomIt, RandomIt> extreme_points_along_direction(const Direction& dir, RandomIt begin, RandomIt end, ThreadPool& pool, std::size_t grain = 65536) {
+            return GeometryUtils::extreme_points_along_direction(dir, begin, end, &pool, grain);
+        }
 
-            Iterator current_index = 0; 
-            Iterator minx_it = it, maxx_it = it, miny_it = it, maxy_it = it, minz_it = it, maxz_it = it;
-            ValueType minx_point = *it, maxx_point = *it, miny_point = *it, maxy_point = *it, minz_point = *it, maxz_point = *it;
+        /**
+         * @brief Method that returns a `pair<Iterator,Iterator>` that contains the iterators `max` and `min` of the contanier passed as argument (with iterators) of the most separated points of a `AABB` object. The coordinates are reduced `LANES` points at a time with SIMD lanes; on ties the first point is returned.
+         * @tparam `Iterator` Type that represent the Iterators of a container of `Point3D` or `Vec3` objects.
+         * @param begin starting iterator.
+         * @param end ending iterator. 
+         * @return `pair<Iterator, Iterator>` iterators of the min and max value.
+         */
+        template <typename Iterator>
+        inline static std::pair<Iterator, Iterator> most_separated_points_on_AABB(Iterator begin, Iterator end) {
+            return GeometryUtils::most_separated_points_on_AABB(begin, end, nullptr, 0);
+        }
 
-            // First find most extreme points along principal axes
-            for(; it != end; it++) {
-                if(it->getX() < minx_point.getX()) {
-                    minx_point = *it;
-                    minx_it = it;
-                }
-                if(it->getX() > maxx_point.getX()) {
-                    maxx_point = *it;
-                    maxx_it = it;
-                }
-                if(it->getY() < miny_point.getY()) {
-                    miny_point = *it;
-                    miny_it = it;
-                }
-                if(it->getY() > maxy_point.getY()) {
-                    maxy_point = *it;
-                    maxy_it = it;
-                }
-                if(it->getZ() < minz_point.getZ()) {
-                    minz_point = *it;
-                    minz_it = it;
-                }
-                if(it->getZ() > maxz_point.getZ()) {
-                    maxz_point = *it;
-                    maxz_it = it;
-                }
-            }
-            // Compute the squared distances for the three pairs of points
-            float dist2x = (maxx_point - minx_point) * (maxx_point - minx_point);
-            float dist2y = (maxy_point - miny_point) * (maxy_point - miny_point);
-            float dist2z = (maxz_point - minz_point) * (maxz_point - minz_point);
-
-            // Pick the pair (min, max) of points most distant
-            Iterator min = minx_it;
-            Iterator max = maxx_it;
-            if(dist2y > dist2x && dist2y > dist2z) {
-                max = maxy_it;
-                min = miny_it;
-            }
-            if(dist2z > dist2x && dist2z > dist2y) {
-                max = maxz_it;
-                min = minz_it;
-            }
-            return std::make_pair(min, max);
+        /**
+         * @brief Parallel overload of `most_separated_points_on_AABB`: blocks of `grain` points are reduced as tasks on `pool` and merged in order, so the result is the same of the serial method for any number of threads. Ranges of less than 2 * `grain` points, or a pool with a single worker, are reduced serially.
+         * @tparam `RandomIt` random access iterator of a container of `Point3D` or `Vec3` objects.
+         * @param begin starting iterator.
+         * @param end ending iterator.
+         * @param pool `ThreadPool` that runs the tasks.
+         * @param grain number of points per task.
+         * @return `pair<RandomIt, RandomIt>` iterators of the min and max value.
+         */
+        template <typename RandomIt>
+        inline static std::pair<RandomIt, RandomIt> most_separated_points_on_AABB(RandomIt begin, RandomIt end, ThreadPool& pool, std::size_t grain = 65536) {
+            return GeometryUtils::most_separated_points_on_AABB(begin, end, &pool, grain);
         }
 
         /**
@@ -156,10 +301,8 @@ namespace Geometry {
             
 
             // Loop through all edges; j trails i by 1, modulo n
-            for(long long i = 0, j = n - 1; i < n; j = i, ++i) {
-                auto it_i = std::next(it_begin, i);
-                auto it_j = (i == 0) ? std::prev(it_end) : std::prev(it_i);
-                
+            auto it_j = std::next(it_begin, n - 1);
+            for(auto it_i = it_begin; it_i != it_end; it_j = it_i, ++it_i) {
                 // Get current edge e0 (e0x, e0y), normalized
                 Point2D e0 = *it_i - *it_j;
                 float dx = e0.getX();
@@ -200,6 +343,48 @@ namespace Geometry {
             return minArea;
         }
 
+        /**
+         * @brief Method that returns the area of the minimum area rectangle in the X-Y plane of the convex polygon [`begin`, `end`), e.g. the output of `QuickHull::quick_hull`, in linear time. One side of the minimum rectangle lies on an edge of the polygon (Freeman and Shapira), and while the edges are visited in order the extreme points along the edge, along its normal and against the edge only move forward around the polygon (rotating calipers), so every edge costs amortized constant time instead of a pass over all the points as in `min_area_rectangle`. The polygon may be clockwise or counter-clockwise; repeated consecutive vertices are skipped.
+         * @tparam `Iterator` Type that represent the Iterators of a container which supports them.
+         * @param begin starting iterator.
+         * @param end ending iterator.
+         * @param c `Point2D` that represent the center of the minimum rectangle.
+         * @param out `pair<Point2D, Point2D>` pair object that represent the axes of rectangle's perimeter.
+         * @return `float` value that represent the area of the rectangle.
+         */
+        template <typename Iterator>
+        inline static float min_area_rectangle_calipers(Iterator begin, Iterator end, Point2D& c, std::pair<Point2D, Point2D>& out) {
+            std::vector<Point2D> polygon;
+            for(; begin != end; ++begin) {
+                Point2D p(begin->getX(), begin->getY());
+                if(polygon.empty() || polygon.back().getX() != p.getX() || polygon.back().getY() != p.getY())
+                    polygon.push_back(p);
+            }
+            while(polygon.size() > 1 && polygon.front().getX() == polygon.back().getX() && polygon.front().getY() == polygon.back().getY())
+                polygon.pop_back();
+            if(polygon.size() < 3)
+                return 0.0f; // No rectangle with less than 3 points
+            return GeometryUtils::min_area_rectangle_convex(polygon, c, out);
+        }
+
+        /**
+         * @brief Method that returns the area of the minimum area rectangle in the X-Y plane of the points [`begin`, `end`), in any order: their hull is computed with `QuickHull::quick_hull_in_place` on a copy and the rectangle with `min_area_rectangle_calipers`, in O(n log n) overall.
+         * @tparam `Iterator` Type that represent the Iterators of a container which supports them.
+         * @param begin starting iterator.
+         * @param end ending iterator.
+         * @param c `Point2D` that represent the center of the minimum rectangle.
+         * @param out `pair<Point2D, Point2D>` pair object that represent the axes of rectangle's perimeter.
+         * @return `float` value that represent the area of the rectangle.
+         */
+        template <typename Iterator>
+        inline static float min_area_rectangle_of_points(Iterator begin, Iterator end, Point2D& c, std::pair<Point2D, Point2D>& out) {
+            std::vector<Point2D> points;
+            for(; begin != end; ++begin)
+                points.push_back(Point2D(begin->getX(), begin->getY()));
+            points.erase(QuickHull::quick_hull_in_place(points.begin(), points.end()), points.end());
+            return GeometryUtils::min_area_rectangle_calipers(points.begin(), points.end(), c, out);
+        }
+
         /**
          * @brief Method that returns the squared distance between point `c` and segment `ab`.
          * @param a point of the segment.
@@ -209,6 +394,15 @@ namespace Geometry {
          */
         static float sq_dist_point_segment(Point3D a, Point3D b, Point3D c);
 
+        /**
+         * @brief `Vec3` overload of `sq_dist_point_segment`: it returns the squared distance between point `c` and segment `ab`.
+         * @param a point of the segment.
+         * @param b point of the segment.
+         * @param c another point for computing distance. 
+         * @return `float` value that represent the dinstance between segment and point.
+         */
+        static float sq_dist_point_segment(const Vec3& a, const Vec3& b, const Vec3& c);
+
         // Computer closest points C1 and C2 of S1(s) = P1 + s*(Q1-P1)
         // and S2(t) = P2 + t*(Q2-P2), returning s and t. Function
         // result is squared distance between S1(s) and S2(t)
@@ -225,6 +419,19 @@ namespace Geometry {
          * @param c2 closest point to the second segment
          */
         static float closest_point_segment_segment(Point3D p1, Point3D q1, Point3D p2, Point3D q2, float& s, float& t, Point3D& c1, Point3D& c2);
+
+        /**
+         * @brief `Vec3` overload of `closest_point_segment_segment`: it computes closest points `c1` and `c2` of $S_1(s) = P_1 + s \cdot (Q_1-P_1)$ and $S_2(t) = P_2 + t \cdot (Q_2-P_2)$, returning `s` and `t` and the squared distance between them.
+         * @param p1 first point of the first segment.
+         * @param q1 ending point of the first segment.
+         * @param p2 first point of the second segment.
+         * @param q2 ending point of the second segment.  
+         * @param s `float` value that represent closest value to the first segment.
+         * @param t `float` value that represent closest value to the second segment.
+         * @param c1 closest point to the first segment
+         * @param c2 closest point to the second segment
+         */
+        static float closest_point_segment_segment(const Vec3& p1, const Vec3& q1, const Vec3& p2, const Vec3& q2, float& s, float& t, Vec3& c1, Vec3& c2);
     };
 }
 
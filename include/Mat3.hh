@@ -0,0 +1,244 @@
+#ifndef MAT3_HH
+#define MAT3_HH
+#include <iterator>
+#include "Point3D.hh"
+#include "Vec3.hh"
+
+namespace Geometry {
+
+    /**
+     * @class Mat3.
+     * @brief Fixed-size 3x3 `float` matrix stored on the stack. Unlike `Matrix` it never allocates, it is trivially copyable and most of its operations are `constexpr`, so it is meant for hot paths such as the `OBB` separating-axis test.
+     ```
+     // Example:
+     constexpr Mat3 I = Mat3::identity();
+     constexpr Mat3 A(1, 2, 3,
+                      4, 5, 6,
+                      7, 8, 9);
+     constexpr Mat3 B = A * I;    // evaluated at compile time
+     static_assert(B(1, 2) == 6.0f, "");
+     ```
+     */
+    class Mat3 {
+    private:
+
+        /**
+         * @brief Elements in row-major order.
+         * @param m
+         */
+        float m[3][3];
+
+        /**
+         * @brief Support function: dot product of row `r` of `a` and column `c` of `b`.
+         */
+        static constexpr float row_col(const Mat3& a, const Mat3& b, int r, int c) {
+            return a.m[r][0] * b.m[0][c] + a.m[r][1] * b.m[1][c] + a.m[r][2] * b.m[2][c];
+        }
+
+        /**
+         * @brief Support function: `constexpr` absolute value.
+         */
+        static constexpr float abs_value(float x) {
+            return x < 0.0f ? -x : x;
+        }
+
+    public:
+
+        /**
+         * @name Constructors.
+         * @{
+         */
+
+            /**
+             * @brief Default constructor that sets every element to 0.
+             */
+            constexpr Mat3() : m{{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}} {}
+
+            /**
+             * @brief Constructor that sets the nine elements, row by row.
+             */
+            constexpr Mat3(float m00, float m01, float m02,
+                           float m10, float m11, float m12,
+                           float m20, float m21, float m22)
+                : m{{m00, m01, m02}, {m10, m11, m12}, {m20, m21, m22}} {}
+
+        /// @}
+
+        /**
+         * @brief Method that returns the 3x3 identity matrix.
+         * @return `Mat3` object.
+         */
+        static constexpr Mat3 identity() {
+            return Mat3(1.0f, 0.0f, 0.0f,
+                        0.0f, 1.0f, 0.0f,
+                        0.0f, 0.0f, 1.0f);
+        }
+
+        /**
+         * @name Operator(s) ovreloading
+         * @{
+         */
+
+            /**
+             * @brief Overloading of the `operator()` operator (const variant). It returns the element in row `r` and column `c`. No bound checking is performed.
+             * @param r row.
+             * @param c column.
+             * @return `float` value.
+             */
+            constexpr float operator()(int r, int c) const {
+                return m[r][c];
+            }
+
+            /**
+             * @brief Overloading of the `operator()` operator (non-const variant). It returns a reference to the element in row `r` and column `c`. No bound checking is performed.
+             * @param r row.
+             * @param c column.
+             * @return `float&` reference.
+             */
+            float& operator()(int r, int c) {
+                return m[r][c];
+            }
+
+            /**
+             * @brief Overloading of the `operator[]` operator (const variant). It returns the row `r`, so that the matrix can be read as `A[r][c]` like a `Matrix`.
+             * @param r row.
+             * @return `const float*` pointer to the row.
+             */
+            constexpr const float* operator[](int r) const {
+                return m[r];
+            }
+
+            /**
+             * @brief Overloading of the `operator[]` operator (non-const variant). It returns the row `r`, so that the matrix can be read and written as `A[r][c]` like a `Matrix`.
+             * @param r row.
+             * @return `float*` pointer to the row.
+             */
+            float* operator[](int r) {
+                return m[r];
+            }
+
+            /**
+             * @brief Overloading of the `operator*` operator. It returns the matrix product `this * other`.
+             * @param other `const Mat3&`.
+             * @return `Mat3` object.
+             */
+            constexpr Mat3 operator*(const Mat3& other) const {
+                return Mat3(row_col(*this, other, 0, 0), row_col(*this, other, 0, 1), row_col(*this, other, 0, 2),
+                            row_col(*this, other, 1, 0), row_col(*this, other, 1, 1), row_col(*this, other, 1, 2),
+                            row_col(*this, other, 2, 0), row_col(*this, other, 2, 1), row_col(*this, other, 2, 2));
+            }
+
+            /**
+             * @brief Overloading of the `operator*` operator. It returns the product of the matrix by the column vector `p`.
+             * @param p `const Point3D&`.
+             * @return `Point3D` object.
+             */
+            Point3D operator*(const Point3D& p) const ;
+
+            /**
+             * @brief `Vec3` overload of the product by a column vector.
+             * @param v `const Vec3&`.
+             * @return `Vec3` object.
+             */
+            constexpr Vec3 operator*(const Vec3& v) const {
+                return Vec3(m[0][0] * v.x + m[0][1] * v.y + m[0][2] * v.z,
+                            m[1][0] * v.x + m[1][1] * v.y + m[1][2] * v.z,
+                            m[2][0] * v.x + m[2][1] * v.y + m[2][2] * v.z);
+            }
+
+        /// @}
+
+        /**
+         * @brief Method that returns the transposed matrix.
+         * @return `Mat3` object.
+         */
+        constexpr Mat3 transpose() const {
+            return Mat3(m[0][0], m[1][0], m[2][0],
+                        m[0][1], m[1][1], m[2][1],
+                        m[0][2], m[1][2], m[2][2]);
+        }
+
+        /**
+         * @brief Method that returns the matrix of the absolute values of the elements, each increased by `epsilon`.
+         * @param epsilon value added to every element.
+         * @return `Mat3` object.
+         */
+        constexpr Mat3 abs(float epsilon = 0.0f) const {
+            return Mat3(abs_value(m[0][0]) + epsilon, abs_value(m[0][1]) + epsilon, abs_value(m[0][2]) + epsilon,
+                        abs_value(m[1][0]) + epsilon, abs_value(m[1][1]) + epsilon, abs_value(m[1][2]) + epsilon,
+                        abs_value(m[2][0]) + epsilon, abs_value(m[2][1]) + epsilon, abs_value(m[2][2]) + epsilon);
+        }
+
+        /**
+         * @brief Method that returns the determinant of the matrix.
+         * @return `float` value.
+         */
+        constexpr float determinant() const {
+            return m[0][0] * (m[1][1] * m[2][2] - m[1][2] * m[2][1])
+                 - m[0][1] * (m[1][0] * m[2][2] - m[1][2] * m[2][0])
+                 + m[0][2] * (m[1][0] * m[2][1] - m[1][1] * m[2][0]);
+        }
+
+        /**
+         * @brief Method that computes the eigenvalues and eigenvectors of the matrix, which must be symmetric (only the upper triangle is read), without allocating: cyclic Jacobi sweeps on a stack copy, each rotation updating only the two rows and columns it touches, stopped when the off-diagonal part is negligible or after `MAX_SWEEPS` sweeps (3 or 4 are usually enough in single precision). Unlike `Matrix::jacobi`, the eigenvalues are sorted in decreasing order and the eigenvectors, the columns of `eigenvectors`, form a right-handed rotation.
+         ```
+         // Example: principal axes of a point cloud
+         Vec3 values;
+         Mat3 axes;
+         Mat3::covariance(points.begin(), points.end()).symmetric_eigen(values, axes);
+         Vec3 main_axis(axes(0, 0), axes(1, 0), axes(2, 0)); // largest spread
+         ```
+         * @param eigenvalues output eigenvalues, in decreasing order.
+         * @param eigenvectors output unit eigenvectors, column `i` for `eigenvalues[i]`.
+         */
+        void symmetric_eigen(Vec3& eigenvalues, Mat3& eigenvectors) const ;
+
+        /**
+         * @brief Maximum number of Jacobi sweeps of `symmetric_eigen`.
+         */
+        static const int MAX_SWEEPS = 8;
+
+        /**
+         * @brief Method that returns the covariance matrix of the points in [`begin`, `end`) (`Point3D`, `Vec3` or any type with `getX`, `getY` and `getZ`), as `Matrix::covariance_matrix` without allocating. An empty range gives the zero matrix.
+         * @tparam `Iterator` Type that represent the Iterators of a container which supports them.
+         * @param begin starting iterator.
+         * @param end ending iterator.
+         * @return `Mat3` object.
+         */
+        template <typename Iterator>
+        static Mat3 covariance(Iterator begin, Iterator end) {
+            std::size_t n = std::distance(begin, end);
+            if(n == 0)
+                return Mat3();
+            float oon = 1.0f / static_cast<float>(n);
+
+            // Compute the center of mass (centroid) of the points
+            float cx = 0.0f, cy = 0.0f, cz = 0.0f;
+            for(Iterator it = begin; it != end; ++it) {
+                cx += it->getX();
+                cy += it->getY();
+                cz += it->getZ();
+            }
+            cx *= oon;
+            cy *= oon;
+            cz *= oon;
+
+            // Compute covariance elements of the translated points
+            float e00 = 0.0f, e11 = 0.0f, e22 = 0.0f, e01 = 0.0f, e02 = 0.0f, e12 = 0.0f;
+            for(Iterator it = begin; it != end; ++it) {
+                float x = it->getX() - cx, y = it->getY() - cy, z = it->getZ() - cz;
+                e00 += x * x;
+                e11 += y * y;
+                e22 += z * z;
+                e01 += x * y;
+                e02 += x * z;
+                e12 += y * z;
+            }
+            return Mat3(e00 * oon, e01 * oon, e02 * oon,
+                        e01 * oon, e11 * oon, e12 * oon,
+                        e02 * oon, e12 * oon, e22 * oon);
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,181 @@
+#ifndef MOMENTS_HH
+#define MOMENTS_HH
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+#include "Vec3.hh"
+#include "Mat3.hh"
+#include "ThreadPool.hh"
+
+namespace Geometry {
+
+    /**
+     * @class Moments.
+     * @brief Streaming accumulator of the first and second moments of a point set: count, mean and the sums of the outer products of the deviations from the mean (Welford). Points can be added one at a time or a block at a time, and accumulators built on different parts of the input can be merged (Chan, Golub and LeVeque), so the covariance is computed in a single pass over data that is streamed, split across threads or too large to be kept in memory. The sums are kept in double precision and the covariance is the same of `Matrix::covariance_matrix` and `Mat3::covariance` up to rounding.
+     ```
+     // Example: covariance of a point cloud read in chunks
+     Moments moments;
+     while(reader.read(x, y, z, n))
+         moments.add(x, y, z, n);
+     Vec3 values;
+     Mat3 axes;
+     moments.covariance().symmetric_eigen(values, axes);
+     ```
+     */
+    class Moments {
+    private:
+
+        /**
+         * @brief Number of points.
+         * @param n
+         */
+        std::uint64_t n;
+
+        /**
+         * @brief Mean of the points.
+         * @param mean
+         */
+        double mean[3];
+
+        /**
+         * @brief Sums of the products of the deviations from the mean: xx, yy, zz, xy, xz, yz.
+         * @param m2
+         */
+        double m2[6];
+
+        /**
+         * @brief Support method that merges a part of `count` points with mean `part_mean` and sums of products `part_m2`.
+         * @param count number of points of the part.
+         * @param part_mean mean of the part.
+         * @param part_m2 sums of products of the part, ordered as `m2`.
+         */
+        void merge(std::uint64_t count, const double* part_mean, const double* part_m2);
+
+    public:
+
+        /**
+         * @brief Number of points gathered by the ranges of `add` before they are accumulated as one block.
+         */
+        static const std::size_t BLOCK = 256;
+
+        /**
+         * @name Constructors.
+         * @{
+         */
+
+            /**
+             * @brief Default constructor: the moments of the empty set.
+             */
+            Moments();
+
+            /**
+             * @brief Constructor that accumulates the points of [`begin`, `end`).
+             * @tparam `Iterator` Type that represent the Iterators of a container of `Point3D` or `Vec3` objects.
+             * @param begin starting iterator.
+             * @param end ending iterator.
+             */
+            template <typename Iterator>
+            Moments(Iterator begin, Iterator end) : Moments() {
+                this->add(begin, end);
+            }
+
+        /// @}
+
+        /**
+         * @brief Method that adds the point (`x`, `y`, `z`) with a Welford update.
+         * @param x x-coordinate.
+         * @param y y-coordinate.
+         * @param z z-coordinate.
+         */
+        void add(float x, float y, float z);
+
+        /**
+         * @brief Method that adds a block of `count` points stored as structure-of-arrays. The block is reduced on its own, with a branch-free loop that the compiler vectorizes, and merged in.
+         * @param x x-coordinates.
+         * @param y y-coordinates.
+         * @param z z-coordinates.
+         * @param count number of points.
+         */
+        void add(const float* x, const float* y, const float* z, std::size_t count);
+
+        /**
+         * @brief Method that adds the points of [`begin`, `end`) (`Point3D`, `Vec3` or any type with `getX`, `getY` and `getZ`), gathered into blocks of `BLOCK` points.
+         * @tparam `Iterator` Type that represent the Iterators of a container which supports them.
+         * @param begin starting iterator.
+         * @param end ending iterator.
+         */
+        template <typename Iterator>
+        void add(Iterator begin, Iterator end) {
+            float x[BLOCK], y[BLOCK], z[BLOCK];
+            while(begin != end) {
+                std::size_t count = 0;
+                for(; begin != end && count < BLOCK; ++begin, ++count) {
+                    x[count] = begin->getX();
+                    y[count] = begin->getY();
+                    z[count] = begin->getZ();
+                }
+                this->add(x, y, z, count);
+            }
+        }
+
+        /**
+         * @brief Method that merges the points accumulated by `other` into this object. The result is the same, up to rounding, of accumulating all the points into one object, in any order.
+         * @param other `Moments` object.
+         */
+        void merge(const Moments& other);
+
+        /**
+         * @brief Method that returns the moments of [`begin`, `end`) computed on `pool`: blocks of `grain` points are accumulated as tasks and merged in order, so the result does not depend on the number of threads. Ranges of less than 2 * `grain` points, or a pool with a single worker, are accumulated serially.
+         * @tparam `RandomIt` random access iterator of a container of `Point3D` or `Vec3` objects.
+         * @param begin starting iterator.
+         * @param end ending iterator.
+         * @param pool `ThreadPool` that runs the tasks.
+         * @param grain number of points per task.
+         * @return `Moments` object.
+         */
+        template <typename RandomIt>
+        static Moments of(RandomIt begin, RandomIt end, ThreadPool& pool, std::size_t grain = 65536) {
+            std::size_t count = std::distance(begin, end);
+            if(grain == 0)
+                grain = 1;
+            if(pool.size() < 2 || count < 2 * grain)
+                return Moments(begin, end);
+            std::size_t blocks = (count + grain - 1) / grain;
+            std::vector<Moments> partial(blocks);
+            pool.parallel_for(blocks, [&](std::size_t block, std::size_t) {
+                std::size_t first = block * grain, last = std::min(count, first + grain);
+                partial[block].add(begin + first, begin + last);
+            });
+            for(std::size_t block = 1; block < blocks; ++block)
+                partial[0].merge(partial[block]);
+            return partial[0];
+        }
+
+        /**
+         * @brief Method that returns the number of points.
+         * @return `std::uint64_t` value.
+         */
+        std::uint64_t count() const ;
+
+        /**
+         * @brief Method that returns the mean of the points, (0, 0, 0) if there are none.
+         * @return `Vec3` object.
+         */
+        Vec3 centroid() const ;
+
+        /**
+         * @brief Method that returns the covariance matrix of the points (divided by the number of points, as `Matrix::covariance_matrix`). With no points it is the zero matrix.
+         * @return `Mat3` object.
+         */
+        Mat3 covariance() const ;
+
+        /**
+         * @brief Method that resets the accumulator to the empty set.
+         */
+        void clear();
+    };
+}
+
+#endif
@@ -0,0 +1,124 @@
+#ifndef PARALLEL_BROADPHASE_HH
+#define PARALLEL_BROADPHASE_HH
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <utility>
+#include <vector>
+#include "ThreadPool.hh"
+#include "data_structures/AABB.hh"
+#include "data_structures/Sphere.hh"
+#include "data_structures/OBB.hh"
+#include "data_structures/Capsule.hh"
+
+namespace Geometry {
+
+    /**
+     * @class ParallelBroadphase.
+     * @brief Multi-threaded pair finder for `AABB`, `Sphere`, `OBB` and `Capsule` populations. The objects are sorted by the lower bound of their world `AABB` along x, the sorted range is cut into blocks that are swept independently on a work-stealing `ThreadPool`, and every worker writes into its own pair buffer. The candidates are confirmed with the shape's own intersection test; at the end the buffers are concatenated and sorted, so the output is the same for any number of threads.
+     ```
+     // Example:
+     ThreadPool pool;
+     std::vector<Sphere> spheres = { Sphere(Point3D(0,0,0), 1), Sphere(Point3D(1.5,0,0), 1), Sphere(Point3D(9,0,0), 1) };
+     auto pairs = ParallelBroadphase::find_pairs(spheres.begin(), spheres.end(), pool); // pairs = { (0, 1) }
+     ```
+     */
+    class ParallelBroadphase {
+    private:
+
+        /**
+         * @name Shape adapters.
+         * @brief Overloads that compute the world `AABB` (min/max corners) of each shape and run its exact intersection test.
+         * @{
+         */
+
+            static void compute_bounds(const AABB& box, std::array<float, 3>& min, std::array<float, 3>& max);
+            static void compute_bounds(const Sphere& sphere, std::array<float, 3>& min, std::array<float, 3>& max);
+            static void compute_bounds(const OBB& box, std::array<float, 3>& min, std::array<float, 3>& max);
+            static void compute_bounds(const Capsule& capsule, std::array<float, 3>& min, std::array<float, 3>& max);
+
+            static bool test_pair(const AABB& a, const AABB& b);
+            static bool test_pair(const Sphere& a, const Sphere& b);
+            static bool test_pair(const OBB& a, const OBB& b);
+            static bool test_pair(const Capsule& a, const Capsule& b);
+
+        /// @}
+
+    public:
+
+        /**
+         * @brief Type of the output pairs: indices in the input range, lower index first.
+         */
+        using Pair = std::pair<std::uint32_t, std::uint32_t>;
+
+        /**
+         * @brief Method that returns every intersecting pair of the shapes of the range [`begin`, `end`), computed on `pool`. The pairs are sorted, lower index first, independently of the number of threads. `grain` is the number of sorted objects swept by a single task; smaller values balance better, larger ones cost less scheduling.
+         * @tparam `Iterator` Iterator over `AABB`, `Sphere`, `OBB` or `Capsule` objects.
+         * @param begin starting iterator.
+         * @param end ending iterator.
+         * @param pool `ThreadPool` that runs the tasks.
+         * @param grain number of objects per task.
+         * @return `std::vector<Pair>` sorted intersecting pairs.
+         */
+        template <typename Iterator>
+        static std::vector<Pair> find_pairs(Iterator begin, Iterator end, ThreadPool& pool, std::size_t grain = 256) {
+            using ShapeType = typename std::iterator_traits<Iterator>::value_type;
+
+            std::vector<const ShapeType*> shapes;
+            for(; begin != end; ++begin)
+                shapes.push_back(&*begin);
+            std::size_t n = shapes.size();
+            if(n < 2)
+                return {};
+            if(grain == 0)
+                grain = 1;
+            std::size_t blocks = (n + grain - 1) / grain;
+
+            // World bounds of every object, computed in parallel
+            std::vector<std::array<float, 3>> min(n), max(n);
+            pool.parallel_for(blocks, [&](std::size_t block, std::size_t) {
+                for(std::size_t i = block * grain; i < std::min(n, (block + 1) * grain); ++i)
+                    ParallelBroadphase::compute_bounds(*shapes[i], min[i], max[i]);
+            });
+
+            // Sort along x; ties broken by index so the order is deterministic
+            std::vector<std::uint32_t> order(n);
+            for(std::size_t i = 0; i < n; ++i)
+                order[i] = static_cast<std::uint32_t>(i);
+            std::sort(order.begin(), order.end(), [&](std::uint32_t a, std::uint32_t b) {
+                return min[a][0] < min[b][0] || (min[a][0] == min[b][0] && a < b);
+            });
+
+            // Sweep: each task owns a range of the sorted axis and one buffer per worker
+            std::vector<std::vector<Pair>> buffers(pool.size());
+            pool.parallel_for(blocks, [&](std::size_t block, std::size_t worker) {
+                std::vector<Pair>& out = buffers[worker];
+                std::size_t last = std::min(n, (block + 1) * grain);
+                for(std::size_t i = block * grain; i < last; ++i) {
+                    std::uint32_t a = order[i];
+                    for(std::size_t j = i + 1; j < n && min[order[j]][0] <= max[a][0]; ++j) {
+                        std::uint32_t b = order[j];
+                        if(min[a][1] > max[b][1] || min[b][1] > max[a][1] || min[a][2] > max[b][2] || min[b][2] > max[a][2])
+                            continue;
+                        if(ParallelBroadphase::test_pair(*shapes[a], *shapes[b]))
+                            out.push_back(a < b ? Pair(a, b) : Pair(b, a));
+                    }
+                }
+            });
+
+            std::size_t total = 0;
+            for(const std::vector<Pair>& buffer : buffers)
+                total += buffer.size();
+            std::vector<Pair> result;
+            result.reserve(total);
+            for(const std::vector<Pair>& buffer : buffers)
+                result.insert(result.end(), buffer.begin(), buffer.end());
+            std::sort(result.begin(), result.end());
+            return result;
+        }
+    };
+}
+
+#endif
@@ -190,15 +190,14 @@ namespace Geometry {
             Point3D operator*(float scalar) const;
 
             /**
-             * @brief Overloading of the `operator*=` operator. It accept a `Point3D` object as argument and returns none. This method allows self-sum operations such as:
+             * @brief Overloading of the `operator*=` operator. It accept a `float` scalar as argument and returns the `Point3D` object itself. This method allows self-product operations such as:
              ```
              // Example:
              Point3D a(1,2,3);
-             Point3D b(3,4,5);
-             a += b;
+             a *= 2; // a = (2,4,6)
              ```
-             * @param other `Point3D` object.
-             * @return none.
+             * @param scalar `float` value.
+             * @return `Point3D&` object.
              */
             Point3D& operator*=(float scalar);
 
@@ -1,6 +1,9 @@
 #ifndef QUICK_HULL_HH
 #define QUICK_HULL_HH
 #include "Point2D.hh"
+#include "Vec3.hh"
+#include "ThreadPool.hh"
+#include "data_structures/ConvexHull.hh"
 #include <vector>
 #include <algorithm>
 #include <limits>
@@ -10,13 +13,13 @@ namespace Geometry {
 
     /**
      * @class QuickHull.
-     * @brief Class that allows to generate a hull from a set of points.
+     * @brief Class that allows to generate a hull from a set of points: `quick_hull` builds the 2D hull of `Point2D` sets, `quick_hull_3D` the 3D hull of point clouds.
      */
     class QuickHull {
     private:
 
         /**
-         * @brief Support method that finds a the farthest point from a edge. It returns an `Iterator` pointing to this `Point2D`.
+         * @brief Support method that finds a the farthest point from a edge. It returns an `Iterator` pointing to this `Point2D`. The distances are compared scaled by the length of the edge, which is the same for every point, so no square root is needed.
          * @tparam `Iterator` Type that represent the Iterators of a container which supports them.`
          * @param a Point2D
          * @param b Point2D
@@ -26,17 +29,34 @@ namespace Geometry {
          */
         template <typename Iterator>
         static Iterator point2D_farthest_from_edge(Point2D a, Point2D b, Iterator begin, Iterator end) {
-            Point2D e = b - a;
-            Point2D eperp = Point2D(-e.getY(), e.getX());
+            float maxVal, rightMostVal;
+            return QuickHull::point2D_farthest_from_edge(a, b, begin, end, maxVal, rightMostVal);
+        }
+
+        /**
+         * @brief Support method that finds a the farthest point from a edge, as the other overload, and also returns its scaled distance from the edge and its scaled position along the edge (the keys it was selected with), so that the results of several ranges can be combined.
+         * @tparam `Iterator` Type that represent the Iterators of a container which supports them.`
+         * @param a Point2D
+         * @param b Point2D
+         * @param begin starting iterator.
+         * @param end ending iterator.
+         * @param maxVal output scaled distance of the farthest point.
+         * @param rightMostVal output scaled position of the farthest point along A-B.
+         * @return `Iterator` iterator refered to the farthest point from the edge A-B.
+         */
+        template <typename Iterator>
+        static Iterator point2D_farthest_from_edge(Point2D a, Point2D b, Iterator begin, Iterator end, float& maxVal, float& rightMostVal) {
+            float ex = b.getX() - a.getX(), ey = b.getY() - a.getY();
 
             Iterator it = begin;
             Iterator bestIndex = end;
-            float maxVal = -std::numeric_limits<float>::max();
-            float rightMostVal = -std::numeric_limits<float>::max();
+            maxVal = -std::numeric_limits<float>::max();
+            rightMostVal = -std::numeric_limits<float>::max();
 
             for(; it != end; ++it) {
-                float d = ((*it - a) * eperp) / std::sqrt(eperp * eperp);
-                float r = (*it - a) * e;
+                float px = it->getX() - a.getX(), py = it->getY() - a.getY();
+                float d = ey * -px + ex * py;
+                float r = px * ex + py * ey;
                 if(d > maxVal || (d == maxVal && r > rightMostVal)) {
                     maxVal = d;
                     rightMostVal = r;
@@ -88,6 +108,232 @@ namespace Geometry {
             QuickHull::quick_hull_recursive(c, b, rightSet.begin(), rightSet.end(), hull);
         }
 
+        /**
+         * @brief Support structure for the Akl-Toussaint heuristic: the octagon of the extreme points along the axes and the diagonals. The points strictly inside it cannot be vertices of the hull.
+         */
+        struct AklToussaintFilter {
+            /// Edges of the octagon, counter-clockwise: the inside is `ex * y - ey * x > c`.
+            float ex[8], ey[8], c[8];
+            /// Number of edges (the extreme points may coincide).
+            int count;
+
+            /**
+             * @brief Constructor that finds the octagon of the points in [`begin`, `end`), which must not be empty.
+             * @tparam `Iterator` Type that represent the Iterators of a container which supports them.
+             * @param begin starting iterator.
+             * @param end ending iterator.
+             */
+            template <typename Iterator>
+            AklToussaintFilter(Iterator begin, Iterator end) : count(0) {
+                // Extremes along -x, -x-y, -y, x-y, x, x+y, y, y-x: counter-clockwise order
+                float best[8], vx[8], vy[8];
+                for(int k = 0; k < 8; ++k)
+                    best[k] = vx[k] = vy[k] = -std::numeric_limits<float>::max();
+                float extent = 0.0f;
+                for(; begin != end; ++begin) {
+                    float x = begin->getX(), y = begin->getY();
+                    float key[8] = { -x, -x - y, -y, x - y, x, x + y, y, y - x };
+                    for(int k = 0; k < 8; ++k)
+                        if(key[k] > best[k]) {
+                            best[k] = key[k];
+                            vx[k] = x;
+                            vy[k] = y;
+                        }
+                    extent = std::max(extent, std::max(std::abs(x), std::abs(y)));
+                }
+                // Margin for the rounding of the inside test, so that no point of the hull boundary is discarded
+                float tolerance = 8.0f * std::numeric_limits<float>::epsilon() * extent * extent;
+                for(int k = 0; k < 8; ++k) {
+                    float x = vx[(k + 1) % 8] - vx[k], y = vy[(k + 1) % 8] - vy[k];
+                    if(x == 0.0f && y == 0.0f)
+                        continue;
+                    this->ex[this->count] = x;
+                    this->ey[this->count] = y;
+                    this->c[this->count] = x * vy[k] - y * vx[k] + tolerance;
+                    ++this->count;
+                }
+                // A flat octagon has no interior
+                if(this->count < 3)
+                    this->count = 0;
+            }
+
+            /**
+             * @brief Method that returns `true` if the point (`x`, `y`) is strictly inside the octagon, by more than the rounding tolerance.
+             * @param x x-coordinate.
+             * @param y y-coordinate.
+             * @return Returns a boolean value.
+             */
+            bool discards(float x, float y) const {
+                bool inside = this->count > 0;
+                for(int k = 0; k < this->count; ++k)
+                    inside &= this->ex[k] * y - this->ey[k] * x > this->c[k];
+                return inside;
+            }
+        };
+
+        /**
+         * @brief Support method that moves the hull vertices of the points in [`first`, `last`), all strictly on the left of the edge A-B, to the front of the range, in order from A to B. The range is only permuted: the points inside the triangle of each step are left behind the ones still to process.
+         * @tparam `RandomIt` Type that represent the random access Iterators of a container which supports them.
+         * @param a Point2D
+         * @param b Point2D
+         * @param first starting iterator.
+         * @param last ending iterator.
+         * @return `RandomIt` iterator past the last hull vertex.
+         */
+        template <typename RandomIt>
+        static RandomIt quick_hull_in_place_recursive(const Point2D& a, const Point2D& b, RandomIt first, RandomIt last) {
+            using PointType = typename std::iterator_traits<RandomIt>::value_type;
+            if(first == last)
+                return first;
+
+            std::iter_swap(first, QuickHull::point2D_farthest_from_edge(a, b, first, last));
+            Point2D c(first->getX(), first->getY());
+
+            // [first + 1, left): left of A-C, [left, right): left of C-B, then the points inside the triangle ABC
+            RandomIt left = std::partition(first + 1, last, [&](const PointType& p) { return QuickHull::cross_product(a, c, p) > 0; });
+            RandomIt right = std::partition(left, last, [&](const PointType& p) { return QuickHull::cross_product(c, b, p) > 0; });
+
+            // C goes just before the right set, the left set is solved in the slots before it
+            std::iter_swap(first, left - 1);
+            RandomIt out = QuickHull::quick_hull_in_place_recursive(a, c, first, left - 1);
+            std::iter_swap(out, left - 1);
+            ++out;
+            RandomIt right_end = QuickHull::quick_hull_in_place_recursive(c, b, left, right);
+            for(RandomIt it = left; it != right_end; ++it, ++out)
+                std::iter_swap(out, it);
+            return out;
+        }
+
+        /**
+         * @brief Support method that moves the hull vertices of the points in [`begin`, `end`) (at least one) to the front of the range, in the order of `quick_hull`. The first vertex is the lowest point among the leftmost ones.
+         * @tparam `RandomIt` Type that represent the random access Iterators of a container which supports them.
+         * @param begin starting iterator.
+         * @param end ending iterator.
+         * @return `RandomIt` iterator past the last hull vertex.
+         */
+        template <typename RandomIt>
+        static RandomIt quick_hull_partition(RandomIt begin, RandomIt end) {
+            using PointType = typename std::iterator_traits<RandomIt>::value_type;
+            auto less = [](const PointType& p, const PointType& q) {
+                return p.getX() < q.getX() || (p.getX() == q.getX() && p.getY() < q.getY());
+            };
+            RandomIt minIt = begin, maxIt = begin;
+            for(RandomIt it = begin; it != end; ++it) {
+                if(less(*it, *minIt))
+                    minIt = it;
+                if(less(*maxIt, *it))
+                    maxIt = it;
+            }
+            if(!less(*minIt, *maxIt)) { // All points coincide
+                std::iter_swap(begin, minIt);
+                return begin + 1;
+            }
+
+            std::iter_swap(begin, minIt);
+            if(maxIt == begin)
+                maxIt = minIt;
+            std::iter_swap(begin + 1, maxIt);
+            Point2D a(begin->getX(), begin->getY());
+            Point2D b((begin + 1)->getX(), (begin + 1)->getY());
+
+            RandomIt upper = std::partition(begin + 2, end, [&](const PointType& p) { return QuickHull::cross_product(a, b, p) > 0; });
+            RandomIt lower = std::partition(upper, end, [&](const PointType& p) { return QuickHull::cross_product(a, b, p) < 0; });
+
+            // A, upper chain, B, lower chain
+            RandomIt out = QuickHull::quick_hull_in_place_recursive(a, b, begin + 2, upper);
+            std::rotate(begin + 1, begin + 2, out);
+            RandomIt lower_end = QuickHull::quick_hull_in_place_recursive(b, a, upper, lower);
+            for(RandomIt it = upper; it != lower_end; ++it, ++out)
+                std::iter_swap(out, it);
+            return out;
+        }
+
+        /**
+         * @brief Support structure for the parallel 2D hull: one call of `quick_hull_recursive` on the edge A-B and its point set. Large calls are split on the farthest point C into the calls on A-C and C-B; small ones are leaves solved serially into `hull`.
+         */
+        template <typename PointType>
+        struct HullTask {
+            Point2D a, b, c;
+            std::vector<PointType> set;
+            std::vector<Point2D> hull;
+            std::size_t left, right;
+            bool split;
+        };
+
+        /**
+         * @brief Support method that appends the hull vertices found by the task `k` and its subtasks, in the order of `quick_hull_recursive`.
+         * @tparam `PointType` Type of the points.
+         * @param tasks task tree.
+         * @param k index of the task.
+         * @param hull `vector<Point2D>&` output hull.
+         */
+        template <typename PointType>
+        static void collect_hull(const std::vector<HullTask<PointType>>& tasks, std::size_t k, std::vector<Point2D>& hull) {
+            const HullTask<PointType>& task = tasks[k];
+            if(!task.split) {
+                hull.insert(hull.end(), task.hull.begin(), task.hull.end());
+                return;
+            }
+            QuickHull::collect_hull(tasks, task.left, hull);
+            hull.push_back(task.c);
+            QuickHull::collect_hull(tasks, task.right, hull);
+        }
+
+        /**
+         * @brief Support method that copies the points of `input` for which `first` holds into `first_set` and those for which `second` holds into `second_set`, keeping their order, on `pool`: every block of `grain` points is classified and counted, the counts are prefix-summed and every block writes its points at its offsets.
+         * @tparam `PointType` Type of the points.
+         * @param input input points.
+         * @param offset index of the first point to classify.
+         * @param first first predicate.
+         * @param second second predicate.
+         * @param first_set output points for `first`.
+         * @param second_set output points for `second`.
+         * @param pool `ThreadPool` that runs the tasks.
+         * @param grain number of points per task.
+         */
+        template <typename PointType, typename First, typename Second>
+        static void parallel_split(const std::vector<PointType>& input, std::size_t offset, First first, Second second, std::vector<PointType>& first_set, std::vector<PointType>& second_set, ThreadPool& pool, std::size_t grain) {
+            std::size_t n = input.size() - offset;
+            std::size_t blocks = (n + grain - 1) / grain;
+            std::vector<unsigned char> side(n);
+            std::vector<std::size_t> first_offset(blocks + 1, 0), second_offset(blocks + 1, 0);
+            pool.parallel_for(blocks, [&](std::size_t block, std::size_t) {
+                std::size_t f = 0, s = 0;
+                for(std::size_t i = block * grain; i < std::min(n, (block + 1) * grain); ++i) {
+                    const PointType& p = input[offset + i];
+                    side[i] = static_cast<unsigned char>((first(p) ? 1 : 0) | (second(p) ? 2 : 0));
+                    f += side[i] & 1;
+                    s += side[i] >> 1;
+                }
+                first_offset[block + 1] = f;
+                second_offset[block + 1] = s;
+            });
+            for(std::size_t block = 0; block < blocks; ++block) {
+                first_offset[block + 1] += first_offset[block];
+                second_offset[block + 1] += second_offset[block];
+            }
+            first_set.resize(first_offset[blocks]);
+            second_set.resize(second_offset[blocks]);
+            pool.parallel_for(blocks, [&](std::size_t block, std::size_t) {
+                std::size_t f = first_offset[block], s = second_offset[block];
+                for(std::size_t i = block * grain; i < std::min(n, (block + 1) * grain); ++i) {
+                    if(side[i] & 1)
+                        first_set[f++] = input[offset + i];
+                    if(side[i] & 2)
+                        second_set[s++] = input[offset + i];
+                }
+            });
+        }
+
+        /**
+         * @brief Support method that builds the 3D hull of `points`, running the large passes on `pool` if it is not `nullptr`.
+         * @param points input points.
+         * @param pool `ThreadPool` that runs the tasks, or `nullptr`.
+         * @param max_vertices maximum number of vertices of the hull (0 for no limit).
+         * @return `ConvexHull` object.
+         */
+        static ConvexHull build_hull_3D(const std::vector<Vec3>& points, ThreadPool* pool, std::size_t max_vertices);
+
     public:
 
         /**
@@ -157,6 +403,234 @@ namespace Geometry {
 
             return hull;
         }
+
+        /**
+         * @brief Method that computes the `Point2D` hull by permuting the points of [`begin`, `end`) in place, with no allocation: the hull vertices are moved to the front of the range, in the same counter-clockwise order as `quick_hull`, and the iterator past the last one is returned. Before the recursion, the points strictly inside the octagon of the extreme points along the axes and the diagonals are discarded (Akl-Toussaint heuristic), which removes most of the points of large inputs in a single pass.
+         * Unlike `quick_hull`, the leftmost points are ordered by y, and a range of coincident points gives a single vertex. Points that lie on a hull edge (collinear boundary points, common on integer grids) may be kept by one method and dropped by the other, since the starting chord differs: the two hulls cover the same polygon but their vertex sets are not always equal.
+         ```
+         // Example:
+         std::vector<Point2D> points = { ... };
+         auto last = QuickHull::quick_hull_in_place(points.begin(), points.end());
+         std::vector<Point2D> hull(points.begin(), last);
+         ```
+         * @tparam `RandomIt` Type that represent the random access Iterators of a container of `Point2D` (or derived) objects.
+         * @param begin starting iterator.
+         * @param end ending iterator.
+         * @return `RandomIt` iterator past the last hull vertex.
+         */
+        template <typename RandomIt>
+        static RandomIt quick_hull_in_place(RandomIt begin, RandomIt end) {
+            if(end - begin < 3) // Handle n <= 2 as quick_hull
+                return end;
+
+            // Stable compaction of the points that survive the filter
+            AklToussaintFilter filter(begin, end);
+            RandomIt kept = begin;
+            for(RandomIt it = begin; it != end; ++it)
+                if(!filter.discards(it->getX(), it->getY())) {
+                    if(kept != it)
+                        std::iter_swap(kept, it);
+                    ++kept;
+                }
+            return QuickHull::quick_hull_partition(begin, kept);
+        }
+
+        /**
+         * @brief Method that computes the `Point2D` hull of the points in [`begin`, `end`), which are not modified, as `quick_hull_in_place` does: the points that survive the Akl-Toussaint filter are copied into `scratch`, where the hull is computed in place. Reusing the same `scratch` across calls avoids any allocation but the returned hull.
+         * @tparam `Iterator` Type that represent the Iterators of a container which supports them.
+         * @param begin starting iterator.
+         * @param end ending iterator.
+         * @param scratch buffer, overwritten.
+         * @return `vector<Point2D>` `Point2D` hull set.
+         */
+        template <typename Iterator>
+        static std::vector<Point2D> quick_hull(Iterator begin, Iterator end, std::vector<Point2D>& scratch) {
+            scratch.clear();
+            if(std::distance(begin, end) < 3) {
+                for(; begin != end; ++begin)
+                    scratch.push_back(Point2D(begin->getX(), begin->getY()));
+                return scratch;
+            }
+
+            AklToussaintFilter filter(begin, end);
+            for(Iterator it = begin; it != end; ++it) {
+                float x = it->getX(), y = it->getY();
+                if(!filter.discards(x, y))
+                    scratch.push_back(Point2D(x, y));
+            }
+            return std::vector<Point2D>(scratch.begin(), QuickHull::quick_hull_partition(scratch.begin(), scratch.end()));
+        }
+
+        /**
+         * @brief Method that computes the same `Point2D` hull as `quick_hull`, vertex for vertex and in the same order, on `pool`. The extreme points are found by a parallel reduction and the points are split into the upper and lower sets by a parallel stable partition; then every call of `quick_hull_recursive` on at least `grain` points finds its farthest point by a parallel reduction and splits its set in parallel, while the smaller calls are run serially as independent tasks, balanced by work stealing. The farthest points are selected with the same keys and ties as the serial scan, and the partitions keep the order of the points, so the result does not depend on the number of threads. Inputs of less than 2 * `grain` points, or a pool with a single worker, are computed serially.
+         ```
+         // Example:
+         ThreadPool pool;
+         std::vector<Point2D> points = { ... }; // millions of points
+         std::vector<Point2D> hull = QuickHull::quick_hull(points.begin(), points.end(), pool);
+         ```
+         * @tparam `RandomIt` Type that represent the random access Iterators of a container which supports them.
+         * @param begin starting iterator.
+         * @param end ending iterator.
+         * @param pool `ThreadPool` that runs the tasks.
+         * @param grain number of points per task.
+         * @return `vector<Point2D>` `Point2D` hull set.
+         */
+        template <typename RandomIt>
+        static std::vector<Point2D> quick_hull(RandomIt begin, RandomIt end, ThreadPool& pool, std::size_t grain = 8192) {
+            using PointType = typename std::iterator_traits<RandomIt>::value_type;
+            if(grain == 0)
+                grain = 1;
+            std::size_t n = static_cast<std::size_t>(end - begin);
+            if(n < 2 * grain || pool.size() < 2)
+                return QuickHull::quick_hull(begin, end);
+            std::size_t blocks = (n + grain - 1) / grain;
+
+            // Copy and first minimum and maximum x of every block, combined in block order as the serial scan finds them
+            std::vector<PointType> pointsCopy(n);
+            std::vector<std::size_t> minIndex(blocks), maxIndex(blocks);
+            pool.parallel_for(blocks, [&](std::size_t block, std::size_t) {
+                std::size_t first = block * grain, last = std::min(n, first + grain);
+                std::size_t lo = first, hi = first;
+                for(std::size_t i = first; i < last; ++i) {
+                    pointsCopy[i] = begin[i];
+                    if(pointsCopy[i].getX() < pointsCopy[lo].getX())
+                        lo = i;
+                    if(pointsCopy[i].getX() > pointsCopy[hi].getX())
+                        hi = i;
+                }
+                minIndex[block] = lo;
+                maxIndex[block] = hi;
+            });
+            std::size_t lo = minIndex[0], hi = maxIndex[0];
+            for(std::size_t block = 1; block < blocks; ++block) {
+                if(pointsCopy[minIndex[block]].getX() < pointsCopy[lo].getX())
+                    lo = minIndex[block];
+                if(pointsCopy[maxIndex[block]].getX() > pointsCopy[hi].getX())
+                    hi = maxIndex[block];
+            }
+            if(lo == hi) // All points on a vertical line
+                return QuickHull::quick_hull(begin, end);
+
+            // Same swaps as the serial method: the first copy of A is the minimum itself, and so is the first copy of B after the first slot, unless B was the first point and moved to the slot of A
+            PointType b = pointsCopy[hi];
+            std::iter_swap(pointsCopy.begin(), pointsCopy.begin() + lo);
+            auto bIt = hi != 0 ? pointsCopy.begin() + hi : std::find(std::next(pointsCopy.begin()), pointsCopy.end(), b);
+            std::iter_swap(std::next(pointsCopy.begin()), bIt);
+
+            // Divides Point2Ds into 2 sets
+            std::vector<HullTask<PointType>> tasks(2);
+            const PointType &p0 = pointsCopy[0], &p1 = pointsCopy[1];
+            QuickHull::parallel_split(pointsCopy, 2,
+                [&](const PointType& p) { return QuickHull::cross_product(p0, p1, p) > 0; },
+                [&](const PointType& p) { return QuickHull::cross_product(p0, p1, p) < 0; },
+                tasks[0].set, tasks[1].set, pool, grain);
+            std::reverse(tasks[1].set.begin(), tasks[1].set.end());
+            tasks[0].a = tasks[1].b = p0;
+            tasks[0].b = tasks[1].a = p1;
+            tasks[0].split = tasks[1].split = false;
+
+            // Splits the large calls, collecting the small ones
+            std::vector<std::size_t> pending = { 0, 1 }, leaves;
+            std::vector<typename std::vector<PointType>::const_iterator> farthest;
+            std::vector<float> distance, along;
+            while(!pending.empty()) {
+                std::size_t k = pending.back();
+                pending.pop_back();
+                const std::vector<PointType>& set = tasks[k].set;
+                std::size_t count = set.size();
+                if(count < grain) {
+                    leaves.push_back(k);
+                    continue;
+                }
+
+                std::size_t parts = (count + grain - 1) / grain;
+                farthest.assign(parts, set.end());
+                distance.assign(parts, 0.0f);
+                along.assign(parts, 0.0f);
+                Point2D a = tasks[k].a, b = tasks[k].b;
+                pool.parallel_for(parts, [&](std::size_t part, std::size_t) {
+                    farthest[part] = QuickHull::point2D_farthest_from_edge(a, b, set.begin() + part * grain, set.begin() + std::min(count, (part + 1) * grain), distance[part], along[part]);
+                    if(farthest[part] == set.begin() + std::min(count, (part + 1) * grain))
+                        farthest[part] = set.end();
+                });
+                std::size_t best = parts;
+                for(std::size_t part = 0; part < parts; ++part)
+                    if(farthest[part] != set.end() && (best == parts || distance[part] > distance[best] || (distance[part] == distance[best] && along[part] > along[best])))
+                        best = part;
+                if(best == parts) {
+                    leaves.push_back(k);
+                    continue;
+                }
+
+                Point2D c = *farthest[best];
+                HullTask<PointType> left, right;
+                left.a = a;
+                left.b = right.a = c;
+                right.b = b;
+                left.split = right.split = false;
+                QuickHull::parallel_split(set, 0,
+                    [&](const PointType& p) { return QuickHull::cross_product(a, c, p) > 0; },
+                    [&](const PointType& p) { return QuickHull::cross_product(c, b, p) > 0; },
+                    left.set, right.set, pool, grain);
+                tasks[k].c = c;
+                tasks[k].split = true;
+                std::vector<PointType>().swap(tasks[k].set);
+                tasks[k].left = tasks.size();
+                tasks[k].right = tasks.size() + 1;
+                pending.push_back(tasks.size());
+                pending.push_back(tasks.size() + 1);
+                tasks.push_back(std::move(left));
+                tasks.push_back(std::move(right));
+            }
+
+            pool.parallel_for(leaves.size(), [&](std::size_t i, std::size_t) {
+                HullTask<PointType>& task = tasks[leaves[i]];
+                QuickHull::quick_hull_recursive(task.a, task.b, task.set.begin(), task.set.end(), task.hull);
+            });
+
+            std::vector<Point2D> hull;
+            hull.push_back(pointsCopy[0]);
+            QuickHull::collect_hull(tasks, 0, hull);
+            hull.push_back(pointsCopy[1]);
+            QuickHull::collect_hull(tasks, 1, hull);
+            return hull;
+        }
+
+        /**
+         * @brief Method that builds the 3D convex hull of the points in [`begin`, `end`) (`Point3D`, `Vec3` or any type with `getX`, `getY` and `getZ`). See the `std::vector<Vec3>` overload.
+         * @tparam `Iterator` Type that represent the Iterators of a container which supports them.
+         * @param begin starting iterator.
+         * @param end ending iterator.
+         * @param max_vertices maximum number of vertices of the hull (0 for no limit).
+         * @return `ConvexHull` object.
+         */
+        template <typename Iterator>
+        static ConvexHull quick_hull_3D(Iterator begin, Iterator end, std::size_t max_vertices = 0) {
+            std::vector<Vec3> points;
+            points.reserve(std::distance(begin, end));
+            for(; begin != end; ++begin)
+                points.push_back(Vec3(begin->getX(), begin->getY(), begin->getZ()));
+            return QuickHull::quick_hull_3D(points, max_vertices);
+        }
+
+        /**
+         * @brief Method that builds the 3D convex hull of `points` with the iterative QuickHull algorithm. Starting from a tetrahedron of extreme points, every point is kept in the outside set of one face (a linked list threaded through a single array, so no set is ever copied); at each step the farthest point of an outside set is added, the faces it sees are removed and the horizon is fanned to it, and the outside sets of the removed faces are handed to the new faces. The planes of the triangles are computed in double precision and points within a tolerance scaled on the extent of the input are treated as lying on them, so rounding never leaves concave edges that later steps could fold over; the triangles that are coplanar up to rounding are then merged into convex polygons, so coplanar and duplicated points are handled robustly (points that are coplanar only up to float rounding, e.g. on a rotated box, keep their faces triangulated); degenerate inputs give the degenerate hulls described in `ConvexHull`.
+         * With `max_vertices` the construction stops when the hull has that many vertices, always adding the farthest outside point first (a flat hull keeps the extreme points of its polygon and then, in the same way, the vertex farthest from the polygon kept so far): the result is an inner approximation of the hull with a cheaper support mapping. It throws `std::invalid_argument` if `max_vertices` is 1, 2 or 3.
+         * @param points input points.
+         * @param max_vertices maximum number of vertices of the hull (0 for no limit).
+         * @return `ConvexHull` object.
+         */
+        static ConvexHull quick_hull_3D(const std::vector<Vec3>& points, std::size_t max_vertices = 0);
+
+        /**
+         * @brief Method that builds the same 3D convex hull as the serial overload, on `pool`. The extreme point searches of the initial simplex are parallel reductions, and whenever a set of at least a few thousand points is assigned to the outside sets of the new faces (the whole input at the start, the points of the removed faces later), the faces are chosen in parallel and the points are then linked in their original order. Every search keeps the ties of the serial scan, so the result does not depend on the number of threads. The insertions themselves are sequential: the speed-up comes from the inputs whose points are mostly discarded in the first steps, such as dense clouds.
+         * @param points input points.
+         * @param pool `ThreadPool` that runs the tasks.
+         * @param max_vertices maximum number of vertices of the hull (0 for no limit).
+         * @return `ConvexHull` object.
+         */
+        static ConvexHull quick_hull_3D(const std::vector<Vec3>& points, ThreadPool& pool, std::size_t max_vertices = 0);
     };
 }
 #endif
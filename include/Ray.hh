@@ -0,0 +1,141 @@
+#ifndef RAY_HH
+#define RAY_HH
+#include <limits>
+#include "Vec3.hh"
+#include "Triangle.hh"
+#include "data_structures/AABB.hh"
+#include "data_structures/OBB.hh"
+#include "data_structures/Sphere.hh"
+#include "data_structures/Capsule.hh"
+
+namespace Geometry {
+
+    /**
+     * @brief Result of a ray query: distance along the ray of the first intersection and unit surface normal at that point.
+     */
+    struct RayHit {
+        float distance;
+        Vec3 normal;
+    };
+
+    /**
+     * @class Ray.
+     * @brief Half-line (or segment, when a maximum distance is set) with an origin and a unit direction. The `intersect` methods return the first point where the ray enters a solid primitive: `RayHit::distance` is measured from the origin in world units and `RayHit::normal` is the outward normal of the primitive there (for triangles, the normal of the side facing the ray). A ray whose origin is inside a solid reports distance 0 and the reversed ray direction as normal.
+     ```
+     // Example:
+     Ray ray(Point3D(-5, 0, 0), Point3D(1, 0, 0));
+     RayHit hit;
+     if(ray.intersect(Sphere(Point3D(0,0,0), 1), hit)) {
+         // hit.distance = 4, hit.normal = (-1, 0, 0)
+     }
+     ```
+     */
+    class Ray {
+    private:
+
+        /**
+         * @brief Origin of the ray.
+         * @param origin
+         */
+        Vec3 origin;
+
+        /**
+         * @brief Unit direction of the ray.
+         * @param direction
+         */
+        Vec3 direction;
+
+        /**
+         * @brief Maximum distance: intersections farther than this are ignored.
+         * @param max_distance
+         */
+        float max_distance;
+
+        /**
+         * @brief Support method that clips the ray against the slabs |(x - center) * axis[i]| <= halfwidth[i] (slab test). On success it stores the entering distance in `t`, and the index (0, 1, 2; -1 if the origin is inside) and sign of the entering slab in `axis` and `sign`.
+         * @return Returns a boolean value.
+         */
+        bool intersect_slabs(const Vec3& center, const Vec3 axes[3], const Vec3& halfwidth, float& t, int& axis, float& sign) const ;
+
+    public:
+
+        /**
+         * @name Constructors.
+         * @{
+         */
+
+            /**
+             * @brief Constructor of the ray starting at `origin` along `direction`, which is normalized. It throws `std::invalid_argument` if `direction` is the null vector.
+             * @param origin origin of the ray.
+             * @param direction direction of the ray.
+             * @param max_distance maximum distance (unbounded by default).
+             */
+            Ray(const Vec3& origin, const Vec3& direction, float max_distance = std::numeric_limits<float>::infinity());
+
+            /**
+             * @brief Same of the previous constructor, with `Point3D` arguments.
+             */
+            Ray(const Point3D& origin, const Point3D& direction, float max_distance = std::numeric_limits<float>::infinity());
+
+        /// @}
+
+        /**
+         * @name Getters and Setters
+         * @{
+         */
+
+            Vec3 getOrigin() const ;
+            Vec3 getDirection() const ;
+            float getMaxDistance() const ;
+
+            /**
+             * @brief Method that sets the maximum distance. It throws `std::invalid_argument` if `max_distance` is negative.
+             * @param max_distance maximum distance.
+             */
+            void setMaxDistance(float max_distance);
+
+        /// @}
+
+        /**
+         * @brief Method that returns the point of the ray at distance `t` from the origin.
+         * @param t distance.
+         * @return `Vec3` object.
+         */
+        Vec3 at(float t) const ;
+
+        /**
+         * @name Ray queries
+         * @brief Each method returns `true` and fills `hit` if the ray intersects the primitive within its maximum distance; `hit` is left untouched otherwise.
+         * @{
+         */
+
+            /**
+             * @brief Ray-sphere test (analytic, nearest root of the quadratic).
+             */
+            bool intersect(const Sphere& sphere, RayHit& hit) const ;
+
+            /**
+             * @brief Ray-AABB test (slab test).
+             */
+            bool intersect(const AABB& box, RayHit& hit) const ;
+
+            /**
+             * @brief Ray-OBB test: slab test in the local frame of the box.
+             */
+            bool intersect(const OBB& box, RayHit& hit) const ;
+
+            /**
+             * @brief Ray-capsule test: nearest hit between the cylinder wall and the two end-cap spheres.
+             */
+            bool intersect(const Capsule& capsule, RayHit& hit) const ;
+
+            /**
+             * @brief Ray-triangle test (Moller-Trumbore), double-sided. Degenerate triangles are never hit.
+             */
+            bool intersect(const Triangle& triangle, RayHit& hit) const ;
+
+        /// @}
+    };
+}
+
+#endif
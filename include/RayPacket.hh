@@ -0,0 +1,140 @@
+#ifndef RAY_PACKET_HH
+#define RAY_PACKET_HH
+#include <cstddef>
+#include <cstdint>
+#include "Ray.hh"
+
+namespace Geometry {
+
+    /**
+     * @class RayPacket.
+     * @brief Group of up to `RayPacket::LANES` rays stored as structure-of-arrays, tested together against one primitive. Every test evaluates all the lanes with the same branch-free body (the primitive is loaded once and broadcast, special cases are handled with per-lane selects), so the compiler maps the packet onto one SIMD register. It pays off for coherent rays, e.g. sharing an origin (shadow and line-of-sight rays) or a direction, because they tend to hit and miss the same nodes of a hierarchy (see `DynamicAABBTree::raycast`).
+     * The tests return a bitmask of the lanes that hit; if `distance` is not null, the entering distance of every hitting lane is written into `distance[l]` (0 if the origin is inside the primitive). The results are the same of the matching `Ray::intersect` methods, except on the boundaries of the primitives.
+     ```
+     // Example:
+     RayPacket packet;
+     for(int i = 0; i < 8; ++i)
+         packet.add(Ray(Point3D(0,0,0), Point3D(1, 0.1 * i, 0)));
+     float distance[RayPacket::LANES];
+     std::uint32_t mask = packet.intersect(AABB(Point3D(5,0,0), 1, 1, 1), distance);
+     ```
+     */
+    class RayPacket {
+    public:
+
+        /**
+         * @brief Maximum number of rays in a packet (one AVX register of `float`).
+         */
+        static const std::size_t LANES = 8;
+
+    private:
+
+        /**
+         * @brief Origins of the rays, one array per axis.
+         * @param origin
+         */
+        alignas(32) float origin[3][LANES];
+
+        /**
+         * @brief Unit directions of the rays, one array per axis.
+         * @param direction
+         */
+        alignas(32) float direction[3][LANES];
+
+        /**
+         * @brief Maximum distances of the rays.
+         * @param max_distance
+         */
+        alignas(32) float max_distance[LANES];
+
+        /**
+         * @brief Number of rays in the packet.
+         * @param count
+         */
+        std::size_t count;
+
+        /**
+         * @brief Support method: slab test of every lane against the slabs |(x - center) * axis[i]| <= halfwidth[i].
+         * @return `std::uint32_t` bitmask of the hitting lanes.
+         */
+        std::uint32_t intersect_slabs(const Vec3& center, const Vec3 axes[3], const Vec3& halfwidth, float* distance) const ;
+
+        /**
+         * @brief Support method that returns the mask of the lanes in use.
+         * @return `std::uint32_t` bitmask.
+         */
+        std::uint32_t active_mask() const ;
+
+    public:
+
+        /**
+         * @name Constructors.
+         * @{
+         */
+
+            /**
+             * @brief Default constructor that creates an empty packet.
+             */
+            RayPacket();
+
+            /**
+             * @brief Constructor that fills the packet with the `Ray` objects of the range [`begin`, `end`). It throws `std::length_error` if the range holds more than `LANES` rays.
+             * @tparam `Iterator` Type that represent the Iterators of a container which supports them.
+             * @param begin starting iterator.
+             * @param end ending iterator.
+             */
+            template <typename Iterator>
+            RayPacket(Iterator begin, Iterator end) : RayPacket() {
+                for(; begin != end; ++begin)
+                    this->add(*begin);
+            }
+
+        /// @}
+
+        /**
+         * @brief Method that appends a ray to the packet and returns its lane. It throws `std::length_error` if the packet is full.
+         * @param ray `Ray` object.
+         * @return `std::size_t` lane of the ray.
+         */
+        std::size_t add(const Ray& ray);
+
+        /**
+         * @brief Method that returns the ray of lane `lane`. It throws `std::out_of_range` if `lane` is not valid.
+         * @param lane lane of the ray.
+         * @return `Ray` object.
+         */
+        Ray get(std::size_t lane) const ;
+
+        /**
+         * @brief Method that sets the maximum distance of the ray of lane `lane`, e.g. to clip it at the nearest hit found so far. It throws `std::out_of_range` if `lane` is not valid and `std::invalid_argument` if `max_distance` is negative.
+         * @param lane lane of the ray.
+         * @param max_distance maximum distance.
+         */
+        void setMaxDistance(std::size_t lane, float max_distance);
+
+        /**
+         * @brief Method that removes all the rays.
+         */
+        void clear();
+
+        /**
+         * @brief Method that returns the number of rays.
+         * @return `std::size_t` value.
+         */
+        std::size_t size() const ;
+
+        /**
+         * @name Packet queries
+         * @{
+         */
+
+            std::uint32_t intersect(const Sphere& sphere, float* distance = nullptr) const ;
+            std::uint32_t intersect(const AABB& box, float* distance = nullptr) const ;
+            std::uint32_t intersect(const OBB& box, float* distance = nullptr) const ;
+            std::uint32_t intersect(const Triangle& triangle, float* distance = nullptr) const ;
+
+        /// @}
+    };
+}
+
+#endif
@@ -0,0 +1,165 @@
+#ifndef SUPPORT_MAPPING_HH
+#define SUPPORT_MAPPING_HH
+#include <vector>
+#include "Vec3.hh"
+#include "Point2D.hh"
+#include "Triangle.hh"
+#include "data_structures/AABB.hh"
+#include "data_structures/OBB.hh"
+#include "data_structures/Sphere.hh"
+#include "data_structures/Capsule.hh"
+#include "data_structures/Lozenge.hh"
+
+namespace Geometry {
+
+    /**
+     * @class SupportMapping.
+     * @brief Interface of a convex shape described by its support mapping: `support(d)` returns a point of the shape farthest along direction `d`. It is all `GJK` needs to know about a shape, so any pair of adapters below can be tested against each other. The adapters copy the data of the wrapped shape in world space: rebuild them (they are cheap) when the shape moves.
+     ```
+     // Example:
+     SphereSupport a(Sphere(Point3D(0,0,0), 1));
+     OBBSupport b(box);
+     GJKResult r = GJK::query(a, b);
+     ```
+     */
+    class SupportMapping {
+    public:
+        virtual ~SupportMapping() = default;
+
+        /**
+         * @brief Method that returns a point of the shape farthest along `direction`. `direction` does not need to be normalized and may be the null vector.
+         * @param direction search direction.
+         * @return `Vec3` support point.
+         */
+        virtual Vec3 support(const Vec3& direction) const = 0;
+
+        /**
+         * @brief Method that returns a point inside the shape, used to seed the search direction.
+         * @return `Vec3` object.
+         */
+        virtual Vec3 getCenter() const = 0;
+    };
+
+    /**
+     * @class SphereSupport.
+     * @brief Support mapping of a `Sphere`.
+     */
+    class SphereSupport : public SupportMapping {
+    private:
+        Vec3 center;
+        float radius;
+    public:
+        explicit SphereSupport(const Sphere& sphere);
+        Vec3 support(const Vec3& direction) const override;
+        Vec3 getCenter() const override;
+    };
+
+    /**
+     * @class CapsuleSupport.
+     * @brief Support mapping of a `Capsule`: the farthest endpoint of the medial segment, pushed out by the radius.
+     */
+    class CapsuleSupport : public SupportMapping {
+    private:
+        Vec3 start, end;
+        float radius;
+    public:
+        explicit CapsuleSupport(const Capsule& capsule);
+        Vec3 support(const Vec3& direction) const override;
+        Vec3 getCenter() const override;
+    };
+
+    /**
+     * @class LozengeSupport.
+     * @brief Support mapping of a `Lozenge`: the farthest corner of the rectangle, pushed out by the radius.
+     */
+    class LozengeSupport : public SupportMapping {
+    private:
+        Vec3 origin, edge[2];
+        float radius;
+    public:
+        explicit LozengeSupport(const Lozenge& lozenge);
+        Vec3 support(const Vec3& direction) const override;
+        Vec3 getCenter() const override;
+    };
+
+    /**
+     * @class OBBSupport.
+     * @brief Support mapping of an `OBB`: the corner selected by the signs of the direction along the local axes.
+     */
+    class OBBSupport : public SupportMapping {
+    private:
+        Vec3 center, axis[3], halfwidth;
+    public:
+        explicit OBBSupport(const OBB& box);
+        Vec3 support(const Vec3& direction) const override;
+        Vec3 getCenter() const override;
+    };
+
+    /**
+     * @class AABBSupport.
+     * @brief Support mapping of an `AABB`: the corner selected by the signs of the direction.
+     */
+    class AABBSupport : public SupportMapping {
+    private:
+        Vec3 center, radius;
+    public:
+        explicit AABBSupport(const AABB& box);
+        Vec3 support(const Vec3& direction) const override;
+        Vec3 getCenter() const override;
+    };
+
+    /**
+     * @class TriangleSupport.
+     * @brief Support mapping of a `Triangle`: the farthest of its three vertices.
+     */
+    class TriangleSupport : public SupportMapping {
+    private:
+        Vec3 vertex[3];
+    public:
+        explicit TriangleSupport(const Triangle& triangle);
+        Vec3 support(const Vec3& direction) const override;
+        Vec3 getCenter() const override;
+    };
+
+    /**
+     * @class HullSupport.
+     * @brief Support mapping of a convex hull given by its vertices, e.g. the output of `QuickHull`: the farthest vertex, found with a linear scan. Non-extreme points are allowed, they only cost time. It throws `std::invalid_argument` if there are no vertices.
+     */
+    class HullSupport : public SupportMapping {
+    private:
+        std::vector<Vec3> vertices;
+        Vec3 center;
+
+        /**
+         * @brief Support method that computes the centroid of the vertices. It throws `std::invalid_argument` if there are no vertices.
+         */
+        void init_center();
+
+    public:
+
+        /**
+         * @brief Constructor from a range of 3D points (`Point3D`, `Vec3` or any type with `getX`, `getY` and `getZ`).
+         * @tparam `Iterator` Type that represent the Iterators of a container which supports them.
+         * @param begin starting iterator.
+         * @param end ending iterator.
+         */
+        template <typename Iterator>
+        HullSupport(Iterator begin, Iterator end) {
+            for(; begin != end; ++begin)
+                this->vertices.push_back(Vec3(begin->getX(), begin->getY(), begin->getZ()));
+            this->init_center();
+        }
+
+        /**
+         * @brief Constructor from a planar hull (e.g. the output of `QuickHull::quick_hull`) lying on the plane Z = `z`.
+         * @param hull vertices of the hull.
+         * @param z height of the plane.
+         */
+        explicit HullSupport(const std::vector<Point2D>& hull, float z = 0.0f);
+
+        Vec3 support(const Vec3& direction) const override;
+        Vec3 getCenter() const override;
+    };
+}
+
+#endif
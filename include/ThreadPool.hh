@@ -0,0 +1,140 @@
+#ifndef THREAD_POOL_HH
+#define THREAD_POOL_HH
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Geometry {
+
+    /**
+     * @class ThreadPool.
+     * @brief Work-stealing thread pool. Every worker owns a task deque: it pops its own tasks from the back and, when it runs out of work, steals from the front of the other workers' deques, so uneven tasks are balanced without a central queue.
+     ```
+     // Example:
+     ThreadPool pool(4);
+     std::vector<int> squares(100);
+     pool.parallel_for(100, [&](std::size_t i, std::size_t worker) {
+         squares[i] = i * i;
+     });
+     ```
+     */
+    class ThreadPool {
+    public:
+
+        /**
+         * @brief Type of a task: it receives the task index and the index of the worker running it.
+         */
+        using Task = std::function<void(std::size_t, std::size_t)>;
+
+    private:
+
+        /**
+         * @brief Task deque owned by one worker.
+         */
+        struct WorkerQueue {
+            std::mutex mutex;
+            std::deque<std::size_t> tasks;
+        };
+
+        /**
+         * @brief Worker threads.
+         * @param workers
+         */
+        std::vector<std::thread> workers;
+
+        /**
+         * @brief One deque of task indices per worker.
+         * @param queues
+         */
+        std::vector<std::unique_ptr<WorkerQueue>> queues;
+
+        /**
+         * @brief Body of the current `parallel_for`.
+         * @param body
+         */
+        const Task* body;
+
+        /**
+         * @brief Number of tasks of the current `parallel_for` not yet completed.
+         * @param remaining
+         */
+        std::atomic<std::size_t> remaining;
+
+        /**
+         * @brief Incremented at every `parallel_for` to wake the workers up.
+         * @param generation
+         */
+        std::size_t generation;
+
+        /**
+         * @brief Set by the destructor to stop the workers.
+         * @param stop
+         */
+        bool stop;
+
+        /**
+         * @brief Mutex and condition variables used to sleep and to wait for completion.
+         */
+        std::mutex state_mutex;
+        std::condition_variable work_ready;
+        std::condition_variable work_done;
+
+        /**
+         * @brief Support method that takes a task for worker `id`: from the back of its own deque first, then from the front of the others.
+         * @param id worker index.
+         * @param task output task index.
+         * @return Returns `true` if a task was found.
+         */
+        bool take_task(std::size_t id, std::size_t& task);
+
+        /**
+         * @brief Support method run by every worker thread.
+         * @param id worker index.
+         */
+        void worker_loop(std::size_t id);
+
+    public:
+
+        /**
+         * @name Constructors.
+         * @{
+         */
+
+            /**
+             * @brief Constructor that starts `threads` workers. With 0 (the default) it starts one worker per hardware thread.
+             * @param threads number of workers.
+             */
+            explicit ThreadPool(std::size_t threads = 0);
+
+        /// @}
+
+        /**
+         * @brief Destructor that stops and joins the workers.
+         */
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        /**
+         * @brief Method that returns the number of workers.
+         * @return `std::size_t` value.
+         */
+        std::size_t size() const ;
+
+        /**
+         * @brief Method that runs `body(i, worker)` for every `i` in [0, `count`) on the workers and returns when all of them have completed. The indices are dealt to the workers in contiguous blocks and balanced by stealing. It must not be called from inside a task.
+         * @param count number of tasks.
+         * @param body task body.
+         */
+        void parallel_for(std::size_t count, const Task& body);
+    };
+}
+
+#endif
@@ -0,0 +1,122 @@
+#ifndef TIME_OF_IMPACT_HH
+#define TIME_OF_IMPACT_HH
+#include "Vec3.hh"
+#include "Mat3.hh"
+#include "SupportMapping.hh"
+#include "data_structures/AABB.hh"
+#include "data_structures/OBB.hh"
+#include "data_structures/Sphere.hh"
+#include "data_structures/Capsule.hh"
+
+namespace Geometry {
+
+    /**
+     * @brief Rigid motion of a shape over a time step, for `TimeOfImpact::conservative_advancement`: at time `t` in [0,1] the shape is rotated by `angular * t` (rotation vector: axis times angle in radians) about its start center (`SupportMapping::getCenter`) and then translated by `linear * t`.
+     */
+    struct Motion {
+        /// Displacement of the center over the step.
+        Vec3 linear;
+        /// Rotation vector over the step (axis * angle, radians).
+        Vec3 angular;
+
+        /**
+         * @brief Method that returns the motion between the start transform `(r0, t0)` and the end transform `(r1, t1)` of a body whose (world space) center at the start is `center`. A point `x` of the body moves from `r0 * x + t0` to `r1 * x + t1`.
+         * @param r0 start rotation.
+         * @param t0 start translation.
+         * @param r1 end rotation.
+         * @param t1 end translation.
+         * @param center center of the body at the start.
+         * @return `Motion` object.
+         */
+        static Motion from_transforms(const Mat3& r0, const Vec3& t0, const Mat3& r1, const Vec3& t1, const Vec3& center);
+    };
+
+    /**
+     * @class TimeOfImpact.
+     * @brief Continuous collision tests. Each method sweeps the shapes from their start to their end pose over a time step mapped to [0,1] and returns `true` with the earliest time of impact in `toi` if they touch during the step (0 if they already overlap at the start); `toi` is left untouched otherwise. Between the two poses every point moves linearly, so fast shapes cannot tunnel through thin ones as with the discrete tests.
+     ```
+     // Example:
+     Sphere bullet_start(Point3D(-10, 0, 0), 0.1f), bullet_end(Point3D(10, 0, 0), 0.1f);
+     OBB wall(Point3D(0,0,0), Point3D(1,0,0), Point3D(0,1,0), Point3D(0,0,1), Point3D(0.05f, 5, 5));
+     float toi;
+     if(TimeOfImpact::sphere_OBB(bullet_start, bullet_end, wall, toi)) {
+         // toi = 0.4925: the discrete test at start and end misses the wall
+     }
+     ```
+     */
+    class TimeOfImpact {
+    public:
+
+        /**
+         * @brief Maximum number of iterations of the conservative advancement methods: when it is reached the shapes are reported in contact at the last (still separated) time, which is earlier than any real impact. It only happens to pairs that graze each other, whose distance barely shrinks at each step.
+         */
+        static const int MAX_ITERATIONS = 256;
+
+    private:
+
+        /**
+         * @brief Support method that sweeps a sphere of radius `radius` from `c0` to `c1` against the box centered at the origin with half extents `halfwidth` along the coordinate axes: it casts a ray against the box rounded by `radius`.
+         * @return Returns a boolean value.
+         */
+        static bool sphere_box(const Vec3& c0, const Vec3& c1, float radius, const Vec3& halfwidth, float& toi);
+
+    public:
+
+        /**
+         * @brief Swept sphere-sphere test (Ericson, 5.5.5): both spheres translate from their start to their end center; the radii of the start spheres are used.
+         * @param a_start first sphere at the start of the step.
+         * @param a_end first sphere at the end of the step.
+         * @param b_start second sphere at the start of the step.
+         * @param b_end second sphere at the end of the step.
+         * @param toi time of impact, in [0,1].
+         * @return Returns a boolean value.
+         */
+        static bool sphere_sphere(const Sphere& a_start, const Sphere& a_end, const Sphere& b_start, const Sphere& b_end, float& toi);
+
+        /**
+         * @brief Swept sphere-`AABB` test (Ericson, 5.5.7): the sphere translates from its start to its end center against the static box. For a moving box, pass the sphere positions relative to it (i.e. subtract the box displacement from the end center).
+         * @param start sphere at the start of the step.
+         * @param end sphere at the end of the step.
+         * @param box static box.
+         * @param toi time of impact, in [0,1].
+         * @return Returns a boolean value.
+         */
+        static bool sphere_AABB(const Sphere& start, const Sphere& end, const AABB& box, float& toi);
+
+        /**
+         * @brief Swept sphere-`OBB` test: same of `sphere_AABB`, in the local frame of the box.
+         * @param start sphere at the start of the step.
+         * @param end sphere at the end of the step.
+         * @param box static box.
+         * @param toi time of impact, in [0,1].
+         * @return Returns a boolean value.
+         */
+        static bool sphere_OBB(const Sphere& start, const Sphere& end, const OBB& box, float& toi);
+
+        /**
+         * @brief Swept capsule-capsule test: the endpoints of both capsules move linearly from the start to the end pose (which also covers rotations, with a slight shortening of the segment mid-step). It uses conservative advancement on the exact segment distance, so a hit is reported within `tolerance` of contact; the radii of the start capsules are used.
+         * @param a_start first capsule at the start of the step.
+         * @param a_end first capsule at the end of the step.
+         * @param b_start second capsule at the start of the step.
+         * @param b_end second capsule at the end of the step.
+         * @param toi time of impact, in [0,1].
+         * @param tolerance distance at which the capsules are considered in contact.
+         * @return Returns a boolean value.
+         */
+        static bool capsule_capsule(const Capsule& a_start, const Capsule& a_end, const Capsule& b_start, const Capsule& b_end, float& toi, float tolerance = 1e-4f);
+
+        /**
+         * @brief Conservative advancement (Mirtich) for any pair of convex shapes: at each step `GJK` gives the distance `d` and normal `n` of the shapes at time `t`, and `t` is advanced by `d` over an upper bound of the approach speed along `n` (linear speed plus angular speed times the radius of the shape), which can never step past the first contact.
+         * @param a first shape, at the start of the step.
+         * @param motion_a motion of the first shape.
+         * @param b second shape, at the start of the step.
+         * @param motion_b motion of the second shape.
+         * @param toi time of impact, in [0,1].
+         * @param tolerance distance at which the shapes are considered in contact.
+         * @return Returns a boolean value.
+         */
+        static bool conservative_advancement(const SupportMapping& a, const Motion& motion_a, const SupportMapping& b, const Motion& motion_b, float& toi, float tolerance = 1e-3f);
+    };
+}
+
+#endif
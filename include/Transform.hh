@@ -0,0 +1,68 @@
+#ifndef TRANSFORM_HH
+#define TRANSFORM_HH
+#include "Vec3.hh"
+#include "Mat3.hh"
+
+namespace Geometry {
+
+    /**
+     * @class Transform.
+     * @brief Rigid transform (pose of a body): a rotation followed by a translation, mapping a point `x` of the body frame to `rotation * x + translation` in world space. `rotation` is assumed orthonormal, so the inverse uses its transpose. Like `Vec3` and `Mat3` it is trivially copyable and `constexpr`.
+     ```
+     // Example:
+     constexpr Transform T(Mat3(0, -1, 0,
+                                1,  0, 0,
+                                0,  0, 1), Vec3(1, 0, 0));  // quarter turn about z, then 1 along x
+     constexpr Vec3 p = T.apply(Vec3(1, 0, 0));                 // (1, 1, 0)
+     constexpr Vec3 q = T.apply_inverse(p);                     // (1, 0, 0)
+     ```
+     */
+    class Transform {
+    public:
+        /// Rotation of the body frame.
+        Mat3 rotation;
+        /// Position of the origin of the body frame.
+        Vec3 translation;
+
+        /**
+         * @brief Constructor of the transform; the identity by default.
+         * @param rotation rotation of the body frame.
+         * @param translation position of the origin of the body frame.
+         */
+        constexpr Transform(const Mat3& rotation = Mat3::identity(), const Vec3& translation = Vec3()) : rotation(rotation), translation(translation) {}
+
+        /**
+         * @brief Method that maps the point `p` from the body frame to world space.
+         * @return `Vec3` object.
+         */
+        constexpr Vec3 apply(const Vec3& p) const {
+            return this->rotation * p + this->translation;
+        }
+
+        /**
+         * @brief Method that maps the point `p` from world space to the body frame.
+         * @return `Vec3` object.
+         */
+        constexpr Vec3 apply_inverse(const Vec3& p) const {
+            return this->rotation.transpose() * (p - this->translation);
+        }
+
+        /**
+         * @brief Method that maps the direction `v` from the body frame to world space (rotation only).
+         * @return `Vec3` object.
+         */
+        constexpr Vec3 rotate(const Vec3& v) const {
+            return this->rotation * v;
+        }
+
+        /**
+         * @brief Method that maps the direction `v` from world space to the body frame (rotation only).
+         * @return `Vec3` object.
+         */
+        constexpr Vec3 rotate_inverse(const Vec3& v) const {
+            return this->rotation.transpose() * v;
+        }
+    };
+}
+
+#endif
@@ -13,6 +13,11 @@ namespace Geometry {
         Triangle(const Point3D& v1, const Point3D& v2, const Point3D& v3);
         ~Triangle() override = default;
 
+        // Getters
+        Point3D getA() const;
+        Point3D getB() const;
+        Point3D getC() const;
+
         // Operations with triangles
         float getArea() const override;
         float getPerimeter() const override;
@@ -0,0 +1,165 @@
+#ifndef VEC3_HH
+#define VEC3_HH
+#include <type_traits>
+#include "Point3D.hh"
+
+namespace Geometry {
+
+    /**
+     * @class Vec3.
+     * @brief Compact 3D vector for hot paths. Unlike `Point3D` it has no base class, no user-written copy operations and no checked accessors: it is trivially copyable (containers of `Vec3` can be `memcpy`'d), 16-byte aligned (one SIMD register, the fourth float is padding) and all of its arithmetic is `constexpr`. As for `Point3D`, `operator*` between two vectors is the dot product.
+     ```
+     // Example:
+     constexpr Vec3 a(1, 2, 3);
+     constexpr Vec3 b = a * 2.0f + Vec3(1, 1, 1); // (3, 5, 7)
+     constexpr float d = a * b;                     // 34
+     Point3D p = b.toPoint3D();
+     Vec3 c(p);
+     ```
+     */
+    struct alignas(16) Vec3 {
+        float x, y, z;
+
+        /**
+         * @name Constructors.
+         * @{
+         */
+
+            /**
+             * @brief Default constructor that sets the coordinates to X = 0, Y = 0 and Z = 0. It accepts 0, 1, 2 or 3 arguments.
+             */
+            constexpr Vec3(float x = 0.0f, float y = 0.0f, float z = 0.0f) : x(x), y(y), z(z) {}
+
+            /**
+             * @brief Conversion constructor from a `Point3D` object.
+             * @param p `Point3D` object.
+             */
+            explicit Vec3(const Point3D& p) : x(p.getX()), y(p.getY()), z(p.getZ()) {}
+
+        /// @}
+
+        /**
+         * @brief Method that converts the vector into a `Point3D` object.
+         * @return `Point3D` object.
+         */
+        Point3D toPoint3D() const { return Point3D(x, y, z); }
+
+        /**
+         * @name Getters and Setters
+         * @brief Same names of `Point3D`, so that the templates written for `Point3D` ranges also accept `Vec3` ranges.
+         * @{
+         */
+
+            constexpr float getX() const { return x; }
+            constexpr float getY() const { return y; }
+            constexpr float getZ() const { return z; }
+
+        /// @}
+
+        /**
+         * @name Operator(s) ovreloading
+         * @{
+         */
+
+            /**
+             * @brief Overloading of the `operator[]` operator (const variant): `0` is x, `1` is y and `2` is z. No bound checking is performed.
+             */
+            constexpr float operator[](int index) const { return index == 0 ? x : (index == 1 ? y : z); }
+
+            /**
+             * @brief Overloading of the `operator[]` operator (non-const variant): `0` is x, `1` is y and `2` is z. No bound checking is performed.
+             */
+            float& operator[](int index) { return index == 0 ? x : (index == 1 ? y : z); }
+
+            Vec3& operator+=(const Vec3& o) { x += o.x; y += o.y; z += o.z; return *this; }
+            Vec3& operator-=(const Vec3& o) { x -= o.x; y -= o.y; z -= o.z; return *this; }
+            Vec3& operator*=(float s) { x *= s; y *= s; z *= s; return *this; }
+
+        /// @}
+    };
+
+    constexpr Vec3 operator+(const Vec3& a, const Vec3& b) { return Vec3(a.x + b.x, a.y + b.y, a.z + b.z); }
+    constexpr Vec3 operator-(const Vec3& a, const Vec3& b) { return Vec3(a.x - b.x, a.y - b.y, a.z - b.z); }
+    constexpr Vec3 operator-(const Vec3& a) { return Vec3(-a.x, -a.y, -a.z); }
+    constexpr Vec3 operator*(const Vec3& a, float s) { return Vec3(a.x * s, a.y * s, a.z * s); }
+    constexpr Vec3 operator*(float s, const Vec3& a) { return Vec3(a.x * s, a.y * s, a.z * s); }
+    constexpr Vec3 operator/(const Vec3& a, float s) { return Vec3(a.x / s, a.y / s, a.z / s); }
+    /// Dot product, like `Point3D::operator*`.
+    constexpr float operator*(const Vec3& a, const Vec3& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+    constexpr bool operator==(const Vec3& a, const Vec3& b) { return a.x == b.x && a.y == b.y && a.z == b.z; }
+    constexpr bool operator!=(const Vec3& a, const Vec3& b) { return !(a == b); }
+
+    /**
+     * @brief Function that returns the dot product of `a` and `b`.
+     */
+    constexpr float dot(const Vec3& a, const Vec3& b) { return a * b; }
+
+    /**
+     * @brief Function that returns the cross product of `a` and `b`.
+     */
+    constexpr Vec3 cross(const Vec3& a, const Vec3& b) {
+        return Vec3(a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x);
+    }
+
+    /**
+     * @class Vec4.
+     * @brief Compact 4D vector with the same properties of `Vec3`: trivially copyable, 16-byte aligned, `constexpr` arithmetic. It is useful for homogeneous coordinates and for packing a sphere (center and radius) into one register.
+     ```
+     // Example:
+     constexpr Vec4 sphere(Vec3(1, 2, 3), 0.5f); // center (1, 2, 3), radius 0.5
+     constexpr Vec3 center = sphere.xyz();
+     ```
+     */
+    struct alignas(16) Vec4 {
+        float x, y, z, w;
+
+        /**
+         * @name Constructors.
+         * @{
+         */
+
+            /**
+             * @brief Default constructor that sets every coordinate to 0. It accepts 0, 1, 2, 3 or 4 arguments.
+             */
+            constexpr Vec4(float x = 0.0f, float y = 0.0f, float z = 0.0f, float w = 0.0f) : x(x), y(y), z(z), w(w) {}
+
+            /**
+             * @brief Constructor from a `Vec3` object and a fourth coordinate.
+             */
+            constexpr Vec4(const Vec3& v, float w) : x(v.x), y(v.y), z(v.z), w(w) {}
+
+            /**
+             * @brief Conversion constructor from a `Point3D` object and a fourth coordinate (0 by default).
+             */
+            explicit Vec4(const Point3D& p, float w = 0.0f) : x(p.getX()), y(p.getY()), z(p.getZ()), w(w) {}
+
+        /// @}
+
+        /**
+         * @brief Method that returns the first three coordinates.
+         * @return `Vec3` object.
+         */
+        constexpr Vec3 xyz() const { return Vec3(x, y, z); }
+
+        /**
+         * @brief Method that converts the first three coordinates into a `Point3D` object.
+         * @return `Point3D` object.
+         */
+        Point3D toPoint3D() const { return Point3D(x, y, z); }
+
+        constexpr float operator[](int index) const { return index == 0 ? x : (index == 1 ? y : (index == 2 ? z : w)); }
+        float& operator[](int index) { return index == 0 ? x : (index == 1 ? y : (index == 2 ? z : w)); }
+    };
+
+    constexpr Vec4 operator+(const Vec4& a, const Vec4& b) { return Vec4(a.x + b.x, a.y + b.y, a.z + b.z, a.w + b.w); }
+    constexpr Vec4 operator-(const Vec4& a, const Vec4& b) { return Vec4(a.x - b.x, a.y - b.y, a.z - b.z, a.w - b.w); }
+    constexpr Vec4 operator*(const Vec4& a, float s) { return Vec4(a.x * s, a.y * s, a.z * s, a.w * s); }
+    constexpr Vec4 operator*(float s, const Vec4& a) { return Vec4(a.x * s, a.y * s, a.z * s, a.w * s); }
+    /// Dot product of the four coordinates.
+    constexpr float operator*(const Vec4& a, const Vec4& b) { return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w; }
+
+    static_assert(std::is_trivially_copyable<Vec3>::value && sizeof(Vec3) == 16 && alignof(Vec3) == 16, "Vec3 must be a 16-byte POD-like value");
+    static_assert(std::is_trivially_copyable<Vec4>::value && sizeof(Vec4) == 16 && alignof(Vec4) == 16, "Vec4 must be a 16-byte POD-like value");
+}
+
+#endif
@@ -2,6 +2,7 @@
 #define AXIS_ALIGNED_BOUNDING_BOX_HH
 #include "../Point3D.hh"
 #include "../Matrix.hh"
+#include "../Transform.hh"
 #include <array>
 #include <cmath>
 #include <stdexcept>
@@ -91,6 +92,19 @@
 
             /// @}
 
+            /**
+             * @name Getters and Setters
+             * @{
+             */
+
+                /**
+                 * @brief Method that returns a `Point3D` object: the center of the `AABB`.
+                 * @return `Point3D` object.
+                 */
+                Point3D getCenter() const ;
+
+            /// @}
+
             /**
              * @brief Test that evaluates the instersaction between two `AABB`. It returns a boolean value: `true` if the two `AABB` are intersecting and `false` otherwise.
              * @param other `AABB` object.
@@ -102,12 +116,41 @@
             // find maximum extends, and store result into AABB B (other)
             /**
              * @brief Transforms `this` `AABB` object by the matrix `M` and traslation `T`, finds maximum, extends, and stores result into `other` `AABB` object.
-             * @param other `AABB` object.
+             * @param M 3x3 `Matrix` object.
              * @param T traslation.
              * @param other `AABB` object.
+             * @return none.
+             */
+            void update_AABB(const Matrix& M, const float T[3], AABB& other) const ;
+
+            /**
+             * @brief `Transform` overload of `update_AABB`: stores into `other` the `AABB` of `this` box moved by the rigid transform `transform` (Arvo's method: the center is transformed and every extent is the sum of the old extents weighted by the absolute values of a row of the rotation). It allocates nothing.
+             * @param transform rigid transform.
+             * @param other `AABB` object.
+             * @return none.
+             */
+            void update_AABB(const Transform& transform, AABB& other) const ;
+
+            /**
+             * @brief Method that returns `true` if `other` lies entirely inside `this` `AABB`.
+             * @param other `AABB` object.
              * @return Returns a boolean value.
              */
-            void update_AABB(Matrix M, float T[3], AABB& other);
+            bool contains(const AABB& other) const ;
+
+            /**
+             * @brief Method that returns the surface area of the `AABB`, used as cost metric by bounding volume hierarchies.
+             * @return `float` value.
+             */
+            float surface_area() const ;
+
+            /**
+             * @brief Method that returns the smallest `AABB` enclosing both `a` and `b`.
+             * @param a `AABB` object.
+             * @param b `AABB` object.
+             * @return `AABB` object.
+             */
+            static AABB merge(const AABB& a, const AABB& b);
 
         };
     }
@@ -0,0 +1,155 @@
+#ifndef AABB_BATCH_HH
+#define AABB_BATCH_HH
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "AABB.hh"
+#include "../AlignedAllocator.hh"
+#include "../Transform.hh"
+
+namespace Geometry {
+
+    /**
+     * @class AABBBatch.
+     * @brief Structure-of-arrays (SoA) store of `AABB` objects. Centers and radii are kept in separate, 32-byte aligned `float` arrays so that overlap tests can be run on `AABBBatch::LANES` boxes at a time. The results are the same of `AABB::test_AABB_AABB_intersection`.
+     ```
+     // Example:
+     AABBBatch batch;
+     batch.add(AABB(Point3D(0,0,0), 1, 1, 1));
+     batch.add(AABB(Point3D(5,0,0), 1, 1, 1));
+     std::vector<std::uint32_t> hits(batch.size());
+     std::size_t n = batch.query(AABB(Point3D(1,0,0), 1, 1, 1), hits.data()); // n = 1, hits[0] = 0
+     ```
+     */
+    class AABBBatch {
+    public:
+
+        /**
+         * @brief Number of boxes processed by a single block of the overlap kernel (one AVX register of `float`).
+         */
+        static const std::size_t LANES = 8;
+
+        /**
+         * @brief `std::vector` of `float` aligned for SIMD loads.
+         */
+        using FloatArray = std::vector<float, AlignedAllocator<float, 32>>;
+
+    private:
+
+        /**
+         * @brief Coordinates of the centers, one array per axis.
+         * @param center
+         */
+        FloatArray center[3];
+
+        /**
+         * @brief Radii of the boxes, one array per axis.
+         * @param radius
+         */
+        FloatArray radius[3];
+
+        /**
+         * @brief Number of stored boxes. The arrays are padded up to a multiple of `LANES`.
+         * @param count
+         */
+        std::size_t count;
+
+        /**
+         * @brief Support method that tests the box (`cx`, `cy`, `cz`, `rx`, `ry`, `rz`) against a block of `LANES` boxes starting at `first` and returns a bitmask of the overlapping lanes. Lanes beyond `size()` are always cleared.
+         * @return `std::uint32_t` bitmask: bit `l` is set if box `first + l` overlaps.
+         */
+        std::uint32_t overlap_block(std::size_t first, float cx, float cy, float cz, float rx, float ry, float rz) const ;
+
+    public:
+
+        /**
+         * @name Constructors.
+         * @{
+         */
+
+            /**
+             * @brief Default constructor that creates an empty batch.
+             */
+            AABBBatch();
+
+            /**
+             * @brief Constructor that fills the batch with the `AABB` objects of the range [`begin`, `end`).
+             * @tparam `Iterator` Type that represent the Iterators of a container which supports them.
+             * @param begin starting iterator.
+             * @param end ending iterator.
+             */
+            template <typename Iterator>
+            AABBBatch(Iterator begin, Iterator end) : count(0) {
+                for(; begin != end; ++begin)
+                    this->add(*begin);
+            }
+
+        /// @}
+
+        /**
+         * @brief Method that appends an `AABB` to the batch. It returns the index of the stored box.
+         * @param box `AABB` object.
+         * @return `std::size_t` index of the box.
+         */
+        std::size_t add(const AABB& box);
+
+        /**
+         * @brief Method that overwrites the box stored at `index`. It throws `std::out_of_range` if `index` is not valid.
+         * @param index index of the box.
+         * @param box `AABB` object.
+         */
+        void set(std::size_t index, const AABB& box);
+
+        /**
+         * @brief Method that returns the box stored at `index` as an `AABB` object. It throws `std::out_of_range` if `index` is not valid.
+         * @param index index of the box.
+         * @return `AABB` object.
+         */
+        AABB get(std::size_t index) const ;
+
+        /**
+         * @brief Method that reserves storage for at least `n` boxes.
+         * @param n number of boxes.
+         */
+        void reserve(std::size_t n);
+
+        /**
+         * @brief Method that removes all the boxes.
+         */
+        void clear();
+
+        /**
+         * @brief Method that returns the number of stored boxes.
+         * @return `std::size_t` value.
+         */
+        std::size_t size() const ;
+
+        /**
+         * @brief Tests `box` against every box of the batch, `LANES` boxes at a time. The indices of the overlapping boxes are written, in increasing order, into `out`, which must have room for `size()` indices.
+         * @param box `AABB` object.
+         * @param out caller-supplied index buffer.
+         * @return `std::size_t` number of overlapping boxes written into `out`.
+         */
+        std::size_t query(const AABB& box, std::uint32_t* out) const ;
+
+        /**
+         * @brief Tests a block of `n` boxes against every box of the batch. For each hit the index of the query box is written into `out_query` and the index of the batch box into `out_index`. At most `capacity` hits are written, but the total number of hits is always returned, so the caller can grow its buffers and retry when the result is greater than `capacity`.
+         * @param boxes pointer to the first query box.
+         * @param n number of query boxes.
+         * @param out_query caller-supplied buffer of query indices.
+         * @param out_index caller-supplied buffer of batch indices.
+         * @param capacity size of the two buffers.
+         * @return `std::size_t` total number of overlapping pairs.
+         */
+        std::size_t query_block(const AABB* boxes, std::size_t n, std::uint32_t* out_query, std::uint32_t* out_index, std::size_t capacity) const ;
+
+        /**
+         * @brief Method that writes into `out` the boxes of the batch moved by the rigid transforms `transforms`, one per box (`size()` entries): Arvo's method: the center is transformed and every extent is the sum of the old extents weighted by the absolute values of a row of the rotation, as in `AABB::update_AABB`. The boxes are moved `LANES` at a time: a block is computed into local lane arrays by a branch-free loop that the compiler vectorizes (the lane arrays cannot alias the batch, so no run-time alias checks are needed) and then copied out, so a whole population of local bounds is moved to world space in one pass. `out` is resized to the batch, reusing its storage; it throws `std::invalid_argument` if `out` is the batch itself.
+         * @param transforms rigid transforms.
+         * @param out `AABBBatch` object.
+         */
+        void transform(const Transform* transforms, AABBBatch& out) const ;
+    };
+}
+
+#endif
@@ -1,6 +1,7 @@
 #ifndef CAPSULE_HH
 #define CAPSULE_HH
 #include "../Point3D.hh"
+#include "../Vec3.hh"
 #include "Sphere.hh"
 
 namespace Geometry {
@@ -59,6 +60,31 @@ namespace Geometry {
 
         /// @}
 
+        /**
+         * @name Getters and Setters
+         * @{
+         */
+
+            /**
+             * @brief Method that returns a `Point3D` object: the start point of the medial segment.
+             * @return `Point3D` object.
+             */
+            Point3D getStart() const ;
+
+            /**
+             * @brief Method that returns a `Point3D` object: the end point of the medial segment.
+             * @return `Point3D` object.
+             */
+            Point3D getEnd() const ;
+
+            /**
+             * @brief Method that returns a `float` value: the radius of the object.
+             * @return `float` value.
+             */
+            float getRadius() const ;
+
+        /// @}
+
         /**
          * @brief Test that evaluates the instersaction between `Capsule` and `Sphere` objects. It returns a boolean value: `true` if the two bounding box are intersecting and `false` otherwise.
          * @param s `Sphere` object.
@@ -72,6 +98,29 @@ namespace Geometry {
          * @return Returns a boolean value.
          */
         bool test_capsule_intersection(const Capsule& other) const ;
+
+        /**
+         * @brief `Vec3` overload of the `Capsule`-`Sphere` test on raw data: capsule (`start`, `end`, `radius`) and sphere (`center`, `sphere_radius`). It returns `true` if they are intersecting and `false` otherwise.
+         * @param start start point of the capsule's medial segment.
+         * @param end end point of the capsule's medial segment.
+         * @param radius radius of the capsule.
+         * @param center center of the sphere.
+         * @param sphere_radius radius of the sphere.
+         * @return Returns a boolean value.
+         */
+        static bool test_capsule_sphere_intersection(const Vec3& start, const Vec3& end, float radius, const Vec3& center, float sphere_radius);
+
+        /**
+         * @brief `Vec3` overload of the `Capsule`-`Capsule` test on raw data: capsules (`s0`, `e0`, `r0`) and (`s1`, `e1`, `r1`). It returns `true` if they are intersecting and `false` otherwise.
+         * @param s0 start point of the first medial segment.
+         * @param e0 end point of the first medial segment.
+         * @param r0 radius of the first capsule.
+         * @param s1 start point of the second medial segment.
+         * @param e1 end point of the second medial segment.
+         * @param r1 radius of the second capsule.
+         * @return Returns a boolean value.
+         */
+        static bool test_capsule_intersection(const Vec3& s0, const Vec3& e0, float r0, const Vec3& s1, const Vec3& e1, float r1);
     };
 }
 
@@ -0,0 +1,176 @@
+#ifndef CAPSULE_BATCH_HH
+#define CAPSULE_BATCH_HH
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Capsule.hh"
+#include "SphereBatch.hh"
+#include "../AlignedAllocator.hh"
+#include "../Transform.hh"
+
+namespace Geometry {
+
+    /**
+     * @class CapsuleBatch.
+     * @brief Structure-of-arrays (SoA) store of `Capsule` objects (segment start, segment end and radius, one aligned `float` array per component) with batched capsule-vs-capsule and capsule-vs-sphere kernels. The kernels evaluate the clamped segment-segment (or point-segment) distance of `GeometryUtils` for `CapsuleBatch::LANES` pairs at a time: every case of the scalar code is computed with safe denominators and the right one is selected per lane, so there are no data-dependent branches and the results match `Capsule::test_capsule_intersection` and `Capsule::test_capsule_sphere_intersection`.
+     ```
+     // Example:
+     CapsuleBatch limbs;
+     limbs.add(Capsule(Point3D(0,0,0), Point3D(0,1,0), 0.2f));
+     limbs.add(Capsule(Point3D(0.3,0,0), Point3D(0.3,1,0), 0.2f));
+     std::uint32_t a[] = {0}, b[] = {1}, mask[1];
+     float dist2[1];
+     limbs.test_capsule_pairs(a, b, 1, mask, dist2); // mask[0] = 1, dist2[0] = 0.09
+     ```
+     */
+    class CapsuleBatch {
+    public:
+
+        /**
+         * @brief Number of pairs evaluated by one block of the kernels (one AVX register of `float`).
+         */
+        static const std::size_t LANES = 8;
+
+        /**
+         * @brief `std::vector` of `float` aligned for SIMD loads.
+         */
+        using FloatArray = std::vector<float, AlignedAllocator<float, 32>>;
+
+    private:
+
+        /**
+         * @brief Start points of the medial segments, one array per axis.
+         * @param start
+         */
+        FloatArray start[3];
+
+        /**
+         * @brief End points of the medial segments, one array per axis.
+         * @param end
+         */
+        FloatArray end[3];
+
+        /**
+         * @brief Radii of the capsules.
+         * @param radius
+         */
+        FloatArray radius;
+
+        /**
+         * @brief Support method that tests the `count` (at most `LANES`) capsule pairs (`a[l]`, `b[l]`), writes the squared segment-segment distances into `dist2` (`LANES` entries) and returns a bitmask of the intersecting pairs.
+         * @return `std::uint32_t` bitmask: bit `l` is set if pair `l` intersects.
+         */
+        std::uint32_t capsule_block(const std::uint32_t* a, const std::uint32_t* b, std::size_t count, float* dist2) const ;
+
+        /**
+         * @brief Support method that tests the `count` (at most `LANES`) capsule-sphere pairs (`capsule[l]`, `sphere[l]`), writes the squared point-segment distances into `dist2` (`LANES` entries) and returns a bitmask of the intersecting pairs.
+         * @return `std::uint32_t` bitmask: bit `l` is set if pair `l` intersects.
+         */
+        std::uint32_t sphere_block(const std::uint32_t* capsule, const float* sx, const float* sy, const float* sz, const float* sr, const std::uint32_t* sphere, std::size_t count, float* dist2) const ;
+
+    public:
+
+        /**
+         * @name Constructors.
+         * @{
+         */
+
+            /**
+             * @brief Default constructor that creates an empty batch.
+             */
+            CapsuleBatch();
+
+            /**
+             * @brief Constructor that fills the batch with the `Capsule` objects of the range [`begin`, `end`).
+             * @tparam `Iterator` Type that represent the Iterators of a container which supports them.
+             * @param begin starting iterator.
+             * @param end ending iterator.
+             */
+            template <typename Iterator>
+            CapsuleBatch(Iterator begin, Iterator end) {
+                for(; begin != end; ++begin)
+                    this->add(*begin);
+            }
+
+        /// @}
+
+        /**
+         * @brief Method that appends a `Capsule` to the batch. It returns the index of the stored capsule.
+         * @param capsule `Capsule` object.
+         * @return `std::size_t` index of the capsule.
+         */
+        std::size_t add(const Capsule& capsule);
+
+        /**
+         * @brief Method that overwrites the capsule stored at `index`. It throws `std::out_of_range` if `index` is not valid.
+         * @param index index of the capsule.
+         * @param capsule `Capsule` object.
+         */
+        void set(std::size_t index, const Capsule& capsule);
+
+        /**
+         * @brief Method that returns the capsule stored at `index` as a `Capsule` object. It throws `std::out_of_range` if `index` is not valid.
+         * @param index index of the capsule.
+         * @return `Capsule` object.
+         */
+        Capsule get(std::size_t index) const ;
+
+        /**
+         * @brief Method that removes all the capsules.
+         */
+        void clear();
+
+        /**
+         * @brief Method that returns the number of stored capsules.
+         * @return `std::size_t` value.
+         */
+        std::size_t size() const ;
+
+        /**
+         * @brief Tests the `n` capsule pairs (`a[k]`, `b[k]`). Bit `k % 32` of `mask[k / 32]` is set if pair `k` intersects; `mask` must have room for (n + 31) / 32 words. If `dist2` is not null, the squared distance between the two medial segments of pair `k` is written into `dist2[k]`.
+         * @param a indices of the first capsules.
+         * @param b indices of the second capsules.
+         * @param n number of pairs.
+         * @param mask caller-supplied bitmask buffer.
+         * @param dist2 optional caller-supplied buffer of squared distances.
+         * @return `std::size_t` number of intersecting pairs.
+         */
+        std::size_t test_capsule_pairs(const std::uint32_t* a, const std::uint32_t* b, std::size_t n, std::uint32_t* mask, float* dist2 = nullptr) const ;
+
+        /**
+         * @brief Tests the `n` capsule-sphere pairs (`capsule[k]`, `sphere[k]`), where the spheres are given as SoA arrays of centers (`sx`, `sy`, `sz`) and radii (`sr`). Bit `k % 32` of `mask[k / 32]` is set if pair `k` intersects; `mask` must have room for (n + 31) / 32 words. If `dist2` is not null, the squared distance between the sphere center and the medial segment of pair `k` is written into `dist2[k]`.
+         * @param capsule indices of the capsules.
+         * @param sx x-coordinates of the sphere centers.
+         * @param sy y-coordinates of the sphere centers.
+         * @param sz z-coordinates of the sphere centers.
+         * @param sr radii of the spheres.
+         * @param sphere indices of the spheres.
+         * @param n number of pairs.
+         * @param mask caller-supplied bitmask buffer.
+         * @param dist2 optional caller-supplied buffer of squared distances.
+         * @return `std::size_t` number of intersecting pairs.
+         */
+        std::size_t test_sphere_pairs(const std::uint32_t* capsule, const float* sx, const float* sy, const float* sz, const float* sr, const std::uint32_t* sphere, std::size_t n, std::uint32_t* mask, float* dist2 = nullptr) const ;
+
+        /**
+         * @brief Same of the previous method, with the spheres taken from a `SphereBatch`.
+         * @param capsule indices of the capsules.
+         * @param spheres `SphereBatch` object.
+         * @param sphere indices of the spheres in `spheres`.
+         * @param n number of pairs.
+         * @param mask caller-supplied bitmask buffer.
+         * @param dist2 optional caller-supplied buffer of squared distances.
+         * @return `std::size_t` number of intersecting pairs.
+         */
+        std::size_t test_sphere_pairs(const std::uint32_t* capsule, const SphereBatch& spheres, const std::uint32_t* sphere, std::size_t n, std::uint32_t* mask, float* dist2 = nullptr) const ;
+
+        /**
+         * @brief Method that writes into `out` the capsules of the batch moved by the rigid transforms `transforms`, one per capsule (`size()` entries): both endpoints of the medial segment are transformed and the radius is kept. The capsules are moved `LANES` at a time: a block is computed into local lane arrays by a branch-free loop that the compiler vectorizes (the lane arrays cannot alias the batch, so no run-time alias checks are needed) and then copied out, so a whole population of local bounds is moved to world space in one pass. `out` is resized to the batch, reusing its storage; it throws `std::invalid_argument` if `out` is the batch itself.
+         * @param transforms rigid transforms.
+         * @param out `CapsuleBatch` object.
+         */
+        void transform(const Transform* transforms, CapsuleBatch& out) const ;
+    };
+}
+
+#endif
@@ -0,0 +1,121 @@
+#ifndef CONTACT_CACHE_HH
+#define CONTACT_CACHE_HH
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include "../Vec3.hh"
+#include "../Transform.hh"
+#include "../Contact.hh"
+
+namespace Geometry {
+
+    /**
+     * @class ContactCache.
+     * @brief Persistent contact manifolds, keyed by the ids of the two shapes of a pair. Every point is stored in the body frames of both shapes, so at the next frame `refresh` moves it with the new poses and recomputes its depth, dropping the points that separated or slid apart by more than the breaking distance. A pair resting on another one keeps all of its points and can skip the manifold generation; new contacts are added with `merge`, which replaces the cached points they match and keeps at most 4 points.
+     ```
+     // Example, at every frame for each pair (a, b) reported by the broadphase:
+     if(!cache.refresh(a, b, pose[a], pose[b])) {
+         ContactManifold m;
+         if(ContactGenerator::OBB_OBB(box[a], box[b], m))
+             cache.merge(a, b, m, pose[a], pose[b]);
+         else
+             cache.remove(a, b);
+     }
+     const ContactManifold* contacts = cache.find(a, b);
+     ```
+     */
+    class ContactCache {
+    private:
+
+        /**
+         * @brief Cached manifold of a pair, with its points and normal in the body frames of the two shapes.
+         */
+        struct Entry {
+            ContactManifold manifold;
+            Vec3 local_a[ContactManifold::MAX_POINTS];
+            Vec3 local_b[ContactManifold::MAX_POINTS];
+            Vec3 local_normal;
+        };
+
+        /**
+         * @brief Cached manifolds, encoded by `pair_key`.
+         * @param entries
+         */
+        std::unordered_map<std::uint64_t, Entry> entries;
+
+        /**
+         * @brief Distance beyond which a cached point is dropped: separation along the normal, drift in the tangent plane, and matching radius of new points.
+         * @param breaking_distance
+         */
+        float breaking_distance;
+
+        /**
+         * @brief Support function that encodes the ordered pair (`a`, `b`) into a 64-bit key.
+         */
+        static std::uint64_t pair_key(std::uint32_t a, std::uint32_t b);
+
+    public:
+
+        /**
+         * @name Constructors.
+         * @{
+         */
+
+            /**
+             * @brief Constructor that creates an empty cache. It throws `std::invalid_argument` if `breaking_distance` is not positive.
+             * @param breaking_distance distance beyond which a cached point is dropped (in world units, about 1% of the typical shape size).
+             */
+            explicit ContactCache(float breaking_distance = 0.02f);
+
+        /// @}
+
+        /**
+         * @brief Method that updates the cached manifold of the pair (`a`, `b`) with the current poses of the shapes, dropping the points that are no longer valid. The pair must always be given in the same order (e.g. lower id first, as reported by `SweepAndPrune`).
+         * @param a id of the first shape.
+         * @param b id of the second shape.
+         * @param pose_a pose of the first shape.
+         * @param pose_b pose of the second shape.
+         * @return Returns a boolean value: `true` if the pair has a cached manifold and all of its points are still valid, so that the manifold generation can be skipped.
+         */
+        bool refresh(std::uint32_t a, std::uint32_t b, const Transform& pose_a, const Transform& pose_b);
+
+        /**
+         * @brief Method that merges the freshly generated `manifold` into the cache of the pair (`a`, `b`): each new point replaces the cached point it matches (within the breaking distance) or is added, keeping the deepest point and the largest area when there are more than 4 points. The normal is taken from `manifold`.
+         * @param a id of the first shape.
+         * @param b id of the second shape.
+         * @param manifold generated manifold, with the normal from `a` to `b`.
+         * @param pose_a pose of the first shape.
+         * @param pose_b pose of the second shape.
+         * @return `const ContactManifold&` the merged manifold.
+         */
+        const ContactManifold& merge(std::uint32_t a, std::uint32_t b, const ContactManifold& manifold, const Transform& pose_a, const Transform& pose_b);
+
+        /**
+         * @brief Method that returns the cached manifold of the pair (`a`, `b`), or `nullptr` if there is none. The pointer is invalidated by `merge`, `remove` and `clear`.
+         * @param a id of the first shape.
+         * @param b id of the second shape.
+         * @return `const ContactManifold*` manifold.
+         */
+        const ContactManifold* find(std::uint32_t a, std::uint32_t b) const ;
+
+        /**
+         * @brief Method that removes the cached manifold of the pair (`a`, `b`), e.g. from the pair removed callback of `SweepAndPrune`.
+         * @param a id of the first shape.
+         * @param b id of the second shape.
+         */
+        void remove(std::uint32_t a, std::uint32_t b);
+
+        /**
+         * @brief Method that removes every cached manifold.
+         */
+        void clear();
+
+        /**
+         * @brief Method that returns the number of cached manifolds.
+         * @return `std::size_t` value.
+         */
+        std::size_t size() const ;
+    };
+}
+
+#endif
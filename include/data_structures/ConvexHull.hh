@@ -0,0 +1,143 @@
+#ifndef CONVEX_HULL_HH
+#define CONVEX_HULL_HH
+#include <cstddef>
+#include <vector>
+#include "../Vec3.hh"
+
+namespace Geometry {
+
+    /**
+     * @class ConvexHull.
+     * @brief 3D convex polytope stored as a half-edge mesh, as built by `QuickHull::quick_hull_3D`. Every face is a convex polygon (coplanar triangles are merged) whose half-edges are linked counter-clockwise when seen from outside; every half-edge knows its origin vertex, its twin on the adjacent face, the next half-edge of its face and its face. The adjacency makes `support` a hill climb over the vertices instead of a scan of all of them.
+     * Degenerate inputs give degenerate hulls: coplanar points give a flat hull with two opposite faces sharing the same vertices, collinear points give the two extreme vertices and no faces, coincident points a single vertex.
+     ```
+     // Example:
+     std::vector<Vec3> points = { ... };
+     ConvexHull hull = QuickHull::quick_hull_3D(points.begin(), points.end());
+     for(std::size_t f = 0; f < hull.face_count(); ++f) {
+         std::vector<int> polygon = hull.face_vertices(f); // indices into hull.getVertices()
+     }
+     Vec3 p = hull.support(Vec3(1, 0, 0));
+     ```
+     */
+    class ConvexHull {
+    public:
+
+        /**
+         * @brief Half-edge: directed edge from `origin` to the origin of `next`, on the boundary of `face`.
+         */
+        struct HalfEdge {
+            /// Index of the origin vertex.
+            int origin;
+            /// Index of the opposite half-edge, on the adjacent face.
+            int twin;
+            /// Index of the next half-edge of the face.
+            int next;
+            /// Index of the face.
+            int face;
+        };
+
+        /**
+         * @brief Face: one of its half-edges and its outward plane `normal * x = offset`.
+         */
+        struct Face {
+            /// Index of one half-edge of the face.
+            int edge;
+            /// Outward unit normal.
+            Vec3 normal;
+            /// Plane offset.
+            float offset;
+        };
+
+    private:
+        friend class QuickHull;
+
+        /**
+         * @brief Vertices of the hull.
+         * @param vertices
+         */
+        std::vector<Vec3> vertices;
+
+        /**
+         * @brief Half-edges of the hull.
+         * @param edges
+         */
+        std::vector<HalfEdge> edges;
+
+        /**
+         * @brief Faces of the hull.
+         * @param faces
+         */
+        std::vector<Face> faces;
+
+        /**
+         * @brief One half-edge leaving each vertex (-1 for the vertices of a hull with no faces).
+         * @param vertex_edge
+         */
+        std::vector<int> vertex_edge;
+
+    public:
+
+        /**
+         * @brief Method that returns the vertices of the hull.
+         * @return `const std::vector<Vec3>&` vertices.
+         */
+        const std::vector<Vec3>& getVertices() const ;
+
+        /**
+         * @brief Method that returns the half-edges of the hull.
+         * @return `const std::vector<HalfEdge>&` half-edges.
+         */
+        const std::vector<HalfEdge>& getEdges() const ;
+
+        /**
+         * @brief Method that returns the faces of the hull.
+         * @return `const std::vector<Face>&` faces.
+         */
+        const std::vector<Face>& getFaces() const ;
+
+        /**
+         * @brief Method that returns the number of vertices.
+         * @return `std::size_t` value.
+         */
+        std::size_t vertex_count() const ;
+
+        /**
+         * @brief Method that returns the number of faces.
+         * @return `std::size_t` value.
+         */
+        std::size_t face_count() const ;
+
+        /**
+         * @brief Method that returns the vertex indices of face `face`, counter-clockwise seen from outside. It throws `std::out_of_range` if `face` is not valid.
+         * @param face index of the face.
+         * @return `std::vector<int>` vertex indices.
+         */
+        std::vector<int> face_vertices(std::size_t face) const ;
+
+        /**
+         * @brief Method that returns the index of a vertex farthest along `direction`, found by hill climbing from vertex `start` over the edges of the hull (a local maximum of a linear function on a convex polytope is a global one). It throws `std::out_of_range` if the hull is empty or `start` is not a valid vertex.
+         * @param direction search direction.
+         * @param start starting vertex, e.g. the result of the previous query for temporal coherence.
+         * @return `int` vertex index.
+         */
+        int support_index(const Vec3& direction, int start = 0) const ;
+
+        /**
+         * @brief Method that returns a vertex farthest along `direction`. It throws `std::out_of_range` if the hull is empty.
+         * @param direction search direction.
+         * @return `Vec3` object.
+         */
+        Vec3 support(const Vec3& direction) const ;
+
+        /**
+         * @brief Method that returns `true` if `p` is inside the hull or within `tolerance` of its boundary. A hull with no faces contains nothing.
+         * @param p point.
+         * @param tolerance distance tolerance.
+         * @return Returns a boolean value.
+         */
+        bool contains(const Vec3& p, float tolerance = 0.0f) const ;
+    };
+}
+
+#endif
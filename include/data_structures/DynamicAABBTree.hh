@@ -0,0 +1,339 @@
+#ifndef DYNAMIC_AABB_TREE_HH
+#define DYNAMIC_AABB_TREE_HH
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+#include "AABB.hh"
+#include "../Ray.hh"
+#include "../RayPacket.hh"
+
+namespace Geometry {
+
+    /**
+     * @class DynamicAABBTree.
+     * @brief Dynamic bounding volume hierarchy of `AABB` proxies. Every leaf stores a "fat" `AABB`, the proxy's box padded by a margin, so that small movements do not restructure the tree. Internal nodes are chosen with a surface area heuristic and kept balanced with AVL-like tree rotations, and all nodes live in one pooled array recycled through a free list. Overlap queries against a box or against another tree run in O(log n) per reported proxy.
+     ```
+     // Example:
+     DynamicAABBTree tree(0.1f);
+     int a = tree.insert(AABB(Point3D(0,0,0), 1, 1, 1));
+     int b = tree.insert(AABB(Point3D(5,0,0), 1, 1, 1));
+     tree.move(b, AABB(Point3D(5.05,0,0), 1, 1, 1)); // still inside its fat box: no restructuring
+     tree.query(AABB(Point3D(1,0,0), 0.5, 0.5, 0.5), [](int proxy) {
+         std::cout << proxy; // prints 0
+         return true;        // keep searching
+     });
+     ```
+     */
+    class DynamicAABBTree {
+    public:
+
+        /**
+         * @brief Index used for "no node".
+         */
+        static const int NULL_NODE = -1;
+
+    private:
+
+        /**
+         * @brief Node of the tree. Leaves have `left == NULL_NODE`; free nodes use `parent` as link of the free list.
+         */
+        struct Node {
+            AABB box;
+            int parent;
+            int left;
+            int right;
+            int height;
+
+            bool is_leaf() const { return left == NULL_NODE; }
+        };
+
+        /**
+         * @brief Pooled node array.
+         * @param nodes
+         */
+        std::vector<Node> nodes;
+
+        /**
+         * @brief Index of the root node.
+         * @param root
+         */
+        int root;
+
+        /**
+         * @brief Head of the list of free nodes.
+         * @param free_list
+         */
+        int free_list;
+
+        /**
+         * @brief Number of proxies (leaves) in the tree.
+         * @param proxy_count
+         */
+        std::size_t proxy_count;
+
+        /**
+         * @brief Padding added on each side of a proxy's box to build its fat `AABB`.
+         * @param margin
+         */
+        float margin;
+
+        /**
+         * @brief Maximum depth of the explicit traversal stacks. AVL balancing keeps the height below 1.44 log2(n), so this is never reached in practice.
+         */
+        static const int STACK_SIZE = 256;
+
+        /**
+         * @brief Support method that takes a node from the pool, growing it when the free list is empty.
+         * @return `int` index of the node.
+         */
+        int allocate_node();
+
+        /**
+         * @brief Support method that returns `node` to the pool.
+         * @param node index of the node.
+         */
+        void free_node(int node);
+
+        /**
+         * @brief Support method that inserts `leaf` in the tree, choosing its sibling with the surface area heuristic.
+         * @param leaf index of the leaf.
+         */
+        void insert_leaf(int leaf);
+
+        /**
+         * @brief Support method that detaches `leaf` from the tree without freeing it.
+         * @param leaf index of the leaf.
+         */
+        void remove_leaf(int leaf);
+
+        /**
+         * @brief Support method that performs a left or right rotation if the subtree rooted at `node` is imbalanced. It returns the index of the new subtree root.
+         * @param node index of the node.
+         * @return `int` index of the new root of the subtree.
+         */
+        int balance(int node);
+
+        /**
+         * @brief Support method that refits boxes and heights from `node` up to the root, balancing on the way.
+         * @param node index of the first node to refit.
+         */
+        void refit(int node);
+
+        /**
+         * @brief Support method that returns the fat `AABB` of `box`.
+         * @param box tight `AABB`.
+         * @return `AABB` object.
+         */
+        AABB fatten(const AABB& box) const ;
+
+        /**
+         * @brief Support method that throws `std::out_of_range` if `proxy` is not a leaf of the tree.
+         * @param proxy proxy id.
+         */
+        void check_proxy(int proxy) const ;
+
+    public:
+
+        /**
+         * @name Constructors.
+         * @{
+         */
+
+            /**
+             * @brief Constructor that creates an empty tree. It accepts 0 or 1 arguments: the margin used to fatten the leaves.
+             * @param margin padding added on each side of every proxy.
+             */
+            DynamicAABBTree(float margin = 0.1f);
+
+        /// @}
+
+        /**
+         * @brief Method that inserts a new proxy with bounds `box` and returns its id.
+         * @param box `AABB` object.
+         * @return `int` proxy id.
+         */
+        int insert(const AABB& box);
+
+        /**
+         * @brief Method that removes the proxy `proxy`. It throws `std::out_of_range` if `proxy` is not valid.
+         * @param proxy proxy id.
+         */
+        void remove(int proxy);
+
+        /**
+         * @brief Method that moves the proxy `proxy` to `box`. If the new box is still inside the fat `AABB` of the leaf nothing changes and it returns `false`; otherwise the leaf is reinserted and it returns `true`. The optional `displacement` (expected movement for the next frame) extends the new fat `AABB` along the motion. It throws `std::out_of_range` if `proxy` is not valid.
+         * @param proxy proxy id.
+         * @param box `AABB` object.
+         * @param displacement expected displacement.
+         * @return Returns a boolean value.
+         */
+        bool move(int proxy, const AABB& box, const Point3D& displacement = {});
+
+        /**
+         * @brief Method that returns the fat `AABB` stored for `proxy`. It throws `std::out_of_range` if `proxy` is not valid.
+         * @param proxy proxy id.
+         * @return `const AABB&` fat box.
+         */
+        const AABB& get_fat_AABB(int proxy) const ;
+
+        /**
+         * @brief Method that returns the number of proxies.
+         * @return `std::size_t` value.
+         */
+        std::size_t size() const ;
+
+        /**
+         * @brief Method that returns the height of the tree (0 for a single leaf, -1 when empty).
+         * @return `int` value.
+         */
+        int height() const ;
+
+        /**
+         * @brief Method that calls `callback(proxy)` for every proxy whose fat `AABB` overlaps `box`. The search stops early when the callback returns `false`.
+         * @tparam `Callback` callable as `bool(int)`.
+         * @param box `AABB` object.
+         * @param callback function called for every overlapping proxy.
+         */
+        template <typename Callback>
+        inline void query(const AABB& box, Callback callback) const {
+            if(this->root == NULL_NODE)
+                return;
+            int stack[STACK_SIZE];
+            int top = 0;
+            stack[top++] = this->root;
+            while(top > 0) {
+                int index = stack[--top];
+                const Node& node = this->nodes[index];
+                if(!node.box.test_AABB_AABB_intersection(box))
+                    continue;
+                if(node.is_leaf()) {
+                    if(!callback(index))
+                        return;
+                } else {
+                    if(top + 2 > STACK_SIZE)
+                        throw std::length_error("DynamicAABBTree traversal stack overflow");
+                    stack[top++] = node.left;
+                    stack[top++] = node.right;
+                }
+            }
+        }
+
+        /**
+         * @brief Method that casts `ray` through the tree and calls `callback(proxy, ray)` for every proxy whose fat `AABB` is hit, where `ray` is the input ray clipped at the nearest hit reported so far. The callback tests the proxy's own shape and returns the new maximum distance: the distance of its hit to clip the ray, `ray.getMaxDistance()` to ignore the proxy, or 0 to stop the search.
+         * @tparam `Callback` callable as `float(int, const Ray&)`.
+         * @param ray `Ray` object.
+         * @param callback function called for every proxy hit by the ray.
+         */
+        template <typename Callback>
+        inline void raycast(const Ray& ray, Callback callback) const {
+            if(this->root == NULL_NODE)
+                return;
+            Ray clipped(ray);
+            int stack[STACK_SIZE];
+            int top = 0;
+            stack[top++] = this->root;
+            while(top > 0) {
+                int index = stack[--top];
+                const Node& node = this->nodes[index];
+                RayHit hit;
+                if(!clipped.intersect(node.box, hit))
+                    continue;
+                if(node.is_leaf()) {
+                    float value = callback(index, static_cast<const Ray&>(clipped));
+                    if(value <= 0.0f)
+                        return;
+                    if(value < clipped.getMaxDistance())
+                        clipped.setMaxDistance(value);
+                } else {
+                    if(top + 2 > STACK_SIZE)
+                        throw std::length_error("DynamicAABBTree traversal stack overflow");
+                    stack[top++] = node.left;
+                    stack[top++] = node.right;
+                }
+            }
+        }
+
+        /**
+         * @brief Method that casts a whole packet through the tree: a node is visited if at least one ray of the packet hits its fat `AABB`, so coherent packets share most of the traversal. `callback(proxy, mask)` is called for every leaf hit, with the bitmask of the lanes that hit it. The search stops early when the callback returns `false`.
+         * @tparam `Callback` callable as `bool(int, std::uint32_t)`.
+         * @param packet `RayPacket` object.
+         * @param callback function called for every proxy hit by the packet.
+         */
+        template <typename Callback>
+        inline void raycast(const RayPacket& packet, Callback callback) const {
+            if(this->root == NULL_NODE)
+                return;
+            int stack[STACK_SIZE];
+            int top = 0;
+            stack[top++] = this->root;
+            while(top > 0) {
+                int index = stack[--top];
+                const Node& node = this->nodes[index];
+                std::uint32_t mask = packet.intersect(node.box);
+                if(mask == 0)
+                    continue;
+                if(node.is_leaf()) {
+                    if(!callback(index, mask))
+                        return;
+                } else {
+                    if(top + 2 > STACK_SIZE)
+                        throw std::length_error("DynamicAABBTree traversal stack overflow");
+                    stack[top++] = node.left;
+                    stack[top++] = node.right;
+                }
+            }
+        }
+
+        /**
+         * @brief Method that calls `callback(a, b)` for every pair of proxies, `a` from `this` tree and `b` from `other`, whose fat `AABB` overlap. Both trees are descended simultaneously. When `other` is `this` tree, every overlapping pair of distinct proxies is reported once. The search stops early when the callback returns `false`.
+         * @tparam `Callback` callable as `bool(int, int)`.
+         * @param other `DynamicAABBTree` object.
+         * @param callback function called for every overlapping pair.
+         */
+        template <typename Callback>
+        inline void query(const DynamicAABBTree& other, Callback callback) const {
+            if(this->root == NULL_NODE || other.root == NULL_NODE)
+                return;
+            const bool self = (&other == this);
+            int stack[2 * STACK_SIZE];
+            int top = 0;
+            stack[top++] = this->root;
+            stack[top++] = other.root;
+            while(top > 0) {
+                int ib = stack[--top];
+                int ia = stack[--top];
+                const Node& a = this->nodes[ia];
+                const Node& b = other.nodes[ib];
+                if(top + 6 > 2 * STACK_SIZE)
+                    throw std::length_error("DynamicAABBTree traversal stack overflow");
+
+                // Self query: a node against itself only pairs up its two subtrees
+                if(self && ia == ib) {
+                    if(!a.is_leaf()) {
+                        stack[top++] = a.left;  stack[top++] = a.left;
+                        stack[top++] = a.right; stack[top++] = a.right;
+                        stack[top++] = a.left;  stack[top++] = a.right;
+                    }
+                    continue;
+                }
+                if(!a.box.test_AABB_AABB_intersection(b.box))
+                    continue;
+
+                if(a.is_leaf() && b.is_leaf()) {
+                    if(!callback(ia, ib))
+                        return;
+                } else if(b.is_leaf() || (!a.is_leaf() && a.box.surface_area() >= b.box.surface_area())) {
+                    // Descend the larger volume first
+                    stack[top++] = a.left;  stack[top++] = ib;
+                    stack[top++] = a.right; stack[top++] = ib;
+                } else {
+                    stack[top++] = ia; stack[top++] = b.left;
+                    stack[top++] = ia; stack[top++] = b.right;
+                }
+            }
+        }
+    };
+}
+
+#endif
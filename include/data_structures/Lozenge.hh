@@ -59,6 +59,32 @@ namespace Geometry {
             Lozenge(Point3D c = {}, Point3D e0 = {}, Point3D e1 = {}, float r = 1);
 
         /// @}
+
+        /**
+         * @name Getters
+         * @{
+         */
+
+            /**
+             * @brief Method that returns the origin of the rectangle.
+             * @return `Point3D` object.
+             */
+            Point3D getCenter() const ;
+
+            /**
+             * @brief Method that returns the edge `index` (0 or 1) of the rectangle. It throws `std::out_of_range` if `index` is not valid.
+             * @param index index of the edge.
+             * @return `Point3D` object.
+             */
+            Point3D getEdge(int index) const ;
+
+            /**
+             * @brief Method that returns the radius.
+             * @return `float` value.
+             */
+            float getRadius() const ;
+
+        /// @}
     };
 }
 
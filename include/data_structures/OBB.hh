@@ -1,7 +1,15 @@
 #ifndef ORIENTED_BOUNDING_BOX_HH
 #define ORIENTED_BOUNDING_BOX_HH
 #include "../Point3D.hh"
+#include "../Vec3.hh"
+#include "../Mat3.hh"
+#include "../Moments.hh"
 #include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <vector>
 
 /*
     OBB (Oriented Bounding Box), is a fitting-figure box that allows you to optimize collisions by eliminating impossible ones and    testing only those whose OBB of the figures are intersected. The differences between AABB and OBB are that OBBs are oriented dipending
@@ -9,6 +17,41 @@
 */
 namespace Geometry {
 
+    /**
+     * @class SeparatingAxisCache.
+     * @brief One-byte record of the separating axis found by the last `OBB`-`OBB` test of a pair, to be kept with the pair across frames. Axes 0-2 are the axes of the first box, 3-5 the axes of the second box and 6-14 the cross products A[i] x B[j] (index `6 + 3 * i + j`), in the order of the separating axis test. A default-constructed cache holds no axis.
+     */
+    class SeparatingAxisCache {
+    private:
+        friend class OBB;
+
+        /**
+         * @brief Index of the last separating axis, or `NONE`.
+         * @param axis
+         */
+        std::uint8_t axis;
+
+    public:
+
+        /**
+         * @brief Value of an empty cache: the pair was intersecting (or never tested).
+         */
+        static const std::uint8_t NONE = 0xFF;
+
+        SeparatingAxisCache() : axis(NONE) {}
+
+        /**
+         * @brief Method that empties the cache.
+         */
+        void reset() { this->axis = NONE; }
+
+        /**
+         * @brief Method that returns the index of the cached separating axis, or `NONE`.
+         * @return `std::uint8_t` value.
+         */
+        std::uint8_t getAxis() const { return this->axis; }
+    };
+
     /**
      * @class OBB.
      * @brief Oriented Bounding Box (OBB), is a fitting-figure box that allows you to optimize collisions by eliminating impossible ones and testing only those whose OBB of the figures are intersected. The differences between AABB and OBB are that OBBs are oriented dipending on the object they are refered to, while AABB are oriented always by the axes. Its region is:
@@ -37,6 +80,48 @@ namespace Geometry {
          */
         Point3D halfwidth;
 
+        /**
+         * @brief Support method that sets the box to the one with axes `axes` (orthonormal) that bounds the points of [`begin`, `end`), with the center and halfwidths of their extents along the axes.
+         * @tparam `Iterator` Type that represent the Iterators of a container of `Point3D` or `Vec3` objects.
+         * @param begin starting iterator.
+         * @param end ending iterator.
+         * @param axes local axes.
+         * @return `float` value: the volume of the box.
+         */
+        template <typename Iterator>
+        inline float fit_to_axes(Iterator begin, Iterator end, const Vec3 axes[3]) {
+            float lo[3], hi[3];
+            for(int i = 0; i < 3; ++i) {
+                lo[i] = std::numeric_limits<float>::max();
+                hi[i] = -std::numeric_limits<float>::max();
+            }
+            for(; begin != end; ++begin) {
+                Vec3 p(begin->getX(), begin->getY(), begin->getZ());
+                for(int i = 0; i < 3; ++i) {
+                    float d = p * axes[i];
+                    lo[i] = d < lo[i] ? d : lo[i];
+                    hi[i] = d > hi[i] ? d : hi[i];
+                }
+            }
+            if(lo[0] > hi[0]) { // Empty range
+                for(int i = 0; i < 3; ++i)
+                    lo[i] = hi[i] = 0.0f;
+            }
+            Vec3 c = axes[0] * ((lo[0] + hi[0]) * 0.5f) + axes[1] * ((lo[1] + hi[1]) * 0.5f) + axes[2] * ((lo[2] + hi[2]) * 0.5f);
+            this->center = c.toPoint3D();
+            for(int i = 0; i < 3; ++i)
+                this->local_axes[i] = axes[i].toPoint3D();
+            this->halfwidth = Point3D((hi[0] - lo[0]) * 0.5f, (hi[1] - lo[1]) * 0.5f, (hi[2] - lo[2]) * 0.5f);
+            return (hi[0] - lo[0]) * (hi[1] - lo[1]) * (hi[2] - lo[2]);
+        }
+
+        /**
+         * @brief Support method for `min_volume_OBB`.
+         * @param points input points.
+         * @param max_faces maximum number of hull faces tried (0 for no limit).
+         */
+        void min_volume(const std::vector<Vec3>& points, std::size_t max_faces);
+
     public:
         /**
          * @name Constructors.
@@ -69,12 +154,105 @@ namespace Geometry {
 
         /// @}
 
+        /**
+         * @name Getters and Setters
+         * @{
+         */
+
+            /**
+             * @brief Method that returns a `Point3D` object: the center of the `OBB`.
+             * @return `Point3D` object.
+             */
+            Point3D getCenter() const ;
+
+            /**
+             * @brief Method that returns a `Point3D` object: the local axis `index` (0 for x, 1 for y, 2 for z). It throws `std::out_of_range` if `index` is not valid.
+             * @param index `int` value.
+             * @return `Point3D` object.
+             */
+            Point3D getAxis(int index) const ;
+
+            /**
+             * @brief Method that returns a `Point3D` object: the positive halfwidth extents along each local axis.
+             * @return `Point3D` object.
+             */
+            Point3D getHalfwidth() const ;
+
+        /// @}
+
+        /**
+         * @brief Method that fits the box to the points of [`begin`, `end`) with principal component analysis: the axes are the eigenvectors of the covariance matrix of the points (accumulated with `Moments` and decomposed with `Mat3::symmetric_eigen`), in order of decreasing spread, and the box is sized on the extents of the points along them. It takes linear time; the box is tight for elongated point sets but may be far from the minimum for evenly spread ones or uneven sampling. An empty range gives an empty box at the origin.
+         * @tparam `Iterator` Type that represent the Iterators of a container of `Point3D` or `Vec3` objects.
+         * @param begin starting iterator.
+         * @param end ending iterator.
+         * @return none.
+         */
+        template <typename Iterator>
+        inline void eigen_OBB(Iterator begin, Iterator end) {
+            Vec3 values;
+            Mat3 vectors;
+            Moments(begin, end).covariance().symmetric_eigen(values, vectors);
+            Vec3 axes[3];
+            for(int i = 0; i < 3; ++i)
+                axes[i] = Vec3(vectors(0, i), vectors(1, i), vectors(2, i));
+            this->fit_to_axes(begin, end, axes);
+        }
+
+        /**
+         * @brief Method that fits a box of small volume to the points of [`begin`, `end`) from their convex hull (`QuickHull::quick_hull_3D`). Every candidate direction is taken as one axis of the box; the hull is projected onto the plane orthogonal to it and the minimum area rectangle of the projection, found with rotating calipers (`GeometryUtils::min_area_rectangle_of_points`), gives the two other axes. The candidates are the principal axes of the hull vertices and the normals of the `max_faces` largest hull faces (all of them if 0): with all the faces, the box is the minimum volume box among those flush with a hull face, which is the exact minimum for most inputs (O'Rourke's exact algorithm also considers boxes touching edges only). `max_faces` is the quality/speed knob: each face costs O(h log h) on a hull of h vertices, on top of the O(n log n) hull, so trying all the faces is quadratic in the hull size; on typical inputs the largest 32 faces already give the best box. An empty range gives an empty box at the origin.
+         * @tparam `Iterator` Type that represent the Iterators of a container of `Point3D` or `Vec3` objects.
+         * @param begin starting iterator.
+         * @param end ending iterator.
+         * @param max_faces maximum number of hull faces tried (0 for no limit).
+         * @return none.
+         */
+        template <typename Iterator>
+        inline void min_volume_OBB(Iterator begin, Iterator end, std::size_t max_faces = 32) {
+            std::vector<Vec3> points;
+            for(; begin != end; ++begin)
+                points.push_back(Vec3(begin->getX(), begin->getY(), begin->getZ()));
+            this->min_volume(points, max_faces);
+        }
+
         /**
          * @brief Test that evaluates the instersaction between two `OBB`. It returns a boolean value: `true` if the two `OBB` are intersecting and `false` otherwise. It is possible to show that at most 15 of these separating axes must be tested to correctly determine the OBB overlap status. These axes correspond to the three coordinate axes of A, the three coordinate axes of B, and the nine axes perpendicular to an axis from each. If the boxes fail to overlap on any of the 15 axes, they are not intersecting. If no axis provides this early out, it follows that the boxes must be overlapping.
          * @param other `OBB` object.
          * @return Returns a boolean value.
          */
         bool test_OBB_OBB_intersection(const OBB& other) const ;
+
+        /**
+         * @brief `Vec3` overload of the `OBB`-`OBB` test on raw box data: center `ca`, local axes `ua` and halfwidth `ea` of the first box, `cb`, `ub` and `eb` of the second one. It returns `true` if the two boxes are intersecting and `false` otherwise.
+         * @param ca center of the first box.
+         * @param ua local axes of the first box.
+         * @param ea halfwidth of the first box.
+         * @param cb center of the second box.
+         * @param ub local axes of the second box.
+         * @param eb halfwidth of the second box.
+         * @return Returns a boolean value.
+         */
+        static bool test_OBB_OBB_intersection(const Vec3& ca, const Vec3 ua[3], const Vec3& ea, const Vec3& cb, const Vec3 ub[3], const Vec3& eb);
+
+        /**
+         * @brief Temporally coherent variant of the `OBB`-`OBB` test: the axis stored in `cache` is tested first, so a pair that stays separated by the same axis costs a single axis test. The other axes are then tested in the usual order and the separating one, if any, is stored back into `cache`.
+         * @param other `OBB` object.
+         * @param cache separating axis record of the pair, updated on return.
+         * @return Returns a boolean value.
+         */
+        bool test_OBB_OBB_intersection(const OBB& other, SeparatingAxisCache& cache) const ;
+
+        /**
+         * @brief `Vec3` overload of the temporally coherent `OBB`-`OBB` test on raw box data.
+         * @param ca center of the first box.
+         * @param ua local axes of the first box.
+         * @param ea halfwidth of the first box.
+         * @param cb center of the second box.
+         * @param ub local axes of the second box.
+         * @param eb halfwidth of the second box.
+         * @param cache separating axis record of the pair, updated on return.
+         * @return Returns a boolean value.
+         */
+        static bool test_OBB_OBB_intersection(const Vec3& ca, const Vec3 ua[3], const Vec3& ea, const Vec3& cb, const Vec3 ub[3], const Vec3& eb, SeparatingAxisCache& cache);
     };
 }
 
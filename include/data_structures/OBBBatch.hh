@@ -0,0 +1,151 @@
+#ifndef OBB_BATCH_HH
+#define OBB_BATCH_HH
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "OBB.hh"
+#include "../AlignedAllocator.hh"
+#include "../Transform.hh"
+
+namespace Geometry {
+
+    /**
+     * @class OBBBatch.
+     * @brief Structure-of-arrays (SoA) store of `OBB` objects (center, three local axes and halfwidth, one aligned `float` array per component) with a batched separating-axis kernel. Candidate pairs coming from a broadphase are confirmed `OBBBatch::LANES` pairs at a time: all the 15 axes of `OBB::test_OBB_OBB_intersection` are evaluated without branches for every lane, with the same arithmetic, so the results match the scalar test on non-degenerate inputs.
+     ```
+     // Example:
+     OBBBatch batch;
+     batch.add(OBB(Point3D(0,0,0), Point3D(1,0,0), Point3D(0,1,0), Point3D(0,0,1)));
+     batch.add(OBB(Point3D(1.5,0,0), Point3D(1,0,0), Point3D(0,1,0), Point3D(0,0,1)));
+     std::uint32_t a[] = {0}, b[] = {1}, out_a[1], out_b[1];
+     std::size_t n = batch.filter_pairs(a, b, 1, out_a, out_b); // n = 1
+     ```
+     */
+    class OBBBatch {
+    public:
+
+        /**
+         * @brief Number of pairs evaluated by one block of the kernel (one AVX register of `float`).
+         */
+        static const std::size_t LANES = 8;
+
+        /**
+         * @brief `std::vector` of `float` aligned for SIMD loads.
+         */
+        using FloatArray = std::vector<float, AlignedAllocator<float, 32>>;
+
+    private:
+
+        /**
+         * @brief Coordinates of the centers, one array per axis.
+         * @param center
+         */
+        FloatArray center[3];
+
+        /**
+         * @brief Local axes: `axis[i][k]` is the k-th coordinate of the i-th local axis.
+         * @param axis
+         */
+        FloatArray axis[3][3];
+
+        /**
+         * @brief Halfwidth extents along the local axes.
+         * @param halfwidth
+         */
+        FloatArray halfwidth[3];
+
+        /**
+         * @brief Support method that tests the `count` (at most `LANES`) pairs (`a[l]`, `b[l]`) and returns a bitmask of the intersecting ones.
+         * @return `std::uint32_t` bitmask: bit `l` is set if pair `l` intersects.
+         */
+        std::uint32_t test_block(const std::uint32_t* a, const std::uint32_t* b, std::size_t count) const ;
+
+    public:
+
+        /**
+         * @name Constructors.
+         * @{
+         */
+
+            /**
+             * @brief Default constructor that creates an empty batch.
+             */
+            OBBBatch();
+
+            /**
+             * @brief Constructor that fills the batch with the `OBB` objects of the range [`begin`, `end`).
+             * @tparam `Iterator` Type that represent the Iterators of a container which supports them.
+             * @param begin starting iterator.
+             * @param end ending iterator.
+             */
+            template <typename Iterator>
+            OBBBatch(Iterator begin, Iterator end) {
+                for(; begin != end; ++begin)
+                    this->add(*begin);
+            }
+
+        /// @}
+
+        /**
+         * @brief Method that appends an `OBB` to the batch. It returns the index of the stored box.
+         * @param box `OBB` object.
+         * @return `std::size_t` index of the box.
+         */
+        std::size_t add(const OBB& box);
+
+        /**
+         * @brief Method that overwrites the box stored at `index`. It throws `std::out_of_range` if `index` is not valid.
+         * @param index index of the box.
+         * @param box `OBB` object.
+         */
+        void set(std::size_t index, const OBB& box);
+
+        /**
+         * @brief Method that returns the box stored at `index` as an `OBB` object. It throws `std::out_of_range` if `index` is not valid.
+         * @param index index of the box.
+         * @return `OBB` object.
+         */
+        OBB get(std::size_t index) const ;
+
+        /**
+         * @brief Method that removes all the boxes.
+         */
+        void clear();
+
+        /**
+         * @brief Method that returns the number of stored boxes.
+         * @return `std::size_t` value.
+         */
+        std::size_t size() const ;
+
+        /**
+         * @brief Tests the `n` pairs (`a[k]`, `b[k]`) and writes the result as a bitmask: bit `k % 32` of `mask[k / 32]` is set if pair `k` intersects. `mask` must have room for (n + 31) / 32 words.
+         * @param a indices of the first boxes.
+         * @param b indices of the second boxes.
+         * @param n number of pairs.
+         * @param mask caller-supplied bitmask buffer.
+         * @return `std::size_t` number of intersecting pairs.
+         */
+        std::size_t test_pairs(const std::uint32_t* a, const std::uint32_t* b, std::size_t n, std::uint32_t* mask) const ;
+
+        /**
+         * @brief Tests the `n` pairs (`a[k]`, `b[k]`) and writes the intersecting ones, in input order, into `out_a` and `out_b`, which must have room for `n` indices. The output buffers may alias the input ones.
+         * @param a indices of the first boxes.
+         * @param b indices of the second boxes.
+         * @param n number of pairs.
+         * @param out_a caller-supplied buffer of first indices.
+         * @param out_b caller-supplied buffer of second indices.
+         * @return `std::size_t` number of intersecting pairs.
+         */
+        std::size_t filter_pairs(const std::uint32_t* a, const std::uint32_t* b, std::size_t n, std::uint32_t* out_a, std::uint32_t* out_b) const ;
+
+        /**
+         * @brief Method that writes into `out` the boxes of the batch moved by the rigid transforms `transforms`, one per box (`size()` entries): the center is transformed, the local axes are rotated and the halfwidths are kept. The boxes are moved `LANES` at a time: a block is computed into local lane arrays by a branch-free loop that the compiler vectorizes (the lane arrays cannot alias the batch, so no run-time alias checks are needed) and then copied out, so a whole population of local bounds is moved to world space in one pass. `out` is resized to the batch, reusing its storage; it throws `std::invalid_argument` if `out` is the batch itself.
+         * @param transforms rigid transforms.
+         * @param out `OBBBatch` object.
+         */
+        void transform(const Transform* transforms, OBBBatch& out) const ;
+    };
+}
+
+#endif
@@ -2,9 +2,14 @@
 #define SPHERE_HH
 #include <iterator>
 #include <cmath>
+#include <vector>
 #include "../Point3D.hh"
+#include "../Vec3.hh"
+#include "../Mat3.hh"
+#include "../Moments.hh"
 #include "../include/Matrix.hh"
 #include "../include/GeometricUtils.hh"
+#include "../include/ThreadPool.hh"
 
 namespace Geometry {
     // Region R = {(x, y, y) | (x - c.x)^2 + (y - c.y)^2 + (z - c.z)^2 <= r^2}
@@ -32,21 +37,60 @@ namespace Geometry {
          */
         float radius;
 
-    public:
+        /**
+         * @brief Support method for `welzl_sphere`: sets the sphere to the minimum sphere enclosing `points`, which are shuffled and reordered.
+         * @param points input points.
+         */
+        void minimum_sphere(std::vector<Vec3>& points);
 
         /**
-         * @brief Support method for computing intersections.
-         * @tparam `Iterator` Type that represent the Iterators of a container which supports them.
+         * @brief Support method for the parallel Ritter spheres: grows the sphere to include the points [`begin`, `end`). The sphere only grows, so the points well inside the starting sphere can never change it: they are filtered out on `pool`, in blocks of `grain` points, and only the remaining ones are visited in order, which gives the same sphere of the sequential pass.
+         * @tparam `RandomIt` random access iterator of a container of `Point3D` objects.
          * @param begin starting iterator.
          * @param end ending iterator.
-         * @return none. 
+         * @param pool `ThreadPool` that runs the tasks.
+         * @param grain number of points per task.
+         * @return none.
          */
-        template <typename Iterator>
-        inline void sphere_from_distant_points(Iterator begin, Iterator end) {
+        template <typename RandomIt>
+        inline void grow_sphere(RandomIt begin, RandomIt end, ThreadPool& pool, std::size_t grain) {
+            std::size_t count = std::distance(begin, end);
+            if(grain == 0)
+                grain = 1;
+            if(pool.size() < 2 || count < 2 * grain) {
+                for(; begin != end; ++begin)
+                    this->update_sphere_with_outer_point(*begin);
+                return;
+            }
 
-            // Find the most separeted point pair defining the encompassing AABB
-            std::pair<Iterator, Iterator> min_max = GeometryUtils::most_separated_points_on_AABB(begin, end);
+            // Margin for the rounding of the grown spheres, which contain the starting one only up to it
+            const float cx = this->center.getX(), cy = this->center.getY(), cz = this->center.getZ();
+            const float inner2 = this->radius * this->radius * 0.9999f;
+            std::size_t blocks = (count + grain - 1) / grain;
+            std::vector<std::vector<std::size_t>> outside(blocks);
+            pool.parallel_for(blocks, [&](std::size_t block, std::size_t) {
+                std::size_t last = std::min(count, (block + 1) * grain);
+                for(std::size_t i = block * grain; i < last; ++i) {
+                    const auto& p = begin[i];
+                    float dx = p.getX() - cx, dy = p.getY() - cy, dz = p.getZ() - cz;
+                    if(dx * dx + dy * dy + dz * dz > inner2)
+                        outside[block].push_back(i);
+                }
+            });
+            for(const std::vector<std::size_t>& indices : outside)
+                for(std::size_t i : indices)
+                    this->update_sphere_with_outer_point(begin[i]);
+        }
 
+        /**
+         * @brief Support method for `sphere_from_distant_points`: sets the sphere to the one with diameter `min_max`, or to an empty sphere if the range was empty.
+         * @tparam `Iterator` Type that represent the Iterators of a container which supports them.
+         * @param min_max iterators of the two points.
+         * @param end ending iterator.
+         * @return none.
+         */
+        template <typename Iterator>
+        inline void sphere_from_pair(const std::pair<Iterator, Iterator>& min_max, Iterator end) {
             auto it_min = min_max.first;
             auto it_max = min_max.second;
 
@@ -62,6 +106,38 @@ namespace Geometry {
             }
         }
 
+    public:
+
+        /**
+         * @brief Support method for computing intersections.
+         * @tparam `Iterator` Type that represent the Iterators of a container which supports them.
+         * @param begin starting iterator.
+         * @param end ending iterator.
+         * @return none. 
+         */
+        template <typename Iterator>
+        inline void sphere_from_distant_points(Iterator begin, Iterator end) {
+
+            // Find the most separeted point pair defining the encompassing AABB
+            std::pair<Iterator, Iterator> min_max = GeometryUtils::most_separated_points_on_AABB(begin, end);
+            this->sphere_from_pair(min_max, end);
+        }
+
+        /**
+         * @brief Parallel overload of `sphere_from_distant_points`: the extreme points are found with the parallel `GeometryUtils::most_separated_points_on_AABB`, so the sphere is the same of the serial method.
+         * @tparam `RandomIt` random access iterator of a container of `Point3D` objects.
+         * @param begin starting iterator.
+         * @param end ending iterator.
+         * @param pool `ThreadPool` that runs the tasks.
+         * @param grain number of points per task.
+         * @return none.
+         */
+        template <typename RandomIt>
+        inline void sphere_from_distant_points(RandomIt begin, RandomIt end, ThreadPool& pool, std::size_t grain = 65536) {
+            std::pair<RandomIt, RandomIt> min_max = GeometryUtils::most_separated_points_on_AABB(begin, end, pool, grain);
+            this->sphere_from_pair(min_max, end);
+        }
+
         /**
          * @brief Support method that update the perimeter of the sphere with an outer point: given sphere `this` and point `p`, update `this` to just encompass `p`.
          * @param point Point which update the sphere's perimeter
@@ -80,24 +156,13 @@ namespace Geometry {
          */
         template <typename Iterator>
         inline void eigen_sphere(Iterator begin, Iterator end) {
-            Matrix m, v;
-
-            // Compute the covariance matrix m
-            m.covariance_matrix(begin, end);
-            // Decompose it into eigenvectors (in v) and eigenvalues (in m)
-            Matrix::jacobi(m, v);
-
-            // Find the component with largest magnitude eigenvalue (largest spread)
-            Point3D e;
-            int maxc = 0;
-            float maxf, maxe = abs(m[0][0]);
-            if((maxf = abs(m[1][1])) > maxe) 
-                maxc = 1, maxe = maxf;
-            if((maxf = abs(m[2][2])) > maxe)
-                maxc = 2, maxe = maxf;
-            e[0] = v[0][maxc];
-            e[1] = v[1][maxc];
-            e[2] = v[2][maxc];
+            // Compute the covariance matrix and decompose it into eigenvectors and eigenvalues
+            Vec3 values;
+            Mat3 vectors;
+            Mat3::covariance(begin, end).symmetric_eigen(values, vectors);
+
+            // The eigenvalues are sorted: the first eigenvector is the direction of largest spread
+            Point3D e(vectors(0, 0), vectors(1, 0), vectors(2, 0));
 
             // Find the most extreme points along direction 'e'
             auto min_max = GeometryUtils::extreme_points_along_direction(e, begin, end);
@@ -107,6 +172,30 @@ namespace Geometry {
             this->radius = dist * 0.5f;
             this->center = (minpt + maxpt) * 0.5f;
         }
+
+        /**
+         * @brief Parallel overload of `eigen_sphere`: the covariance is accumulated with the parallel `Moments::of` and the extreme points along the principal direction are found with the parallel `GeometryUtils::extreme_points_along_direction`. The covariance is computed in double precision, so the principal direction may differ from the serial method by rounding.
+         * @tparam `RandomIt` random access iterator of a container of `Point3D` objects.
+         * @param begin starting iterator.
+         * @param end ending iterator.
+         * @param pool `ThreadPool` that runs the tasks.
+         * @param grain number of points per task.
+         * @return none.
+         */
+        template <typename RandomIt>
+        inline void eigen_sphere(RandomIt begin, RandomIt end, ThreadPool& pool, std::size_t grain = 65536) {
+            Vec3 values;
+            Mat3 vectors;
+            Moments::of(begin, end, pool, grain).covariance().symmetric_eigen(values, vectors);
+            Point3D e(vectors(0, 0), vectors(1, 0), vectors(2, 0));
+
+            auto min_max = GeometryUtils::extreme_points_along_direction(e, begin, end, pool, grain);
+            Point3D minpt = *min_max.first;
+            Point3D maxpt = *min_max.second;
+            float dist = sqrt((maxpt - minpt) * (maxpt - minpt));
+            this->radius = dist * 0.5f;
+            this->center = (minpt + maxpt) * 0.5f;
+        }
         
         /**
          * @name Constructors.
@@ -148,8 +237,23 @@ namespace Geometry {
 
         /// @}
 
+        /**
+         * @brief Test that evaluates the instersaction between two `Sphere`. It returns a boolean value: `true` if the two `Sphere` are intersecting and `false` otherwise.
+         * @param other `Sphere` object.
+         * @return Returns a boolean value.
+         */
         bool test_sphere_sphere_intersection(const Sphere& other) const ;
 
+        /**
+         * @brief `Vec3` overload of the `Sphere`-`Sphere` test on raw data: spheres (`c0`, `r0`) and (`c1`, `r1`). It returns `true` if they are intersecting and `false` otherwise.
+         * @param c0 center of the first sphere.
+         * @param r0 radius of the first sphere.
+         * @param c1 center of the second sphere.
+         * @param r1 radius of the second sphere.
+         * @return Returns a boolean value.
+         */
+        static bool test_sphere_sphere_intersection(const Vec3& c0, float r0, const Vec3& c1, float r1);
+
         /**
          * @brief Method that creates a Ritter sphere: it is an approximate bounding sphere but quite inexpensive.
          * @tparam `Iterator` Type that represent the Iterators of a container which supports them.
@@ -167,6 +271,21 @@ namespace Geometry {
                 this->update_sphere_with_outer_point(*begin);
         }
 
+        /**
+         * @brief Parallel overload of `ritter_sphere`: the starting sphere is found in parallel and the points that cannot grow it are filtered out in parallel, so only the few remaining ones are visited sequentially. The sphere is the same of the serial method.
+         * @tparam `RandomIt` random access iterator of a container of `Point3D` objects.
+         * @param begin starting iterator.
+         * @param end ending iterator.
+         * @param pool `ThreadPool` that runs the tasks.
+         * @param grain number of points per task.
+         * @return none.
+         */
+        template <typename RandomIt>
+        inline void ritter_sphere(RandomIt begin, RandomIt end, ThreadPool& pool, std::size_t grain = 65536) {
+            this->sphere_from_distant_points(begin, end, pool, grain);
+            this->grow_sphere(begin, end, pool, grain);
+        }
+
         /**
          * @brief Method that creates a Ritter Eigen sphere: is an approximate bounding sphere. It uses matrix transforms for a better approximation.
          * @tparam `Iterator` Type that represent the Iterators of a container which supports them.
@@ -185,6 +304,36 @@ namespace Geometry {
     
         }
 
+        /**
+         * @brief Parallel overload of `ritter_eigen_sphere`: the starting sphere is the parallel `eigen_sphere`, grown as in the parallel `ritter_sphere`.
+         * @tparam `RandomIt` random access iterator of a container of `Point3D` objects.
+         * @param begin starting iterator.
+         * @param end ending iterator.
+         * @param pool `ThreadPool` that runs the tasks.
+         * @param grain number of points per task.
+         * @return none.
+         */
+        template <typename RandomIt>
+        inline void ritter_eigen_sphere(RandomIt begin, RandomIt end, ThreadPool& pool, std::size_t grain = 65536) {
+            this->eigen_sphere(begin, end, pool, grain);
+            this->grow_sphere(begin, end, pool, grain);
+        }
+
+        /**
+         * @brief Method that creates the minimum bounding sphere, exactly (up to rounding), in expected linear time: Welzl's randomized algorithm with the move-to-front heuristic of Gärtner. The points are visited in a random order; when one is outside the current sphere, the sphere of the points visited before it is recomputed with that point on its boundary, and the point is moved to the front of the list so that the next recomputations meet it first. The recursion of the algorithm, whose depth is bounded by the 4 boundary points of a sphere, is unrolled on a fixed stack of 4 frames. The computations are made in double precision and the final radius is grown to the farthest point, so that every point is inside the sphere. Ritter spheres are commonly 5-20% larger.
+         * @tparam `Iterator` Type that represent the Iterators of a container which supports them.
+         * @param begin starting iterator.
+         * @param end ending iterator.
+         * @return none. 
+         */
+        template <typename Iterator>
+        inline void welzl_sphere(Iterator begin, Iterator end) {
+            std::vector<Vec3> points;
+            for(; begin != end; ++begin)
+                points.push_back(Vec3(begin->getX(), begin->getY(), begin->getZ()));
+            this->minimum_sphere(points);
+        }
+
     };
 }
 
@@ -0,0 +1,187 @@
+#ifndef SPHERE_BATCH_HH
+#define SPHERE_BATCH_HH
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Sphere.hh"
+#include "../Vec3.hh"
+#include "../AlignedAllocator.hh"
+#include "../Transform.hh"
+
+namespace Geometry {
+
+    /**
+     * @class SphereBatch.
+     * @brief Structure-of-arrays (SoA) store of `Sphere` objects: the coordinates of the centers and the radii live in four 32-byte aligned `float` arrays (x[], y[], z[], r[]), padded to a multiple of `SphereBatch::LANES`. The kernels stream these arrays `LANES` spheres at a time with no branches in the loop body and give the same results of `Sphere::test_sphere_sphere_intersection`.
+     * Contacts are optionally returned as `Vec4` values: `xyz` is the unit contact normal, pointing from the first sphere of the pair towards the second one, and `w` is the penetration depth (sum of the radii minus the distance of the centers). Concentric spheres get the normal (1, 0, 0).
+     ```
+     // Example:
+     SphereBatch particles;
+     particles.add(Sphere(Point3D(0,0,0), 1));
+     particles.add(Sphere(Point3D(5,0,0), 1));
+     std::uint32_t hits[2];
+     Vec4 contacts[2];
+     std::size_t n = particles.query(Sphere(Point3D(1.5,0,0), 1), hits, contacts);
+     // n = 1, hits[0] = 0, contacts[0] = (-1, 0, 0, 0.5)
+     ```
+     */
+    class SphereBatch {
+    public:
+
+        /**
+         * @brief Number of spheres processed by a single block of the kernels (one AVX register of `float`).
+         */
+        static const std::size_t LANES = 8;
+
+        /**
+         * @brief `std::vector` of `float` aligned for SIMD loads.
+         */
+        using FloatArray = std::vector<float, AlignedAllocator<float, 32>>;
+
+    private:
+
+        /**
+         * @brief Coordinates of the centers, one array per axis.
+         * @param center
+         */
+        FloatArray center[3];
+
+        /**
+         * @brief Radii of the spheres.
+         * @param radius
+         */
+        FloatArray radius;
+
+        /**
+         * @brief Number of stored spheres. The arrays are padded up to a multiple of `LANES`.
+         * @param count
+         */
+        std::size_t count;
+
+        /**
+         * @brief Support method that tests the sphere (`cx`, `cy`, `cz`, `r`) against a block of `LANES` spheres starting at `first`. If `contacts` is not null, the contact of every lane is written into it (`LANES` entries). Lanes beyond `size()` are always cleared.
+         * @return `std::uint32_t` bitmask: bit `l` is set if sphere `first + l` overlaps.
+         */
+        std::uint32_t overlap_block(std::size_t first, float cx, float cy, float cz, float r, Vec4* contacts) const ;
+
+        /**
+         * @brief Support method that tests the `count` (at most `LANES`) pairs (`a[l]`, `b[l]`). If `contacts` is not null, the contact of every lane is written into it (`LANES` entries).
+         * @return `std::uint32_t` bitmask: bit `l` is set if pair `l` overlaps.
+         */
+        std::uint32_t pair_block(const std::uint32_t* a, const std::uint32_t* b, std::size_t count, Vec4* contacts) const ;
+
+    public:
+
+        /**
+         * @name Constructors.
+         * @{
+         */
+
+            /**
+             * @brief Default constructor that creates an empty batch.
+             */
+            SphereBatch();
+
+            /**
+             * @brief Constructor that fills the batch with the `Sphere` objects of the range [`begin`, `end`).
+             * @tparam `Iterator` Type that represent the Iterators of a container which supports them.
+             * @param begin starting iterator.
+             * @param end ending iterator.
+             */
+            template <typename Iterator>
+            SphereBatch(Iterator begin, Iterator end) : count(0) {
+                for(; begin != end; ++begin)
+                    this->add(*begin);
+            }
+
+        /// @}
+
+        /**
+         * @brief Method that appends a `Sphere` to the batch. It returns the index of the stored sphere.
+         * @param sphere `Sphere` object.
+         * @return `std::size_t` index of the sphere.
+         */
+        std::size_t add(const Sphere& sphere);
+
+        /**
+         * @brief Method that overwrites the sphere stored at `index`. It throws `std::out_of_range` if `index` is not valid.
+         * @param index index of the sphere.
+         * @param sphere `Sphere` object.
+         */
+        void set(std::size_t index, const Sphere& sphere);
+
+        /**
+         * @brief Method that returns the sphere stored at `index` as a `Sphere` object. It throws `std::out_of_range` if `index` is not valid.
+         * @param index index of the sphere.
+         * @return `Sphere` object.
+         */
+        Sphere get(std::size_t index) const ;
+
+        /**
+         * @brief Method that reserves storage for at least `n` spheres.
+         * @param n number of spheres.
+         */
+        void reserve(std::size_t n);
+
+        /**
+         * @brief Method that removes all the spheres.
+         */
+        void clear();
+
+        /**
+         * @brief Method that returns the number of stored spheres.
+         * @return `std::size_t` value.
+         */
+        std::size_t size() const ;
+
+        /**
+         * @name Raw SoA access
+         * @brief Read-only pointers to the aligned arrays, e.g. for `CapsuleBatch::test_sphere_pairs`. They are invalidated by `add`, `reserve` and `clear`.
+         * @{
+         */
+
+            /**
+             * @brief Method that returns the coordinates of the centers along `axis` (0 = x, 1 = y, 2 = z). It throws `std::out_of_range` if `axis` is not valid.
+             * @param axis index of the axis.
+             * @return `const float*` pointer to the first coordinate.
+             */
+            const float* getCenterData(int axis) const ;
+
+            /**
+             * @brief Method that returns the radii.
+             * @return `const float*` pointer to the first radius.
+             */
+            const float* getRadiusData() const ;
+
+        /// @}
+
+        /**
+         * @brief Tests `sphere` against every sphere of the batch (one-vs-many). The indices of the overlapping spheres are written, in increasing order, into `out`, which must have room for `size()` indices. If `contacts` is not null, the contact of the i-th hit (from `sphere` towards the batch sphere) is written into `contacts[i]`; it must have room for `size()` entries too.
+         * @param sphere `Sphere` object.
+         * @param out caller-supplied index buffer.
+         * @param contacts optional caller-supplied contact buffer.
+         * @return `std::size_t` number of overlapping spheres written into `out`.
+         */
+        std::size_t query(const Sphere& sphere, std::uint32_t* out, Vec4* contacts = nullptr) const ;
+
+        /**
+         * @brief Tests the `n` pairs (`a[k]`, `b[k]`) of the pair list (many-vs-many). Bit `k % 32` of `mask[k / 32]` is set if pair `k` overlaps; `mask` must have room for (n + 31) / 32 words. If `contacts` is not null, the contact of pair `k` (from `a[k]` towards `b[k]`) is written into `contacts[k]`; its value is meaningful only when the bit is set.
+         * @param a indices of the first spheres.
+         * @param b indices of the second spheres.
+         * @param n number of pairs.
+         * @param mask caller-supplied bitmask buffer.
+         * @param contacts optional caller-supplied contact buffer.
+         * @return `std::size_t` number of overlapping pairs.
+         */
+        std::size_t test_pairs(const std::uint32_t* a, const std::uint32_t* b, std::size_t n, std::uint32_t* mask, Vec4* contacts = nullptr) const ;
+
+        /**
+         * @brief Method that writes into `out` the spheres of the batch moved by the rigid transforms `transforms`, one per sphere (`size()` entries): the center is transformed and the radius is kept. The spheres are moved `LANES` at a time: a block is computed into local lane arrays by a branch-free loop that the compiler vectorizes (the lane arrays cannot alias the batch, so no run-time alias checks are needed) and then copied out, so a whole population of local bounds is moved to world space in one pass. `out` is resized to the batch, reusing its storage; it throws `std::invalid_argument` if `out` is the batch itself.
+         * @param transforms rigid transforms.
+         * @param out `SphereBatch` object.
+         */
+        void transform(const Transform* transforms, SphereBatch& out) const ;
+    };
+}
+
+#endif
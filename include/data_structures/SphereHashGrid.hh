@@ -0,0 +1,184 @@
+#ifndef SPHERE_HASH_GRID_HH
+#define SPHERE_HASH_GRID_HH
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "Sphere.hh"
+
+namespace Geometry {
+
+    /**
+     * @class SphereHashGrid.
+     * @brief Uniform spatial hash grid broadphase for populations of `Sphere` objects of similar size. Every sphere is stored in the cell that contains its center; cells are hashed into a bucket table that is rebuilt every frame with a counting sort, so the whole grid lives in three flat arrays and no per-cell container is ever allocated. Spheres with a radius above half the cell size (`LARGE_RADIUS` cells) are kept out of the grid in a separate list and tested against every other sphere directly, so a few oversized objects cannot widen the neighbourhood of all the others: every grid sphere looks at most at the 27 cells around its own. The best cell size is about the diameter of the typical sphere. The query scratch space is owned by the grid, so `candidate_pairs` and `find_pairs` must not be called concurrently on the same grid.
+     ```
+     // Example:
+     std::vector<Sphere> spheres = { Sphere(Point3D(0,0,0), 1), Sphere(Point3D(1.5,0,0), 1), Sphere(Point3D(9,0,0), 1) };
+     SphereHashGrid grid(2.0f);
+     grid.build(spheres.begin(), spheres.end());
+     std::vector<std::pair<std::uint32_t, std::uint32_t>> pairs;
+     grid.find_pairs(pairs); // pairs = { (0, 1) }
+     ```
+     */
+    class SphereHashGrid {
+    private:
+
+        /**
+         * @brief Edge length of a cell.
+         * @param cell_size
+         */
+        float cell_size;
+
+        /**
+         * @brief Spheres of the current frame, in input order.
+         * @param spheres
+         */
+        std::vector<Sphere> spheres;
+
+        /**
+         * @brief Bucket of every sphere.
+         * @param bucket_of
+         */
+        std::vector<std::uint32_t> bucket_of;
+
+        /**
+         * @brief Prefix sums of the counting sort: the spheres of bucket `b` are `sorted[bucket_start[b]]` ... `sorted[bucket_start[b + 1] - 1]`.
+         * @param bucket_start
+         */
+        std::vector<std::uint32_t> bucket_start;
+
+        /**
+         * @brief Sphere indices sorted by bucket.
+         * @param sorted
+         */
+        std::vector<std::uint32_t> sorted;
+
+        /**
+         * @brief Indices of the spheres too large for the grid, tested against every sphere.
+         * @param large
+         */
+        std::vector<std::uint32_t> large;
+
+        /**
+         * @brief Largest radius of the spheres in the grid (at most `LARGE_RADIUS` cells), used to size the neighbourhood searched around each sphere.
+         * @param max_radius
+         */
+        float max_radius;
+
+        /**
+         * @brief Stamp of the last query that visited every bucket, to skip the buckets shared by several cells of a neighbourhood.
+         * @param bucket_stamp
+         */
+        mutable std::vector<std::uint32_t> bucket_stamp;
+
+        /**
+         * @brief Stamp of the current query.
+         * @param stamp
+         */
+        mutable std::uint32_t stamp;
+
+        /**
+         * @brief Distinct buckets of the current query, kept to reuse its storage.
+         * @param visited
+         */
+        mutable std::vector<std::uint32_t> visited;
+
+        /**
+         * @brief Support method that returns the integer cell coordinate of `value` along one axis, clamped to ±`MAX_CELL` so that far-away points and tiny cells cannot overflow `int`.
+         */
+        int cell_coordinate(float value) const ;
+
+        /**
+         * @brief Support method that hashes the cell (`x`, `y`, `z`) into a bucket of the table.
+         */
+        std::uint32_t hash_cell(int x, int y, int z) const ;
+
+        /**
+         * @brief Support method that rebuilds the bucket table with a counting sort of the stored spheres.
+         */
+        void rebuild();
+
+        /**
+         * @brief Support method that fills `visited` with the distinct buckets of the cells [`lo`, `hi`]; if the cells outnumber the buckets, every bucket is taken once instead.
+         */
+        void gather_buckets(const int lo[3], const int hi[3]) const ;
+
+    public:
+
+        /**
+         * @brief Radius, in cells, above which a sphere is kept out of the grid.
+         */
+        static constexpr float LARGE_RADIUS = 0.5f;
+
+        /**
+         * @brief Largest cell coordinate magnitude.
+         */
+        static const int MAX_CELL = 1 << 30;
+
+        /**
+         * @name Constructors.
+         * @{
+         */
+
+            /**
+             * @brief Constructor that creates an empty grid. It accepts 0 or 1 arguments: the edge length of the cells. It throws `std::invalid_argument` if `cell_size` is not positive.
+             * @param cell_size edge length of a cell.
+             */
+            SphereHashGrid(float cell_size = 1.0f);
+
+        /// @}
+
+        /**
+         * @name Getters and Setters
+         * @{
+         */
+
+            /**
+             * @brief Method that returns the edge length of a cell.
+             * @return `float` value.
+             */
+            float getCellSize() const ;
+
+            /**
+             * @brief Method that sets the edge length of a cell; it is used from the next `build`. It throws `std::invalid_argument` if `cell_size` is not positive.
+             * @param cell_size `float` value.
+             */
+            void setCellSize(float cell_size);
+
+        /// @}
+
+        /**
+         * @brief Method that rebuilds the grid from the `Sphere` objects of the range [`begin`, `end`). Pair indices refer to the position in the range. The storage of the previous frame is reused.
+         * @tparam `Iterator` Type that represent the Iterators of a container which supports them.
+         * @param begin starting iterator.
+         * @param end ending iterator.
+         */
+        template <typename Iterator>
+        inline void build(Iterator begin, Iterator end) {
+            this->spheres.clear();
+            for(; begin != end; ++begin)
+                this->spheres.push_back(*begin);
+            this->rebuild();
+        }
+
+        /**
+         * @brief Method that returns the number of spheres in the grid.
+         * @return `std::size_t` value.
+         */
+        std::size_t size() const ;
+
+        /**
+         * @brief Method that appends to `out` every candidate pair (i, j), i < j, of spheres whose bounding cubes overlap. Candidates still need a narrowphase test.
+         * @param out `std::vector` of index pairs.
+         */
+        void candidate_pairs(std::vector<std::pair<std::uint32_t, std::uint32_t>>& out) const ;
+
+        /**
+         * @brief Method that appends to `out` every pair (i, j), i < j, of intersecting spheres: candidates are confirmed with `Sphere::test_sphere_sphere_intersection`.
+         * @param out `std::vector` of index pairs.
+         */
+        void find_pairs(std::vector<std::pair<std::uint32_t, std::uint32_t>>& out) const ;
+    };
+}
+
+#endif
@@ -0,0 +1,175 @@
+#ifndef SWEEP_AND_PRUNE_HH
+#define SWEEP_AND_PRUNE_HH
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include "AABB.hh"
+
+namespace Geometry {
+
+    /**
+     * @class SweepAndPrune.
+     * @brief Incremental sweep-and-prune broadphase over `AABB` proxies. For each axis it keeps a sorted list of the min/max endpoints of every box; between frames the lists are re-sorted with insertion sort, which runs in almost linear time when objects move only a little. Every swap of a min endpoint with a max endpoint is a possible change of the overlap status of two boxes, so the set of overlapping pairs is kept up to date persistently and callers are notified when a pair is added or removed. The per-frame cost is close to O(n + k), where k is the number of swaps.
+     ```
+     // Example:
+     SweepAndPrune sap([](std::uint32_t a, std::uint32_t b) { std::cout << "begin " << a << " " << b; },
+                       [](std::uint32_t a, std::uint32_t b) { std::cout << "end " << a << " " << b; });
+     std::uint32_t a = sap.add(AABB(Point3D(0,0,0), 1, 1, 1));
+     std::uint32_t b = sap.add(AABB(Point3D(5,0,0), 1, 1, 1));
+     sap.update(); // no pair
+     sap.move(b, AABB(Point3D(1.5,0,0), 1, 1, 1));
+     sap.update(); // prints "begin 0 1"
+     ```
+     */
+    class SweepAndPrune {
+    public:
+
+        /**
+         * @brief Type of the functions notified when a pair starts or stops overlapping. The first argument is always the lower proxy id.
+         */
+        using PairCallback = std::function<void(std::uint32_t, std::uint32_t)>;
+
+    private:
+
+        /**
+         * @brief Endpoint of an interval along one axis: its value and the owning proxy id, whose lowest bit tells min (0) or max (1) endpoint.
+         */
+        struct Endpoint {
+            float value;
+            std::uint32_t data;
+        };
+
+        /**
+         * @brief Bounds of a proxy in min/max form, the same form used by the endpoint lists.
+         */
+        struct Proxy {
+            std::array<float, 3> min;
+            std::array<float, 3> max;
+            bool active;
+        };
+
+        /**
+         * @brief Sorted endpoint lists, one per axis.
+         * @param endpoints
+         */
+        std::array<std::vector<Endpoint>, 3> endpoints;
+
+        /**
+         * @brief Proxies indexed by id. Removed ids are recycled through `free_ids`.
+         * @param proxies
+         */
+        std::vector<Proxy> proxies;
+
+        /**
+         * @brief Ids of removed proxies that can be reused.
+         * @param free_ids
+         */
+        std::vector<std::uint32_t> free_ids;
+
+        /**
+         * @brief Persistent set of the overlapping pairs, encoded by `pair_key`.
+         * @param pair_set
+         */
+        std::unordered_set<std::uint64_t> pair_set;
+
+        /**
+         * @brief Notified when a pair starts overlapping.
+         * @param on_add
+         */
+        PairCallback on_add;
+
+        /**
+         * @brief Notified when a pair stops overlapping (or one of its proxies is removed).
+         * @param on_remove
+         */
+        PairCallback on_remove;
+
+        /**
+         * @brief Support function that encodes the unordered pair (`a`, `b`) into a 64-bit key, lower id first.
+         */
+        static std::uint64_t pair_key(std::uint32_t a, std::uint32_t b);
+
+        /**
+         * @brief Support method that tests the stored bounds of two proxies on all the three axes.
+         */
+        bool test_proxy_overlap(std::uint32_t a, std::uint32_t b) const ;
+
+        /**
+         * @brief Support method that re-sorts the endpoint list of `axis` with insertion sort, updating the pair set on every min/max swap.
+         * @param axis 0, 1 or 2.
+         */
+        void sort_axis(int axis);
+
+        /**
+         * @brief Support method that inserts the pair (`a`, `b`) into the pair set if it is overlapping, or removes it otherwise, notifying the change.
+         */
+        void refresh_pair(std::uint32_t a, std::uint32_t b);
+
+    public:
+
+        /**
+         * @name Constructors.
+         * @{
+         */
+
+            /**
+             * @brief Constructor that creates an empty broadphase. It accepts 0, 1 or 2 callbacks notified when a pair is added to or removed from the overlapping set.
+             * @param on_add pair added callback.
+             * @param on_remove pair removed callback.
+             */
+            SweepAndPrune(PairCallback on_add = nullptr, PairCallback on_remove = nullptr);
+
+        /// @}
+
+        /**
+         * @brief Method that inserts a new proxy with bounds `box` and returns its id. Its pairs are reported by the next `update()`.
+         * @param box `AABB` object.
+         * @return `std::uint32_t` proxy id.
+         */
+        std::uint32_t add(const AABB& box);
+
+        /**
+         * @brief Method that removes the proxy `id`. Its pairs are removed immediately and notified. It throws `std::out_of_range` if `id` is not a valid proxy.
+         * @param id proxy id.
+         */
+        void remove(std::uint32_t id);
+
+        /**
+         * @brief Method that sets the new bounds of the proxy `id`. The pair set is updated by the next `update()`. It throws `std::out_of_range` if `id` is not a valid proxy.
+         * @param id proxy id.
+         * @param box `AABB` object.
+         */
+        void move(std::uint32_t id, const AABB& box);
+
+        /**
+         * @brief Method that re-sorts the endpoint lists and updates the persistent pair set, notifying the added and removed pairs.
+         */
+        void update();
+
+        /**
+         * @brief Method that returns `true` if the pair (`a`, `b`) is in the overlapping set.
+         * @param a proxy id.
+         * @param b proxy id.
+         * @return Returns a boolean value.
+         */
+        bool is_overlapping(std::uint32_t a, std::uint32_t b) const ;
+
+        /**
+         * @brief Method that returns the number of overlapping pairs.
+         * @return `std::size_t` value.
+         */
+        std::size_t pair_count() const ;
+
+        /**
+         * @brief Method that returns the overlapping pairs, lower id first, sorted.
+         * @return `std::vector<std::pair<std::uint32_t, std::uint32_t>>` pairs.
+         */
+        std::vector<std::pair<std::uint32_t, std::uint32_t>> get_pairs() const ;
+    };
+}
+
+#endif
@@ -0,0 +1,382 @@
+#include "../include/Contact.hh"
+#include "../include/GeometricUtils.hh"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace Geometry {
+
+    // Support function: closest point of segment `ab` to point `c`
+    static inline Vec3 closest_point_segment(const Vec3& a, const Vec3& b, const Vec3& c) {
+        Vec3 ab = b - a;
+        float len2 = ab * ab;
+        float t = len2 > 0.0f ? ((c - a) * ab) / len2 : 0.0f;
+        t = t < 0.0f ? 0.0f : (t > 1.0f ? 1.0f : t);
+        return a + ab * t;
+    }
+
+    // Support function: unit vector orthogonal to `v` (any, if `v` is null)
+    static inline Vec3 orthogonal(const Vec3& v) {
+        Vec3 w = std::abs(v.x) < 0.57735f ? Vec3(1, 0, 0) : Vec3(0, 1, 0);
+        Vec3 n = cross(v, w);
+        float len2 = n * n;
+        return len2 > 0.0f ? n / std::sqrt(len2) : Vec3(1, 0, 0);
+    }
+
+    // Support function: twice the area of the quadrilateral spanned by four points in any order,
+    // i.e. the largest cross product of its diagonals over the three ways of pairing the points
+    static float quad_area(const Vec3& p0, const Vec3& p1, const Vec3& p2, const Vec3& p3) {
+        Vec3 c0 = cross(p0 - p1, p2 - p3), c1 = cross(p0 - p2, p1 - p3), c2 = cross(p0 - p3, p1 - p2);
+        float a = std::max(c0 * c0, std::max(c1 * c1, c2 * c2));
+        return std::sqrt(a);
+    }
+
+    int ContactManifold::add(const ContactPoint& p) {
+        if(this->count < MAX_POINTS) {
+            this->points[this->count] = p;
+            return this->count++;
+        }
+
+        // Five candidates: the four points and p (index 4). Keep the deepest one and drop the
+        // one whose removal leaves the largest area
+        const ContactPoint* candidate[MAX_POINTS + 1] = { &this->points[0], &this->points[1], &this->points[2], &this->points[3], &p };
+        int deepest = 0;
+        for(int i = 1; i <= MAX_POINTS; ++i)
+            if(candidate[i]->depth > candidate[deepest]->depth)
+                deepest = i;
+
+        int drop = -1;
+        float best_area = -1.0f;
+        for(int i = 0; i <= MAX_POINTS; ++i) {
+            if(i == deepest)
+                continue;
+            Vec3 q[MAX_POINTS];
+            for(int j = 0, k = 0; j <= MAX_POINTS; ++j)
+                if(j != i)
+                    q[k++] = candidate[j]->point_a;
+            float area = quad_area(q[0], q[1], q[2], q[3]);
+            if(area > best_area) {
+                best_area = area;
+                drop = i;
+            }
+        }
+        if(drop == MAX_POINTS)
+            return -1;
+        this->points[drop] = p;
+        return drop;
+    }
+
+    float ContactManifold::getDepth() const {
+        float depth = 0.0f;
+        for(int i = 0; i < this->count; ++i)
+            if(i == 0 || this->points[i].depth > depth)
+                depth = this->points[i].depth;
+        return depth;
+    }
+
+    bool ContactGenerator::sphere_sphere(const Sphere& a, const Sphere& b, ContactManifold& manifold) {
+        Vec3 ca(a.getCenter()), cb(b.getCenter());
+        float ra = a.getRadius(), rb = b.getRadius();
+        Vec3 d = cb - ca;
+        float d2 = d * d;
+        if(d2 > (ra + rb) * (ra + rb))
+            return false;
+        float distance = std::sqrt(d2);
+        Vec3 n = distance > 0.0f ? d / distance : Vec3(1, 0, 0);
+
+        manifold.normal = n;
+        manifold.count = 0;
+        ContactPoint p = { ca + n * ra, cb - n * rb, ra + rb - distance };
+        manifold.add(p);
+        return true;
+    }
+
+    bool ContactGenerator::capsule_sphere(const Capsule& a, const Sphere& b, ContactManifold& manifold) {
+        Vec3 s(a.getStart()), e(a.getEnd()), c(b.getCenter());
+        float ra = a.getRadius(), rb = b.getRadius();
+        Vec3 q = closest_point_segment(s, e, c);
+        Vec3 d = c - q;
+        float d2 = d * d;
+        if(d2 > (ra + rb) * (ra + rb))
+            return false;
+        float distance = std::sqrt(d2);
+        // A center on the medial segment can be pushed out in any direction orthogonal to it
+        Vec3 n = distance > 0.0f ? d / distance : orthogonal(e - s);
+
+        manifold.normal = n;
+        manifold.count = 0;
+        ContactPoint p = { q + n * ra, c - n * rb, ra + rb - distance };
+        manifold.add(p);
+        return true;
+    }
+
+    bool ContactGenerator::capsule_capsule(const Capsule& a, const Capsule& b, ContactManifold& manifold) {
+        Vec3 pa(a.getStart()), qa(a.getEnd()), pb(b.getStart()), qb(b.getEnd());
+        float ra = a.getRadius(), rb = b.getRadius(), r = ra + rb;
+        float s, t;
+        Vec3 c1, c2;
+        float d2 = GeometryUtils::closest_point_segment_segment(pa, qa, pb, qb, s, t, c1, c2);
+        if(d2 > r * r)
+            return false;
+        float distance = std::sqrt(d2);
+        Vec3 da = qa - pa, db = qb - pb;
+        Vec3 n;
+        if(distance > 0.0f)
+            n = (c2 - c1) / distance;
+        else {
+            // Crossing segments: push along the normal of their plane, or orthogonally to A if they are parallel
+            Vec3 axis = cross(da, db);
+            float len2 = axis * axis;
+            n = len2 > 0.0f ? axis / std::sqrt(len2) : orthogonal(da);
+        }
+
+        ContactManifold m;
+        m.normal = n;
+        // Parallel segments overlapping along their length: contact at both ends of the overlap
+        float la2 = da * da, lb2 = db * db;
+        Vec3 ab = cross(da, db);
+        if(distance > 0.0f && la2 > 0.0f && lb2 > 0.0f && ab * ab <= 1e-6f * la2 * lb2) {
+            float s0 = ((pb - pa) * da) / la2, s1 = ((qb - pa) * da) / la2;
+            if(s0 > s1)
+                std::swap(s0, s1);
+            s0 = std::max(s0, 0.0f);
+            s1 = std::min(s1, 1.0f);
+            if(s1 - s0 > 1e-3f) {
+                float ends[2] = { s0, s1 };
+                for(float u : ends) {
+                    Vec3 x = pa + da * u;
+                    Vec3 y = closest_point_segment(pb, qb, x);
+                    float depth = r - (y - x) * n;
+                    if(depth >= 0.0f) {
+                        ContactPoint p = { x + n * ra, y - n * rb, depth };
+                        m.add(p);
+                    }
+                }
+            }
+        }
+        if(m.count == 0) {
+            ContactPoint p = { c1 + n * ra, c2 - n * rb, r - distance };
+            m.add(p);
+        }
+        manifold = m;
+        return true;
+    }
+
+    bool ContactGenerator::box_sphere(const Vec3& c, const Vec3 u[3], const Vec3& e, const Vec3& center, float radius, ContactManifold& manifold) {
+        // Sphere center in the box frame, and its closest point of the box
+        Vec3 d = center - c;
+        Vec3 local(d * u[0], d * u[1], d * u[2]), q;
+        for(int i = 0; i < 3; ++i)
+            q[i] = local[i] < -e[i] ? -e[i] : (local[i] > e[i] ? e[i] : local[i]);
+        Vec3 excess = local - q;
+        float d2 = excess * excess;
+        if(d2 > radius * radius)
+            return false;
+
+        ContactPoint p;
+        Vec3 n;
+        if(d2 > 0.0f) {
+            float distance = std::sqrt(d2);
+            n = (u[0] * excess.x + u[1] * excess.y + u[2] * excess.z) / distance;
+            p.point_a = c + u[0] * q.x + u[1] * q.y + u[2] * q.z;
+            p.depth = radius - distance;
+        }
+        else {
+            // Center inside the box: push it out through the nearest face
+            int axis = 0;
+            for(int i = 1; i < 3; ++i)
+                if(e[i] - std::abs(local[i]) < e[axis] - std::abs(local[axis]))
+                    axis = i;
+            float gap = e[axis] - std::abs(local[axis]);
+            n = local[axis] < 0.0f ? -u[axis] : u[axis];
+            p.point_a = center + n * gap;
+            p.depth = radius + gap;
+        }
+        p.point_b = center - n * radius;
+        manifold.normal = n;
+        manifold.count = 0;
+        manifold.add(p);
+        return true;
+    }
+
+    // Support function: it swaps the roles of the two shapes of a manifold
+    static void flip(ContactManifold& manifold) {
+        manifold.normal = -manifold.normal;
+        for(int i = 0; i < manifold.count; ++i)
+            std::swap(manifold.points[i].point_a, manifold.points[i].point_b);
+    }
+
+    bool ContactGenerator::sphere_AABB(const Sphere& a, const AABB& b, ContactManifold& manifold) {
+        static const Vec3 axes[3] = { Vec3(1, 0, 0), Vec3(0, 1, 0), Vec3(0, 0, 1) };
+        if(!ContactGenerator::box_sphere(Vec3(b.getCenter()), axes, Vec3(b[0], b[1], b[2]), Vec3(a.getCenter()), a.getRadius(), manifold))
+            return false;
+        flip(manifold);
+        return true;
+    }
+
+    bool ContactGenerator::sphere_OBB(const Sphere& a, const OBB& b, ContactManifold& manifold) {
+        Vec3 axes[3] = { Vec3(b.getAxis(0)), Vec3(b.getAxis(1)), Vec3(b.getAxis(2)) };
+        if(!ContactGenerator::box_sphere(Vec3(b.getCenter()), axes, Vec3(b.getHalfwidth()), Vec3(a.getCenter()), a.getRadius(), manifold))
+            return false;
+        flip(manifold);
+        return true;
+    }
+
+    // Support function: it clips the convex polygon `in` (`n` vertices) against the half-space `plane * x <= offset`, and returns the number of vertices written to `out`
+    static int clip_polygon(const Vec3* in, int n, const Vec3& plane, float offset, Vec3* out) {
+        int m = 0;
+        for(int i = 0; i < n; ++i) {
+            const Vec3& a = in[i];
+            const Vec3& b = in[(i + 1) % n];
+            float da = plane * a - offset, db = plane * b - offset;
+            if(da <= 0.0f)
+                out[m++] = a;
+            if((da < 0.0f && db > 0.0f) || (da > 0.0f && db < 0.0f))
+                out[m++] = a + (b - a) * (da / (da - db));
+        }
+        return m;
+    }
+
+    // Support function: contacts of the face `axis` of the reference box R with the incident box I. With `flipped`, R is the second box of the pair
+    static bool face_contact(const Vec3& cr, const Vec3 ur[3], const Vec3& er, int axis, const Vec3& ci, const Vec3 ui[3], const Vec3& ei, bool flipped, ContactManifold& manifold) {
+        // Reference face normal, pointing towards I
+        Vec3 n = ((ci - cr) * ur[axis] < 0.0f) ? -ur[axis] : ur[axis];
+
+        // Incident face: the face of I most anti-parallel to n
+        int j = 0;
+        for(int k = 1; k < 3; ++k)
+            if(std::abs(ui[k] * n) > std::abs(ui[j] * n))
+                j = k;
+        Vec3 face = ci + ui[j] * ((ui[j] * n > 0.0f) ? -ei[j] : ei[j]);
+        int k = (j + 1) % 3, l = (j + 2) % 3;
+        Vec3 dk = ui[k] * ei[k], dl = ui[l] * ei[l];
+
+        // Clip the incident face against the four side planes of the reference face (each clip adds at most one vertex)
+        Vec3 buffer[2][8];
+        buffer[0][0] = face + dk + dl;
+        buffer[0][1] = face - dk + dl;
+        buffer[0][2] = face - dk - dl;
+        buffer[0][3] = face + dk - dl;
+        int size = 4, current = 0;
+        for(int side = 1; side < 3 && size > 0; ++side) {
+            const Vec3& u = ur[(axis + side) % 3];
+            float c = u * cr, e = er[(axis + side) % 3];
+            size = clip_polygon(buffer[current], size, u, c + e, buffer[1 - current]);
+            current = 1 - current;
+            size = clip_polygon(buffer[current], size, -u, e - c, buffer[1 - current]);
+            current = 1 - current;
+        }
+
+        // Keep the vertices below the reference face
+        Vec3 reference = cr + n * er[axis];
+        ContactManifold m;
+        m.normal = flipped ? -n : n;
+        for(int i = 0; i < size; ++i) {
+            const Vec3& v = buffer[current][i];
+            float separation = n * (v - reference);
+            if(separation > 0.0f)
+                continue;
+            Vec3 on_reference = v - n * separation;
+            ContactPoint p = { flipped ? v : on_reference, flipped ? on_reference : v, -separation };
+            m.add(p);
+        }
+        if(m.count == 0)
+            return false;
+        manifold = m;
+        return true;
+    }
+
+    bool ContactGenerator::box_box(const Vec3& ca, const Vec3 ua[3], const Vec3& ea, const Vec3& cb, const Vec3 ub[3], const Vec3& eb, ContactManifold& manifold) {
+        Vec3 d = cb - ca;
+
+        // Overlap along the face axes of A and B; any negative overlap is a separating axis
+        int face_a = 0, face_b = 0;
+        float overlap_a = 0.0f, overlap_b = 0.0f;
+        for(int i = 0; i < 3; ++i) {
+            float ra = ea[i];
+            float rb = eb[0] * std::abs(ua[i] * ub[0]) + eb[1] * std::abs(ua[i] * ub[1]) + eb[2] * std::abs(ua[i] * ub[2]);
+            float overlap = ra + rb - std::abs(d * ua[i]);
+            if(overlap < 0.0f)
+                return false;
+            if(i == 0 || overlap < overlap_a) {
+                overlap_a = overlap;
+                face_a = i;
+            }
+        }
+        for(int i = 0; i < 3; ++i) {
+            float ra = ea[0] * std::abs(ub[i] * ua[0]) + ea[1] * std::abs(ub[i] * ua[1]) + ea[2] * std::abs(ub[i] * ua[2]);
+            float rb = eb[i];
+            float overlap = ra + rb - std::abs(d * ub[i]);
+            if(overlap < 0.0f)
+                return false;
+            if(i == 0 || overlap < overlap_b) {
+                overlap_b = overlap;
+                face_b = i;
+            }
+        }
+
+        // Edge-edge axes; nearly parallel edges are skipped, their axis is covered by the face axes
+        int edge_a = -1, edge_b = -1;
+        float overlap_edge = 0.0f;
+        Vec3 edge_normal;
+        for(int i = 0; i < 3; ++i)
+            for(int j = 0; j < 3; ++j) {
+                Vec3 axis = cross(ua[i], ub[j]);
+                float len2 = axis * axis;
+                if(len2 < 1e-6f)
+                    continue;
+                axis = axis / std::sqrt(len2);
+                float ra = ea[0] * std::abs(ua[0] * axis) + ea[1] * std::abs(ua[1] * axis) + ea[2] * std::abs(ua[2] * axis);
+                float rb = eb[0] * std::abs(ub[0] * axis) + eb[1] * std::abs(ub[1] * axis) + eb[2] * std::abs(ub[2] * axis);
+                float overlap = ra + rb - std::abs(d * axis);
+                if(overlap < 0.0f)
+                    return false;
+                if(edge_a < 0 || overlap < overlap_edge) {
+                    overlap_edge = overlap;
+                    edge_a = i;
+                    edge_b = j;
+                    edge_normal = axis;
+                }
+            }
+
+        // Face contacts are favored over slightly smaller overlaps, so that the manifold does not flicker between frames
+        const float relative_tolerance = 0.95f;
+        bool use_b = overlap_b < relative_tolerance * overlap_a;
+        float overlap_face = use_b ? overlap_b : overlap_a;
+        if(edge_a < 0 || overlap_edge >= relative_tolerance * overlap_face) {
+            if(use_b)
+                return face_contact(cb, ub, eb, face_b, ca, ua, ea, true, manifold);
+            return face_contact(ca, ua, ea, face_a, cb, ub, eb, false, manifold);
+        }
+
+        // Edge-edge contact: the closest points of the two supporting edges
+        Vec3 n = (d * edge_normal < 0.0f) ? -edge_normal : edge_normal;
+        Vec3 pa = ca, pb = cb;
+        for(int k = 0; k < 3; ++k) {
+            if(k != edge_a)
+                pa += ua[k] * ((ua[k] * n > 0.0f) ? ea[k] : -ea[k]);
+            if(k != edge_b)
+                pb += ub[k] * ((ub[k] * n < 0.0f) ? eb[k] : -eb[k]);
+        }
+        Vec3 ha = ua[edge_a] * ea[edge_a], hb = ub[edge_b] * eb[edge_b];
+        float s, t;
+        Vec3 c1, c2;
+        GeometryUtils::closest_point_segment_segment(pa - ha, pa + ha, pb - hb, pb + hb, s, t, c1, c2);
+        manifold.normal = n;
+        manifold.count = 0;
+        ContactPoint p = { c1, c2, overlap_edge };
+        manifold.add(p);
+        return true;
+    }
+
+    bool ContactGenerator::AABB_AABB(const AABB& a, const AABB& b, ContactManifold& manifold) {
+        static const Vec3 axes[3] = { Vec3(1, 0, 0), Vec3(0, 1, 0), Vec3(0, 0, 1) };
+        return ContactGenerator::box_box(Vec3(a.getCenter()), axes, Vec3(a[0], a[1], a[2]), Vec3(b.getCenter()), axes, Vec3(b[0], b[1], b[2]), manifold);
+    }
+
+    bool ContactGenerator::OBB_OBB(const OBB& a, const OBB& b, ContactManifold& manifold) {
+        Vec3 ua[3] = { Vec3(a.getAxis(0)), Vec3(a.getAxis(1)), Vec3(a.getAxis(2)) };
+        Vec3 ub[3] = { Vec3(b.getAxis(0)), Vec3(b.getAxis(1)), Vec3(b.getAxis(2)) };
+        return ContactGenerator::box_box(Vec3(a.getCenter()), ua, Vec3(a.getHalfwidth()), Vec3(b.getCenter()), ub, Vec3(b.getHalfwidth()), manifold);
+    }
+}
@@ -0,0 +1,447 @@
+#include "../include/GJK.hh"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace Geometry {
+
+    // Relative tolerances: GJK stops when the lower and upper bounds of the distance
+    // agree to GJK_TOLERANCE, EPA when a new support point improves the depth by
+    // less than EPA_TOLERANCE (both relative to the size of the Minkowski difference)
+    static const float GJK_TOLERANCE = 1e-5f;
+    static const float EPA_TOLERANCE = 1e-4f;
+
+    // Support function: closest point to the origin of triangle (a, b, c), with its
+    // barycentric weights. Voronoi regions as in Ericson, "Real-Time Collision Detection", 5.1.5
+    static Vec3 closest_on_triangle(const Vec3& a, const Vec3& b, const Vec3& c, float lambda[3]) {
+        Vec3 ab = b - a, ac = c - a;
+        float d1 = -(ab * a), d2 = -(ac * a);
+        if(d1 <= 0.0f && d2 <= 0.0f) {
+            lambda[0] = 1.0f; lambda[1] = 0.0f; lambda[2] = 0.0f;
+            return a;
+        }
+        float d3 = -(ab * b), d4 = -(ac * b);
+        if(d3 >= 0.0f && d4 <= d3) {
+            lambda[0] = 0.0f; lambda[1] = 1.0f; lambda[2] = 0.0f;
+            return b;
+        }
+        float vc = d1 * d4 - d3 * d2;
+        if(vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f) {
+            float v = d1 / (d1 - d3);
+            lambda[0] = 1.0f - v; lambda[1] = v; lambda[2] = 0.0f;
+            return a + ab * v;
+        }
+        float d5 = -(ab * c), d6 = -(ac * c);
+        if(d6 >= 0.0f && d5 <= d6) {
+            lambda[0] = 0.0f; lambda[1] = 0.0f; lambda[2] = 1.0f;
+            return c;
+        }
+        float vb = d5 * d2 - d1 * d6;
+        if(vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f) {
+            float w = d2 / (d2 - d6);
+            lambda[0] = 1.0f - w; lambda[1] = 0.0f; lambda[2] = w;
+            return a + ac * w;
+        }
+        float va = d3 * d6 - d5 * d4;
+        if(va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f) {
+            float w = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+            lambda[0] = 0.0f; lambda[1] = 1.0f - w; lambda[2] = w;
+            return b + (c - b) * w;
+        }
+        float denom = 1.0f / (va + vb + vc);
+        float v = vb * denom, w = vc * denom;
+        lambda[0] = 1.0f - v - w; lambda[1] = v; lambda[2] = w;
+        return a + ab * v + ac * w;
+    }
+
+    GJK::Vertex GJK::support(const SupportMapping& a, const SupportMapping& b, const Vec3& direction) {
+        Vertex v;
+        v.a = a.support(direction);
+        v.b = b.support(-direction);
+        v.w = v.a - v.b;
+        v.direction = direction;
+        return v;
+    }
+
+    bool GJK::closest_point(Simplex& simplex, Vec3& closest) {
+        Vertex* v = simplex.v;
+        float* lambda = simplex.lambda;
+
+        // Keeps the vertices with a positive weight, in order
+        auto reduce = [&](const int* index, const float* weight, int n) {
+            Vertex kept[4];
+            float kept_lambda[4];
+            int size = 0;
+            for(int i = 0; i < n; ++i)
+                if(weight[i] > 0.0f) {
+                    kept[size] = v[index[i]];
+                    kept_lambda[size++] = weight[i];
+                }
+            for(int i = 0; i < size; ++i) {
+                v[i] = kept[i];
+                lambda[i] = kept_lambda[i];
+            }
+            simplex.size = size;
+        };
+
+        switch(simplex.size) {
+            case 1:
+                lambda[0] = 1.0f;
+                closest = v[0].w;
+                return false;
+
+            case 2: {
+                Vec3 ab = v[1].w - v[0].w;
+                float len2 = ab * ab;
+                float t = len2 > 0.0f ? -(v[0].w * ab) / len2 : 0.0f;
+                t = t < 0.0f ? 0.0f : (t > 1.0f ? 1.0f : t);
+                const int index[2] = { 0, 1 };
+                const float weight[2] = { 1.0f - t, t };
+                closest = v[0].w + ab * t;
+                reduce(index, weight, 2);
+                return false;
+            }
+
+            case 3: {
+                float weight[3];
+                const int index[3] = { 0, 1, 2 };
+                closest = closest_on_triangle(v[0].w, v[1].w, v[2].w, weight);
+                reduce(index, weight, 3);
+                return false;
+            }
+
+            default: {
+                // Faces of the tetrahedron, each with the opposite vertex last
+                static const int faces[4][4] = { {0, 1, 2, 3}, {0, 2, 3, 1}, {0, 3, 1, 2}, {1, 3, 2, 0} };
+                Vec3 a = v[0].w;
+                float volume = cross(v[1].w - a, v[2].w - a) * (v[3].w - a);
+                float edge2 = std::max((v[1].w - a) * (v[1].w - a), std::max((v[2].w - a) * (v[2].w - a), (v[3].w - a) * (v[3].w - a)));
+                // Slivers (volume negligible w.r.t. the longest edge) get no inside/outside test
+                bool degenerate = std::abs(volume) <= GJK_TOLERANCE * edge2 * std::sqrt(edge2);
+
+                float best = std::numeric_limits<float>::infinity();
+                int best_face = -1;
+                float best_weight[3] = { 0.0f, 0.0f, 0.0f };
+                for(int f = 0; f < 4; ++f) {
+                    const Vec3& p = v[faces[f][0]].w;
+                    const Vec3& q = v[faces[f][1]].w;
+                    const Vec3& r = v[faces[f][2]].w;
+                    const Vec3& s = v[faces[f][3]].w;
+                    Vec3 n = cross(q - p, r - p);
+                    // The origin can only be closest to a face it lies outside of
+                    bool outside = degenerate || (n * p) * (n * (s - p)) > 0.0f;
+                    if(!outside)
+                        continue;
+                    float weight[3];
+                    Vec3 c = closest_on_triangle(p, q, r, weight);
+                    if(c * c < best) {
+                        best = c * c;
+                        best_face = f;
+                        closest = c;
+                        best_weight[0] = weight[0]; best_weight[1] = weight[1]; best_weight[2] = weight[2];
+                    }
+                }
+                if(best_face < 0) {
+                    // Origin inside the tetrahedron
+                    closest = Vec3();
+                    return true;
+                }
+                reduce(faces[best_face], best_weight, 3);
+                return false;
+            }
+        }
+    }
+
+    void GJK::start(const SupportMapping& a, const SupportMapping& b, const GJKCache* cache, Simplex& simplex) {
+        simplex.size = 0;
+        if(cache != nullptr) {
+            for(int i = 0; i < cache->size; ++i) {
+                Vertex v = GJK::support(a, b, cache->directions[i]);
+                bool duplicate = false;
+                for(int k = 0; k < simplex.size; ++k)
+                    duplicate |= ((v.w - simplex.v[k].w) * (v.w - simplex.v[k].w)) == 0.0f;
+                if(!duplicate)
+                    simplex.v[simplex.size++] = v;
+            }
+        }
+        if(simplex.size == 0) {
+            // Cold start: search from the centers of the shapes
+            Vec3 d = b.getCenter() - a.getCenter();
+            if(d * d == 0.0f)
+                d = Vec3(1.0f, 0.0f, 0.0f);
+            simplex.v[simplex.size++] = GJK::support(a, b, d);
+        }
+    }
+
+    void GJK::store(const Simplex& simplex, GJKCache* cache) {
+        if(cache == nullptr)
+            return;
+        cache->size = simplex.size;
+        for(int i = 0; i < simplex.size; ++i)
+            cache->directions[i] = simplex.v[i].direction;
+    }
+
+    bool GJK::run(const SupportMapping& a, const SupportMapping& b, Simplex& simplex, Vec3& closest, int& iterations, bool boolean_only) {
+        iterations = 0;
+        if(GJK::closest_point(simplex, closest))
+            return true;
+
+        // Set once a separating axis has been seen: from then on the origin cannot be
+        // enclosed, whatever the rounding errors of the simplex say
+        bool separated = false;
+
+        while(iterations < MAX_ITERATIONS) {
+            ++iterations;
+            float vv = closest * closest;
+            float scale = 0.0f;
+            for(int i = 0; i < simplex.size; ++i) {
+                float ww = simplex.v[i].w * simplex.v[i].w;
+                scale = ww > scale ? ww : scale;
+            }
+            // The origin is on the simplex: the shapes touch
+            if(vv <= GJK_TOLERANCE * GJK_TOLERANCE * scale)
+                return true;
+
+            Vertex w = GJK::support(a, b, -closest);
+            float vw = closest * w.w;
+            // -closest is a separating axis
+            separated |= vw > 0.0f;
+            if(boolean_only && separated)
+                return false;
+            // No significant progress along -closest: converged
+            if(vv - vw <= GJK_TOLERANCE * vv)
+                return false;
+            for(int i = 0; i < simplex.size; ++i)
+                if(simplex.v[i].w == w.w)
+                    return false;
+
+            Simplex previous = simplex;
+            Vec3 previous_closest = closest;
+            simplex.v[simplex.size++] = w;
+            bool inside = GJK::closest_point(simplex, closest);
+            if(inside && !separated)
+                return true;
+            // The distance must strictly decrease, otherwise we are cycling on rounding
+            // errors: keep the last good simplex
+            if(inside || closest * closest >= vv) {
+                simplex = previous;
+                closest = previous_closest;
+                return false;
+            }
+        }
+        return false;
+    }
+
+    void GJK::epa(const SupportMapping& a, const SupportMapping& b, Simplex simplex, GJKResult& result) {
+        // Witness points of the GJK simplex, used if the polytope cannot be built
+        result.point_a = Vec3();
+        result.point_b = Vec3();
+        float total = 0.0f;
+        for(int i = 0; i < simplex.size; ++i) {
+            float weight = simplex.size == 4 ? 0.25f : simplex.lambda[i];
+            result.point_a += simplex.v[i].a * weight;
+            result.point_b += simplex.v[i].b * weight;
+            total += weight;
+        }
+        if(total > 0.0f) {
+            result.point_a = result.point_a / total;
+            result.point_b = result.point_b / total;
+        }
+        result.depth = 0.0f;
+        result.normal = Vec3(1.0f, 0.0f, 0.0f);
+
+        // Blow the simplex up to a tetrahedron
+        Vertex* v = simplex.v;
+        float scale = 0.0f;
+        for(int i = 0; i < simplex.size; ++i)
+            scale = std::max(scale, v[i].w * v[i].w);
+        const float tiny = GJK_TOLERANCE * GJK_TOLERANCE * (scale > 0.0f ? scale : 1.0f);
+        if(simplex.size == 1) {
+            static const Vec3 axes[6] = { Vec3(1,0,0), Vec3(-1,0,0), Vec3(0,1,0), Vec3(0,-1,0), Vec3(0,0,1), Vec3(0,0,-1) };
+            for(int i = 0; i < 6 && simplex.size == 1; ++i) {
+                Vertex w = GJK::support(a, b, axes[i]);
+                if((w.w - v[0].w) * (w.w - v[0].w) > tiny)
+                    v[simplex.size++] = w;
+            }
+        }
+        if(simplex.size == 2) {
+            Vec3 d = v[1].w - v[0].w;
+            Vec3 e = (std::abs(d.x) <= std::abs(d.y) && std::abs(d.x) <= std::abs(d.z)) ? Vec3(1,0,0) : (std::abs(d.y) <= std::abs(d.z) ? Vec3(0,1,0) : Vec3(0,0,1));
+            Vec3 p1 = cross(d, e), p2 = cross(d, p1);
+            const Vec3 directions[4] = { p1, -p1, p2, -p2 };
+            for(int i = 0; i < 4 && simplex.size == 2; ++i) {
+                Vertex w = GJK::support(a, b, directions[i]);
+                Vec3 c = cross(w.w - v[0].w, d);
+                if(c * c > tiny * (d * d))
+                    v[simplex.size++] = w;
+            }
+        }
+        if(simplex.size == 3) {
+            Vec3 n = cross(v[1].w - v[0].w, v[2].w - v[0].w);
+            const Vec3 directions[2] = { n, -n };
+            for(int i = 0; i < 2 && simplex.size == 3; ++i) {
+                Vertex w = GJK::support(a, b, directions[i]);
+                float h = n * (w.w - v[0].w);
+                if(h * h > tiny * (n * n))
+                    v[simplex.size++] = w;
+            }
+            if(simplex.size == 3) {
+                // Flat Minkowski difference (e.g. coplanar triangles): touching contact
+                if(n * n > 0.0f)
+                    result.normal = n / std::sqrt(n * n);
+                return;
+            }
+        }
+        if(simplex.size < 3)
+            return;
+
+        // Expanding polytope
+        struct Face {
+            int i[3];
+            Vec3 n;
+            float d;
+        };
+        std::vector<Vertex> vertices(v, v + 4);
+        std::vector<Face> faces;
+        auto make_face = [&](int i0, int i1, int i2) {
+            Face f;
+            f.i[0] = i0; f.i[1] = i1; f.i[2] = i2;
+            Vec3 n = cross(vertices[i1].w - vertices[i0].w, vertices[i2].w - vertices[i0].w);
+            float len2 = n * n;
+            if(len2 > 0.0f) {
+                f.n = n / std::sqrt(len2);
+                f.d = f.n * vertices[i0].w;
+            } else {
+                // Degenerate face: never expanded nor removed
+                f.n = Vec3();
+                f.d = std::numeric_limits<float>::infinity();
+            }
+            return f;
+        };
+
+        // Initial faces, wound so that the normals point away from the centroid
+        Vec3 centroid = (vertices[0].w + vertices[1].w + vertices[2].w + vertices[3].w) * 0.25f;
+        static const int initial[4][3] = { {0, 1, 2}, {0, 3, 1}, {0, 2, 3}, {1, 3, 2} };
+        for(int f = 0; f < 4; ++f) {
+            Face face = make_face(initial[f][0], initial[f][1], initial[f][2]);
+            if(face.n * (vertices[initial[f][0]].w - centroid) < 0.0f)
+                face = make_face(initial[f][0], initial[f][2], initial[f][1]);
+            faces.push_back(face);
+        }
+
+        std::size_t best = 0;
+        std::vector<std::pair<int, int>> horizon;
+        for(int iteration = 0; iteration < MAX_EPA_ITERATIONS; ++iteration) {
+            best = 0;
+            for(std::size_t f = 1; f < faces.size(); ++f)
+                if(faces[f].d < faces[best].d)
+                    best = f;
+            Face closest = faces[best];
+            if(closest.d == std::numeric_limits<float>::infinity())
+                break;
+
+            Vertex w = GJK::support(a, b, closest.n);
+            float distance = closest.n * w.w;
+            if(distance - closest.d <= EPA_TOLERANCE * std::sqrt(scale))
+                break;
+
+            // Remove the faces visible from w and collect their boundary (the horizon)
+            horizon.clear();
+            std::size_t kept = 0;
+            for(std::size_t f = 0; f < faces.size(); ++f) {
+                const Face& face = faces[f];
+                if(face.n * (w.w - vertices[face.i[0]].w) > 0.0f) {
+                    for(int e = 0; e < 3; ++e) {
+                        std::pair<int, int> edge(face.i[e], face.i[(e + 1) % 3]);
+                        bool shared = false;
+                        for(std::size_t h = 0; h < horizon.size(); ++h)
+                            if(horizon[h].first == edge.second && horizon[h].second == edge.first) {
+                                horizon[h] = horizon.back();
+                                horizon.pop_back();
+                                shared = true;
+                                break;
+                            }
+                        if(!shared)
+                            horizon.push_back(edge);
+                    }
+                } else
+                    faces[kept++] = face;
+            }
+            faces.resize(kept);
+            if(horizon.empty())
+                break;
+
+            int index = static_cast<int>(vertices.size());
+            vertices.push_back(w);
+            for(std::size_t h = 0; h < horizon.size(); ++h)
+                faces.push_back(make_face(horizon[h].first, horizon[h].second, index));
+            best = 0;
+            for(std::size_t f = 1; f < faces.size(); ++f)
+                if(faces[f].d < faces[best].d)
+                    best = f;
+        }
+        if(faces.empty())
+            return;
+
+        // Witness points: barycentric coordinates of the projection of the origin on the closest face
+        const Face& face = faces[best];
+        if(face.d == std::numeric_limits<float>::infinity())
+            return;
+        const Vertex& p = vertices[face.i[0]];
+        const Vertex& q = vertices[face.i[1]];
+        const Vertex& r = vertices[face.i[2]];
+        Vec3 x = face.n * face.d;
+        Vec3 v0 = q.w - p.w, v1 = r.w - p.w, v2 = x - p.w;
+        float d00 = v0 * v0, d01 = v0 * v1, d11 = v1 * v1, d20 = v2 * v0, d21 = v2 * v1;
+        float denom = d00 * d11 - d01 * d01;
+        float bv = 0.0f, bw = 0.0f;
+        if(denom != 0.0f) {
+            bv = (d11 * d20 - d01 * d21) / denom;
+            bw = (d00 * d21 - d01 * d20) / denom;
+        }
+        float bu = 1.0f - bv - bw;
+        result.depth = face.d > 0.0f ? face.d : 0.0f;
+        result.normal = face.n;
+        result.point_a = p.a * bu + q.a * bv + r.a * bw;
+        result.point_b = p.b * bu + q.b * bv + r.b * bw;
+    }
+
+    bool GJK::intersect(const SupportMapping& a, const SupportMapping& b, GJKCache* cache) {
+        Simplex simplex;
+        Vec3 closest;
+        int iterations;
+        GJK::start(a, b, cache, simplex);
+        bool hit = GJK::run(a, b, simplex, closest, iterations, true);
+        GJK::store(simplex, cache);
+        return hit;
+    }
+
+    GJKResult GJK::query(const SupportMapping& a, const SupportMapping& b, GJKCache* cache) {
+        Simplex simplex;
+        Vec3 closest;
+        GJKResult result;
+        GJK::start(a, b, cache, simplex);
+        result.intersecting = GJK::run(a, b, simplex, closest, result.iterations, false);
+        GJK::store(simplex, cache);
+
+        if(result.intersecting) {
+            result.distance = 0.0f;
+            GJK::epa(a, b, simplex, result);
+            return result;
+        }
+
+        // Closest points: the barycentric combination of the support points
+        result.point_a = Vec3();
+        result.point_b = Vec3();
+        for(int i = 0; i < simplex.size; ++i) {
+            result.point_a += simplex.v[i].a * simplex.lambda[i];
+            result.point_b += simplex.v[i].b * simplex.lambda[i];
+        }
+        result.distance = std::sqrt(closest * closest);
+        result.depth = 0.0f;
+        result.normal = result.distance > 0.0f ? -closest / result.distance : Vec3(1.0f, 0.0f, 0.0f);
+        return result;
+    }
+}
@@ -1,9 +1,72 @@
 #include "../include/GeometricUtils.hh"
+#include <algorithm>
 
 namespace Geometry {
     
+    float GeometryUtils::min_area_rectangle_convex(std::vector<Point2D>& polygon, Point2D& c, std::pair<Point2D, Point2D>& out) {
+        std::size_t n = polygon.size();
+        float twice_area = 0.0f;
+        for(std::size_t i = 0, j = n - 1; i < n; j = i, ++i)
+            twice_area += polygon[j].getX() * polygon[i].getY() - polygon[i].getX() * polygon[j].getY();
+        // All the points on a line: the brute-force method handles it
+        if(twice_area == 0.0f)
+            return GeometryUtils::min_area_rectangle(polygon.begin(), polygon.end(), c, out);
+        if(twice_area < 0.0f)
+            std::reverse(polygon.begin(), polygon.end());
+
+        std::vector<float> x(n), y(n);
+        for(std::size_t i = 0; i < n; ++i) {
+            x[i] = polygon[i].getX();
+            y[i] = polygon[i].getY();
+        }
+        auto next = [n](std::size_t i) { return i + 1 == n ? 0 : i + 1; };
+
+        // Calipers: farthest point along the edge (k), from the edge (m) and against the edge (l); counter-clockwise they come in this order and only move forward
+        std::size_t k = 1, m = 1, l = 1;
+        float minArea = std::numeric_limits<float>::max();
+        for(std::size_t i = 0; i < n; ++i) {
+            std::size_t j = next(i);
+            float e0x = x[j] - x[i], e0y = y[j] - y[i];
+            float length = std::sqrt(e0x * e0x + e0y * e0y);
+            e0x /= length;
+            e0y /= length;
+            // Inward normal of a counter-clockwise polygon
+            float e1x = -e0y, e1y = e0x;
+            auto along = [&](std::size_t v) { return (x[v] - x[i]) * e0x + (y[v] - y[i]) * e0y; };
+            auto across = [&](std::size_t v) { return (x[v] - x[i]) * e1x + (y[v] - y[i]) * e1y; };
+
+            if(i == 0)
+                k = j;
+            for(std::size_t s = 0; s < n && along(next(k)) >= along(k); ++s)
+                k = next(k);
+            if(i == 0)
+                m = k;
+            for(std::size_t s = 0; s < n && across(next(m)) >= across(m); ++s)
+                m = next(m);
+            if(i == 0)
+                l = m;
+            for(std::size_t s = 0; s < n && along(next(l)) <= along(l); ++s)
+                l = next(l);
+
+            float min0 = along(l), max0 = along(k), max1 = across(m);
+            float area = (max0 - min0) * max1;
+            if(area < minArea) {
+                minArea = area;
+                float half0 = (min0 + max0) * 0.5f, half1 = max1 * 0.5f;
+                c = Point2D(x[i] + e0x * half0 + e1x * half1, y[i] + e0y * half0 + e1y * half1);
+                out.first = Point2D(e0x, e0y);
+                out.second = Point2D(e1x, e1y);
+            }
+        }
+        return minArea;
+    }
+
     float GeometryUtils::sq_dist_point_segment(Point3D a, Point3D b, Point3D c) {
-        Point3D ab = b - a, ac = c - a, bc = b - c;
+        return GeometryUtils::sq_dist_point_segment(Vec3(a), Vec3(b), Vec3(c));
+    }
+
+    float GeometryUtils::sq_dist_point_segment(const Vec3& a, const Vec3& b, const Vec3& c) {
+        Vec3 ab = b - a, ac = c - a, bc = b - c;
         float e = ac * ab;
         // Handle cases where c projects outside ab
         if (e <= 0.0f) 
@@ -14,6 +77,7 @@ namespace Geometry {
         // Handle cases where c projects onto ab
         return ac * ac - e * e / f;
     }
+
     // Support function: clamp n to lie within the reange [min, max]
     float GeometryUtils::clamp(const float n, const float min, const float max) {
         if(n < min)
@@ -24,10 +88,18 @@ namespace Geometry {
     }
     
     float GeometryUtils::closest_point_segment_segment(Point3D p1, Point3D q1, Point3D p2, Point3D q2, float& s, float& t, Point3D& c1,Point3D& c2) {
+        Vec3 v1, v2;
+        float dist2 = GeometryUtils::closest_point_segment_segment(Vec3(p1), Vec3(q1), Vec3(p2), Vec3(q2), s, t, v1, v2);
+        c1 = v1.toPoint3D();
+        c2 = v2.toPoint3D();
+        return dist2;
+    }
+
+    float GeometryUtils::closest_point_segment_segment(const Vec3& p1, const Vec3& q1, const Vec3& p2, const Vec3& q2, float& s, float& t, Vec3& c1, Vec3& c2) {
         float epsilon = std::numeric_limits<float>::epsilon();
-        Point3D d1 = q1 - p1; // Direction vector of segment S1
-        Point3D d2 = q2 - p2; // Direction vector of segment S2
-        Point3D r = p1 - p2;
+        Vec3 d1 = q1 - p1; // Direction vector of segment S1
+        Vec3 d2 = q2 - p2; // Direction vector of segment S2
+        Vec3 r = p1 - p2;
         float a = d1 * d1; // Squared length of segment S1
         float e = d2 * d2; // Squared length of segment S2
         float f = d2 * r;
@@ -0,0 +1,73 @@
+#include "../include/Mat3.hh"
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace Geometry {
+
+    Point3D Mat3::operator*(const Point3D& p) const {
+        return Point3D(m[0][0] * p.getX() + m[0][1] * p.getY() + m[0][2] * p.getZ(),
+                       m[1][0] * p.getX() + m[1][1] * p.getY() + m[1][2] * p.getZ(),
+                       m[2][0] * p.getX() + m[2][1] * p.getY() + m[2][2] * p.getZ());
+    }
+
+    void Mat3::symmetric_eigen(Vec3& eigenvalues, Mat3& eigenvectors) const {
+        // Symmetric copy from the upper triangle
+        float a[3][3] = {{ m[0][0], m[0][1], m[0][2] },
+                         { m[0][1], m[1][1], m[1][2] },
+                         { m[0][2], m[1][2], m[2][2] }};
+        Mat3 v = Mat3::identity();
+        const int pairs[3][2] = {{ 0, 1 }, { 0, 2 }, { 1, 2 }};
+
+        for(int sweep = 0; sweep < MAX_SWEEPS; ++sweep) {
+            float off = a[0][1] * a[0][1] + a[0][2] * a[0][2] + a[1][2] * a[1][2];
+            float diagonal = a[0][0] * a[0][0] + a[1][1] * a[1][1] + a[2][2] * a[2][2];
+            float epsilon = std::numeric_limits<float>::epsilon();
+            if(off <= epsilon * epsilon * diagonal)
+                break;
+
+            for(const int* pq : pairs) {
+                int p = pq[0], q = pq[1], r = 3 - p - q;
+                float apq = a[p][q];
+                if(apq == 0.0f)
+                    continue;
+                // Rotation that zeroes a[p][q]: t = tan(theta), the smaller root (Golub and Van Loan)
+                float theta = (a[q][q] - a[p][p]) / (2.0f * apq);
+                float t = 1.0f / (std::abs(theta) + std::sqrt(theta * theta + 1.0f));
+                if(theta < 0.0f)
+                    t = -t;
+                float c = 1.0f / std::sqrt(t * t + 1.0f), s = t * c;
+
+                a[p][p] -= t * apq;
+                a[q][q] += t * apq;
+                a[p][q] = a[q][p] = 0.0f;
+                float arp = a[r][p], arq = a[r][q];
+                a[r][p] = a[p][r] = c * arp - s * arq;
+                a[r][q] = a[q][r] = s * arp + c * arq;
+                for(int k = 0; k < 3; ++k) {
+                    float vkp = v(k, p), vkq = v(k, q);
+                    v(k, p) = c * vkp - s * vkq;
+                    v(k, q) = s * vkp + c * vkq;
+                }
+            }
+        }
+
+        // Sort in decreasing order, moving the columns along
+        int order[3] = { 0, 1, 2 };
+        if(a[order[0]][order[0]] < a[order[1]][order[1]]) std::swap(order[0], order[1]);
+        if(a[order[1]][order[1]] < a[order[2]][order[2]]) std::swap(order[1], order[2]);
+        if(a[order[0]][order[0]] < a[order[1]][order[1]]) std::swap(order[0], order[1]);
+        for(int i = 0; i < 3; ++i) {
+            eigenvalues[i] = a[order[i]][order[i]];
+            for(int k = 0; k < 3; ++k)
+                eigenvectors(k, i) = v(k, order[i]);
+        }
+
+        // Right-handed: the third axis is the cross product of the first two (it is already one of +/- that)
+        Vec3 e0(eigenvectors(0, 0), eigenvectors(1, 0), eigenvectors(2, 0));
+        Vec3 e1(eigenvectors(0, 1), eigenvectors(1, 1), eigenvectors(2, 1));
+        Vec3 e2 = cross(e0, e1);
+        for(int k = 0; k < 3; ++k)
+            eigenvectors(k, 2) = e2[k];
+    }
+}
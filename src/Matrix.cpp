@@ -75,7 +75,7 @@ namespace Geometry {
     }
 
     void Matrix::sym_schur_2x2(int p, int q, float& c, float& s) {
-        if(abs(this->get(p, q)) > 0.0001f) {
+        if(std::abs(this->get(p, q)) > 0.0001f) {
             float r = (this->get(q, q) - this->get(p, p)) / (2.0f * this->get(p, q));
             float t;
             if(r >= 0.0f)
@@ -92,7 +92,7 @@ namespace Geometry {
 
     void Matrix::jacobi(Matrix& A, Matrix& V) {
         int i, j, n, p, q;
-        float prevoff, c, s;
+        float prevoff = 0.0f, c, s;
         Matrix J, b, t;
 
         // Initialize V to identify matrix
@@ -111,7 +111,7 @@ namespace Geometry {
                 for(j = 0; j < 3; ++j) {
                     if(i == j) 
                         continue;
-                    if(abs(A[i][j]) > abs(A[p][q])) {
+                    if(std::abs(A[i][j]) > std::abs(A[p][q])) {
                         p = i;
                         q = j;
                     }
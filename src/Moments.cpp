@@ -0,0 +1,109 @@
+#include "../include/Moments.hh"
+
+namespace Geometry {
+
+    Moments::Moments() {
+        this->clear();
+    }
+
+    void Moments::clear() {
+        this->n = 0;
+        for(int i = 0; i < 3; ++i)
+            this->mean[i] = 0.0;
+        for(int i = 0; i < 6; ++i)
+            this->m2[i] = 0.0;
+    }
+
+    void Moments::add(float x, float y, float z) {
+        ++this->n;
+        // Deviation from the old mean, then from the new one
+        double d0[3] = { x - this->mean[0], y - this->mean[1], z - this->mean[2] };
+        double k = 1.0 / static_cast<double>(this->n);
+        for(int i = 0; i < 3; ++i)
+            this->mean[i] += d0[i] * k;
+        double d1[3] = { x - this->mean[0], y - this->mean[1], z - this->mean[2] };
+        this->m2[0] += d0[0] * d1[0];
+        this->m2[1] += d0[1] * d1[1];
+        this->m2[2] += d0[2] * d1[2];
+        this->m2[3] += d0[0] * d1[1];
+        this->m2[4] += d0[0] * d1[2];
+        this->m2[5] += d0[1] * d1[2];
+    }
+
+    void Moments::add(const float* x, const float* y, const float* z, std::size_t count) {
+        if(count == 0)
+            return;
+
+        // Two passes over the block, which is small enough to stay in cache: mean, then centered products
+        double sx = 0.0, sy = 0.0, sz = 0.0;
+        for(std::size_t i = 0; i < count; ++i) {
+            sx += x[i];
+            sy += y[i];
+            sz += z[i];
+        }
+        double oon = 1.0 / static_cast<double>(count);
+        double block_mean[3] = { sx * oon, sy * oon, sz * oon };
+        double e00 = 0.0, e11 = 0.0, e22 = 0.0, e01 = 0.0, e02 = 0.0, e12 = 0.0;
+        for(std::size_t i = 0; i < count; ++i) {
+            double dx = x[i] - block_mean[0], dy = y[i] - block_mean[1], dz = z[i] - block_mean[2];
+            e00 += dx * dx;
+            e11 += dy * dy;
+            e22 += dz * dz;
+            e01 += dx * dy;
+            e02 += dx * dz;
+            e12 += dy * dz;
+        }
+        double block_m2[6] = { e00, e11, e22, e01, e02, e12 };
+        this->merge(count, block_mean, block_m2);
+    }
+
+    void Moments::merge(const Moments& other) {
+        this->merge(other.n, other.mean, other.m2);
+    }
+
+    void Moments::merge(std::uint64_t count, const double* part_mean, const double* part_m2) {
+        if(count == 0)
+            return;
+        if(this->n == 0) {
+            this->n = count;
+            for(int i = 0; i < 3; ++i)
+                this->mean[i] = part_mean[i];
+            for(int i = 0; i < 6; ++i)
+                this->m2[i] = part_m2[i];
+            return;
+        }
+
+        // Chan et al.: the sums of products grow by the outer product of the difference of the means, weighted by na * nb / n
+        double na = static_cast<double>(this->n), nb = static_cast<double>(count), total = na + nb;
+        double d[3] = { part_mean[0] - this->mean[0], part_mean[1] - this->mean[1], part_mean[2] - this->mean[2] };
+        double w = na * nb / total;
+        this->m2[0] += part_m2[0] + d[0] * d[0] * w;
+        this->m2[1] += part_m2[1] + d[1] * d[1] * w;
+        this->m2[2] += part_m2[2] + d[2] * d[2] * w;
+        this->m2[3] += part_m2[3] + d[0] * d[1] * w;
+        this->m2[4] += part_m2[4] + d[0] * d[2] * w;
+        this->m2[5] += part_m2[5] + d[1] * d[2] * w;
+        for(int i = 0; i < 3; ++i)
+            this->mean[i] += d[i] * (nb / total);
+        this->n += count;
+    }
+
+    std::uint64_t Moments::count() const {
+        return this->n;
+    }
+
+    Vec3 Moments::centroid() const {
+        return Vec3(static_cast<float>(this->mean[0]), static_cast<float>(this->mean[1]), static_cast<float>(this->mean[2]));
+    }
+
+    Mat3 Moments::covariance() const {
+        if(this->n == 0)
+            return Mat3();
+        double oon = 1.0 / static_cast<double>(this->n);
+        float e00 = static_cast<float>(this->m2[0] * oon), e11 = static_cast<float>(this->m2[1] * oon), e22 = static_cast<float>(this->m2[2] * oon);
+        float e01 = static_cast<float>(this->m2[3] * oon), e02 = static_cast<float>(this->m2[4] * oon), e12 = static_cast<float>(this->m2[5] * oon);
+        return Mat3(e00, e01, e02,
+                    e01, e11, e12,
+                    e02, e12, e22);
+    }
+}
@@ -0,0 +1,60 @@
+#include "../include/ParallelBroadphase.hh"
+#include <cmath>
+
+namespace Geometry {
+
+    void ParallelBroadphase::compute_bounds(const AABB& box, std::array<float, 3>& min, std::array<float, 3>& max) {
+        Point3D c = box.getCenter();
+        for(int i = 0; i < 3; ++i) {
+            min[i] = c[i] - box[i];
+            max[i] = c[i] + box[i];
+        }
+    }
+
+    void ParallelBroadphase::compute_bounds(const Sphere& sphere, std::array<float, 3>& min, std::array<float, 3>& max) {
+        Point3D c = sphere.getCenter();
+        float r = sphere.getRadius();
+        for(int i = 0; i < 3; ++i) {
+            min[i] = c[i] - r;
+            max[i] = c[i] + r;
+        }
+    }
+
+    void ParallelBroadphase::compute_bounds(const OBB& box, std::array<float, 3>& min, std::array<float, 3>& max) {
+        Point3D c = box.getCenter();
+        Point3D h = box.getHalfwidth();
+        Point3D u[3] = { box.getAxis(0), box.getAxis(1), box.getAxis(2) };
+        // World extent along axis i: sum of the projected halfwidths
+        for(int i = 0; i < 3; ++i) {
+            float r = std::abs(u[0][i]) * h[0] + std::abs(u[1][i]) * h[1] + std::abs(u[2][i]) * h[2];
+            min[i] = c[i] - r;
+            max[i] = c[i] + r;
+        }
+    }
+
+    void ParallelBroadphase::compute_bounds(const Capsule& capsule, std::array<float, 3>& min, std::array<float, 3>& max) {
+        Point3D s = capsule.getStart();
+        Point3D e = capsule.getEnd();
+        float r = capsule.getRadius();
+        for(int i = 0; i < 3; ++i) {
+            min[i] = std::min(s[i], e[i]) - r;
+            max[i] = std::max(s[i], e[i]) + r;
+        }
+    }
+
+    bool ParallelBroadphase::test_pair(const AABB& a, const AABB& b) {
+        return a.test_AABB_AABB_intersection(b);
+    }
+
+    bool ParallelBroadphase::test_pair(const Sphere& a, const Sphere& b) {
+        return a.test_sphere_sphere_intersection(b);
+    }
+
+    bool ParallelBroadphase::test_pair(const OBB& a, const OBB& b) {
+        return a.test_OBB_OBB_intersection(b);
+    }
+
+    bool ParallelBroadphase::test_pair(const Capsule& a, const Capsule& b) {
+        return a.test_capsule_intersection(b);
+    }
+}
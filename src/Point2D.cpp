@@ -62,8 +62,8 @@ namespace Geometry {
 
     const float& Point2D::operator[](int index) const {
         switch (index) {
-            case 0: return this->getX();
-            case 1: return this->getY();
+            case 0: return this->coordinates[0];
+            case 1: return this->coordinates[1];
             default: throw std::out_of_range("Index out of range");
         }
     }
@@ -70,9 +70,9 @@ namespace Geometry {
 
     const float& Point3D::operator[](int index) const {
         switch (index) {
-            case 0: return this->getX();
-            case 1: return this->getY();
-            case 2: return this->getZ();
+            case 0: return this->coordinates[0];
+            case 1: return this->coordinates[1];
+            case 2: return this->coordinate_z;
             default: throw std::out_of_range("Index out of range");
         }
     }
@@ -86,9 +86,9 @@ namespace Geometry {
     }
 
     Point3D& Point3D::operator*=(float scalar) {
-        this->setX(scalar + this->getX());
-        this->setY(scalar + this->getY());
-        this->setZ(scalar + this->getZ());
+        this->setX(scalar * this->getX());
+        this->setY(scalar * this->getY());
+        this->setZ(scalar * this->getZ());
         return *this;
     }
     
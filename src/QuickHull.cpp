@@ -1,10 +1,760 @@
 #include "../include/QuickHull.hh"
+#include <array>
+#include <stdexcept>
+#include <utility>
 
 namespace Geometry {
 
 
-    
+
     float QuickHull::cross_product(const Point2D& a, const Point2D& b, const Point2D& c) {
         return (b.getX() - a.getX()) * (c.getY() - a.getY()) - (b.getY() - a.getY()) * (c.getX() - a.getX());
     }
-}
\ No newline at end of file
+
+    namespace {
+
+        /**
+         * @brief Half-edge of the hull under construction; `origin` is an index of the input points.
+         */
+        struct BuildEdge {
+            int origin, twin, next, face;
+        };
+
+        /**
+         * @brief Triangle of the hull under construction, with its outside set: a linked list of points (through `HullBuilder3D::next_point`) and its farthest point. The plane is kept in double precision, see `HullBuilder3D::plane_tolerance`.
+         */
+        struct BuildFace {
+            int edge;
+            std::array<double, 3> normal;
+            double offset;
+            int outside;
+            int farthest;
+            double distance;
+            unsigned mark;
+            bool alive;
+        };
+
+        /**
+         * @brief Iterative 3D QuickHull. The faces and half-edges live in two arrays that only grow (removed faces are flagged), and the outside sets are linked lists over the input indices, so a point is never copied when it moves from a removed face to a new one.
+         */
+        class HullBuilder3D {
+        public:
+            const std::vector<Vec3>& points;
+            // Tolerance of the dimension tests of the initial simplex, at float precision
+            float tolerance;
+            // Tolerance of the visibility tests. The planes of the triangles are computed in double precision and the points are
+            // tested against them with this much smaller tolerance: with a float one, a point barely outside a long sliver face
+            // could be taken as coplanar with it, and the concave edges left that way grow from step to step until faces fold over
+            double plane_tolerance;
+            std::vector<BuildEdge> edges;
+            std::vector<BuildFace> faces;
+
+        private:
+            // Points per task of the parallel passes
+            static const std::size_t GRAIN = 4096;
+
+            ThreadPool* pool;
+            std::vector<int> next_point;
+            std::vector<unsigned> vertex_mark;
+            unsigned stamp;
+
+            // Faces whose outside set became non-empty, possibly removed since
+            std::vector<int> pending;
+
+            // Scratch buffers reused by every step
+            struct Frame {
+                int face, start, edge;
+                bool begun;
+            };
+            std::vector<Frame> stack;
+            std::vector<int> visible, horizon, orphans, new_faces;
+
+            // Faces and distances chosen for the orphans by the parallel passes
+            std::vector<int> chosen_face;
+            std::vector<double> chosen_distance;
+
+            // Number of blocks of `count` points: one unless there is a pool and enough work for it
+            std::size_t block_count(std::size_t count) const {
+                return this->pool != nullptr && this->pool->size() > 1 && count >= 2 * GRAIN ? (count + GRAIN - 1) / GRAIN : 1;
+            }
+
+            // Runs `body(block, first, last)` on the blocks of [0, `count`), on the pool if there are several
+            template <typename Body>
+            void for_blocks(std::size_t count, const Body& body) const {
+                std::size_t blocks = this->block_count(count);
+                if(blocks == 1) {
+                    body(0, 0, count);
+                    return;
+                }
+                this->pool->parallel_for(blocks, [&](std::size_t block, std::size_t) {
+                    body(block, block * GRAIN, std::min(count, (block + 1) * GRAIN));
+                });
+            }
+
+            int dest(int e) const {
+                return this->edges[this->edges[e].next].origin;
+            }
+
+            double distance(int f, int i) const {
+                const BuildFace& face = this->faces[f];
+                const Vec3& p = this->points[i];
+                return face.normal[0] * p.x + face.normal[1] * p.y + face.normal[2] * p.z - face.offset;
+            }
+
+            int add_face(int a, int b, int c) {
+                int f = static_cast<int>(this->faces.size()), e = static_cast<int>(this->edges.size());
+                this->edges.push_back({ a, -1, e + 1, f });
+                this->edges.push_back({ b, -1, e + 2, f });
+                this->edges.push_back({ c, -1, e, f });
+                // Normal from the two edges at the vertex opposite the longest one, the most accurate pair for sliver triangles
+                const Vec3* q[3] = { &this->points[a], &this->points[b], &this->points[c] };
+                double side[3][3], length[3];
+                for(int k = 0; k < 3; ++k) {
+                    const Vec3 &from = *q[k], &to = *q[(k + 1) % 3];
+                    side[k][0] = static_cast<double>(to.x) - from.x;
+                    side[k][1] = static_cast<double>(to.y) - from.y;
+                    side[k][2] = static_cast<double>(to.z) - from.z;
+                    length[k] = side[k][0] * side[k][0] + side[k][1] * side[k][1] + side[k][2] * side[k][2];
+                }
+                int longest = length[0] >= length[1] ? (length[0] >= length[2] ? 0 : 2) : (length[1] >= length[2] ? 1 : 2);
+                const double* u = side[(longest + 1) % 3];
+                const double* w = side[(longest + 2) % 3];
+                double n[3] = { u[1] * w[2] - u[2] * w[1], u[2] * w[0] - u[0] * w[2], u[0] * w[1] - u[1] * w[0] };
+                double norm = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+                BuildFace face;
+                face.edge = e;
+                face.offset = 0.0;
+                for(int k = 0; k < 3; ++k) {
+                    face.normal[k] = norm > 0.0 ? n[k] / norm : 0.0;
+                    face.offset += face.normal[k] * ((static_cast<double>((*q[0])[k]) + (*q[1])[k] + (*q[2])[k]) / 3.0);
+                }
+                face.outside = -1;
+                face.farthest = -1;
+                face.distance = 0.0;
+                face.mark = 0;
+                face.alive = true;
+                this->faces.push_back(face);
+                return f;
+            }
+
+            void link(int a, int b) {
+                this->edges[a].twin = b;
+                this->edges[b].twin = a;
+            }
+
+            // Candidate face point `i` is farthest outside of, by more than the tolerance, or -1
+            int best_face(int i, const int* candidates, std::size_t count, double& best_distance) const {
+                int best = -1;
+                best_distance = this->plane_tolerance;
+                for(std::size_t k = 0; k < count; ++k) {
+                    double d = this->distance(candidates[k], i);
+                    if(d > best_distance) {
+                        best_distance = d;
+                        best = candidates[k];
+                    }
+                }
+                return best;
+            }
+
+            // Adds point `i` to the outside set of face `best` (points outside of no face are dropped)
+            void link_point(int i, int best, double best_distance) {
+                if(best < 0)
+                    return;
+                BuildFace& f = this->faces[best];
+                if(f.outside < 0)
+                    this->pending.push_back(best);
+                this->next_point[i] = f.outside;
+                f.outside = i;
+                if(f.farthest < 0 || best_distance > f.distance) {
+                    f.farthest = i;
+                    f.distance = best_distance;
+                }
+            }
+
+            // Assigns the points `ids` to the candidate faces. With a pool, large sets choose their faces in parallel and are then linked in order, so the outside sets are the same as serially
+            void assign(const std::vector<int>& ids, const int* candidates, std::size_t count) {
+                if(this->block_count(ids.size()) == 1) {
+                    for(int i : ids) {
+                        double d;
+                        int best = this->best_face(i, candidates, count, d);
+                        this->link_point(i, best, d);
+                    }
+                    return;
+                }
+                this->chosen_face.resize(ids.size());
+                this->chosen_distance.resize(ids.size());
+                this->for_blocks(ids.size(), [&](std::size_t, std::size_t first, std::size_t last) {
+                    for(std::size_t k = first; k < last; ++k)
+                        this->chosen_face[k] = this->best_face(ids[k], candidates, count, this->chosen_distance[k]);
+                });
+                for(std::size_t k = 0; k < ids.size(); ++k)
+                    this->link_point(ids[k], this->chosen_face[k], this->chosen_distance[k]);
+            }
+
+            // Removes point `i` from the outside set of face `f`, updating its farthest point
+            void discard(int f, int i) {
+                BuildFace& face = this->faces[f];
+                int* link = &face.outside;
+                while(*link != i)
+                    link = &this->next_point[*link];
+                *link = this->next_point[i];
+                face.farthest = -1;
+                face.distance = 0.0;
+                for(int j = face.outside; j >= 0; j = this->next_point[j]) {
+                    double d = this->distance(f, j);
+                    if(face.farthest < 0 || d > face.distance) {
+                        face.farthest = j;
+                        face.distance = d;
+                    }
+                }
+            }
+
+            // Next face to process: the last pending one, or the one with the farthest outside point when the vertex count is limited
+            int next_face(bool farthest_first) {
+                if(!farthest_first) {
+                    while(!this->pending.empty()) {
+                        int f = this->pending.back();
+                        if(this->faces[f].alive && this->faces[f].outside >= 0)
+                            return f;
+                        this->pending.pop_back();
+                    }
+                    return -1;
+                }
+                int best = -1;
+                std::size_t kept = 0;
+                for(std::size_t k = 0; k < this->pending.size(); ++k) {
+                    int f = this->pending[k];
+                    if(!this->faces[f].alive || this->faces[f].outside < 0)
+                        continue;
+                    this->pending[kept++] = f;
+                    if(best < 0 || this->faces[f].distance > this->faces[best].distance)
+                        best = f;
+                }
+                this->pending.resize(kept);
+                return best;
+            }
+
+            // Collects the faces visible from `eye` (connected to `f`) and their horizon, counter-clockwise seen from the eye.
+            // It returns `false` if rounding made the horizon something else than a simple loop
+            bool find_horizon(int f, int eye) {
+                ++this->stamp;
+                this->visible.clear();
+                this->horizon.clear();
+                this->stack.clear();
+                this->faces[f].mark = this->stamp;
+                this->visible.push_back(f);
+                this->stack.push_back({ f, this->faces[f].edge, this->faces[f].edge, false });
+                while(!this->stack.empty()) {
+                    Frame& frame = this->stack.back();
+                    if(frame.begun && frame.edge == frame.start) {
+                        this->stack.pop_back();
+                        continue;
+                    }
+                    frame.begun = true;
+                    int e = frame.edge;
+                    frame.edge = this->edges[e].next;
+                    int twin = this->edges[e].twin;
+                    int g = this->edges[twin].face;
+                    if(this->faces[g].mark == this->stamp)
+                        continue;
+                    if(this->distance(g, eye) > this->plane_tolerance) {
+                        this->faces[g].mark = this->stamp;
+                        this->visible.push_back(g);
+                        int start = this->edges[twin].next;
+                        this->stack.push_back({ g, start, start, false });
+                    }
+                    else
+                        this->horizon.push_back(e);
+                }
+
+                std::size_t n = this->horizon.size();
+                if(n < 3)
+                    return false;
+                for(std::size_t i = 0; i < n; ++i) {
+                    int origin = this->edges[this->horizon[i]].origin;
+                    if(this->vertex_mark[origin] == this->stamp)
+                        return false;
+                    this->vertex_mark[origin] = this->stamp;
+                    if(this->dest(this->horizon[i]) != this->edges[this->horizon[(i + 1) % n]].origin)
+                        return false;
+                }
+                return true;
+            }
+
+            // Replaces the visible faces with the fan of `eye` over the horizon, and hands their outside sets to the new faces
+            void add_point(int eye) {
+                this->orphans.clear();
+                for(int g : this->visible) {
+                    this->faces[g].alive = false;
+                    for(int i = this->faces[g].outside; i >= 0; i = this->next_point[i])
+                        if(i != eye)
+                            this->orphans.push_back(i);
+                    this->faces[g].outside = -1;
+                }
+
+                this->new_faces.clear();
+                for(int h : this->horizon) {
+                    int f = this->add_face(this->edges[h].origin, this->dest(h), eye);
+                    this->link(this->faces[f].edge, this->edges[h].twin);
+                    this->new_faces.push_back(f);
+                }
+                std::size_t n = this->new_faces.size();
+                for(std::size_t i = 0; i < n; ++i) {
+                    // b_i -> eye of a face and eye -> a_(i+1) of the next one are the same edge
+                    int e = this->faces[this->new_faces[i]].edge + 1;
+                    int next = this->faces[this->new_faces[(i + 1) % n]].edge + 2;
+                    this->link(e, next);
+                }
+
+                this->assign(this->orphans, this->new_faces.data(), n);
+            }
+
+        public:
+            HullBuilder3D(const std::vector<Vec3>& points, ThreadPool* pool) : points(points), pool(pool), next_point(points.size(), -1), vertex_mark(points.size(), 0), stamp(0) {
+                // Tolerance for the orientation tests, from the magnitude of the coordinates (as in qhull)
+                std::vector<Vec3> extents(this->block_count(points.size()));
+                this->for_blocks(points.size(), [&](std::size_t block, std::size_t first, std::size_t last) {
+                    for(std::size_t i = first; i < last; ++i)
+                        for(int k = 0; k < 3; ++k)
+                            extents[block][k] = std::max(extents[block][k], std::abs(points[i][k]));
+                });
+                Vec3 extent;
+                for(const Vec3& e : extents)
+                    for(int k = 0; k < 3; ++k)
+                        extent[k] = std::max(extent[k], e[k]);
+                this->tolerance = 3.0f * std::numeric_limits<float>::epsilon() * (extent.x + extent.y + extent.z);
+                this->plane_tolerance = 3.0 * std::numeric_limits<double>::epsilon() * (static_cast<double>(extent.x) + extent.y + extent.z);
+            }
+
+            /**
+             * @brief Finds the initial simplex. It returns its dimension (0 to 3): for 3 `v` holds the tetrahedron, for 2 the triangle and `normal` its plane, for 1 the extreme points of the line, for 0 one point.
+             */
+            int initial_simplex(int v[4], Vec3& normal) const {
+                // Every search is a reduction over blocks of points, combined in block order with the same strict comparisons as a single scan
+                const std::vector<Vec3>& p = this->points;
+                std::size_t blocks = this->block_count(p.size());
+                std::vector<std::array<int, 6>> extremes(blocks);
+                this->for_blocks(p.size(), [&](std::size_t block, std::size_t first, std::size_t last) {
+                    int f = static_cast<int>(first);
+                    std::array<int, 6> e = {{ f, f, f, f, f, f }};
+                    for(std::size_t i = first + 1; i < last; ++i)
+                        for(int k = 0; k < 3; ++k) {
+                            if(p[i][k] < p[e[k]][k]) e[k] = static_cast<int>(i);
+                            if(p[i][k] > p[e[k + 3]][k]) e[k + 3] = static_cast<int>(i);
+                        }
+                    extremes[block] = e;
+                });
+                int lo[3] = { extremes[0][0], extremes[0][1], extremes[0][2] }, hi[3] = { extremes[0][3], extremes[0][4], extremes[0][5] };
+                for(std::size_t block = 1; block < blocks; ++block)
+                    for(int k = 0; k < 3; ++k) {
+                        if(p[extremes[block][k]][k] < p[lo[k]][k]) lo[k] = extremes[block][k];
+                        if(p[extremes[block][k + 3]][k] > p[hi[k]][k]) hi[k] = extremes[block][k + 3];
+                    }
+                int axis = 0;
+                for(int k = 1; k < 3; ++k)
+                    if(p[hi[k]][k] - p[lo[k]][k] > p[hi[axis]][axis] - p[lo[axis]][axis])
+                        axis = k;
+                v[0] = lo[axis];
+                v[1] = hi[axis];
+                if(p[v[1]][axis] - p[v[0]][axis] <= this->tolerance)
+                    return 0;
+
+                std::vector<std::pair<float, int>> farthest(blocks);
+                auto reduce = [&]() {
+                    std::pair<float, int> best = farthest[0];
+                    for(std::size_t block = 1; block < blocks; ++block)
+                        if(farthest[block].first > best.first)
+                            best = farthest[block];
+                    return best;
+                };
+
+                // Farthest point from the line
+                Vec3 u = p[v[1]] - p[v[0]];
+                u = u / std::sqrt(u * u);
+                this->for_blocks(p.size(), [&](std::size_t block, std::size_t first, std::size_t last) {
+                    std::pair<float, int> best(-1.0f, 0);
+                    for(std::size_t i = first; i < last; ++i) {
+                        Vec3 c = cross(p[i] - p[v[0]], u);
+                        if(c * c > best.first)
+                            best = std::make_pair(c * c, static_cast<int>(i));
+                    }
+                    farthest[block] = best;
+                });
+                std::pair<float, int> best = reduce();
+                v[2] = best.second;
+                if(std::sqrt(best.first) <= this->tolerance)
+                    return 1;
+
+                // Farthest point from the plane
+                normal = cross(p[v[1]] - p[v[0]], p[v[2]] - p[v[0]]);
+                normal = normal / std::sqrt(normal * normal);
+                this->for_blocks(p.size(), [&](std::size_t block, std::size_t first, std::size_t last) {
+                    std::pair<float, int> best(-1.0f, 0);
+                    for(std::size_t i = first; i < last; ++i) {
+                        float d = std::abs(normal * (p[i] - p[v[0]]));
+                        if(d > best.first)
+                            best = std::make_pair(d, static_cast<int>(i));
+                    }
+                    farthest[block] = best;
+                });
+                best = reduce();
+                v[3] = best.second;
+                if(best.first <= this->tolerance)
+                    return 2;
+                return 3;
+            }
+
+            /**
+             * @brief Runs QuickHull from the tetrahedron `v`, until no point is outside the hull or it has `max_vertices` vertices (0 for no limit).
+             */
+            void build(const int v[4], std::size_t max_vertices) {
+                // Orient the base away from the apex, then close the tetrahedron
+                int a = v[0], b = v[1], c = v[2], d = v[3];
+                Vec3 n = cross(this->points[b] - this->points[a], this->points[c] - this->points[a]);
+                if(n * (this->points[d] - this->points[a]) > 0.0f)
+                    std::swap(b, c);
+                int f[4] = { this->add_face(a, b, c), this->add_face(b, a, d), this->add_face(c, b, d), this->add_face(a, c, d) };
+                this->link(0, 3);
+                this->link(1, 6);
+                this->link(2, 9);
+                this->link(4, 11);
+                this->link(5, 7);
+                this->link(8, 10);
+
+                this->orphans.clear();
+                for(std::size_t i = 0; i < this->points.size(); ++i) {
+                    int k = static_cast<int>(i);
+                    if(k != a && k != b && k != c && k != d)
+                        this->orphans.push_back(k);
+                }
+                this->assign(this->orphans, f, 4);
+
+                std::size_t vertices = 4;
+                while(max_vertices == 0 || vertices < max_vertices) {
+                    int face = this->next_face(max_vertices != 0);
+                    if(face < 0)
+                        break;
+                    int eye = this->faces[face].farthest;
+                    if(!this->find_horizon(face, eye)) {
+                        // The point is within rounding of the hull: drop it
+                        this->discard(face, eye);
+                        continue;
+                    }
+                    this->add_point(eye);
+                    ++vertices;
+                }
+            }
+
+            /**
+             * @brief Groups the triangles of the hull into convex polygons: `cluster` receives the polygon of every face (-1 for the removed ones) and the number of polygons is returned. The triangles connected to a seed whose vertices lie on its plane are gathered, and they are merged only if the result is a convex polygon: its boundary is a single loop through distinct vertices, it turns left at every corner and the faces across its edges do not rise above the plane; otherwise they are kept as triangles. All the tests are made in double precision against `plane_tolerance`, so only triangles that are coplanar up to rounding are merged: with a looser tolerance the polygons can be slightly non-convex, and the hill climbing of `ConvexHull::support_index`, which walks the polygon edges only, stops at their reflex corners.
+             */
+            int merge_coplanar(std::vector<int>& cluster) const {
+                cluster.assign(this->faces.size(), -1);
+                std::vector<int> vertex_cluster(this->points.size(), -1), members, boundary;
+                int clusters = 0;
+
+                for(int pass = 0; pass < 2; ++pass)
+                    for(std::size_t seed = 0; seed < this->faces.size(); ++seed) {
+                        const BuildFace& face = this->faces[seed];
+                        if(!face.alive || cluster[seed] >= 0 || (pass == 0 && face.normal[0] == 0.0 && face.normal[1] == 0.0 && face.normal[2] == 0.0))
+                            continue;
+                        int id = clusters++;
+                        cluster[seed] = id;
+                        if(pass == 1)
+                            continue;
+
+                        // The connected triangles on the plane of the seed, and the half-edges on the boundary of their union
+                        int plane = static_cast<int>(seed);
+                        members.assign(1, plane);
+                        boundary.clear();
+                        for(std::size_t m = 0; m < members.size(); ++m)
+                            for(int k = 0, e = this->faces[members[m]].edge; k < 3; ++k, e = this->edges[e].next) {
+                                int h = this->edges[this->edges[e].twin].face;
+                                if(cluster[h] == id)
+                                    continue;
+                                if(cluster[h] < 0 && std::abs(this->distance(plane, this->dest(this->edges[this->edges[e].twin].next))) <= this->plane_tolerance) {
+                                    cluster[h] = id;
+                                    members.push_back(h);
+                                }
+                                else
+                                    boundary.push_back(e);
+                            }
+                        if(members.size() == 1)
+                            continue;
+                        // Half-edges gathered before their far side joined are not on the boundary
+                        std::size_t kept = 0;
+                        for(int e : boundary)
+                            if(cluster[this->edges[this->edges[e].twin].face] != id)
+                                boundary[kept++] = e;
+                        boundary.resize(kept);
+
+                        // Walk the boundary from one of its half-edges, rotating around each end vertex through the gathered triangles
+                        auto following = [&](int e) {
+                            int next = this->edges[e].next;
+                            while(cluster[this->edges[this->edges[next].twin].face] == id)
+                                next = this->edges[this->edges[next].twin].next;
+                            return next;
+                        };
+                        const std::array<double, 3>& n = face.normal;
+                        bool convex = true;
+                        std::size_t length = 0;
+                        int e = boundary[0];
+                        do {
+                            int next = following(e);
+                            int v = this->dest(e);
+                            if(vertex_cluster[v] == id || ++length > boundary.size()) {
+                                convex = false;
+                                break;
+                            }
+                            vertex_cluster[v] = id;
+                            // Left turn at v, from the direction of `e` to the one of `next`, and the face across `e` below the plane
+                            const Vec3 &o = this->points[this->edges[e].origin], &pv = this->points[v], &q = this->points[this->dest(next)];
+                            double u[3] = { static_cast<double>(pv.x) - o.x, static_cast<double>(pv.y) - o.y, static_cast<double>(pv.z) - o.z };
+                            double w[3] = { static_cast<double>(q.x) - pv.x, static_cast<double>(q.y) - pv.y, static_cast<double>(q.z) - pv.z };
+                            double turn = (n[1] * u[2] - n[2] * u[1]) * w[0] + (n[2] * u[0] - n[0] * u[2]) * w[1] + (n[0] * u[1] - n[1] * u[0]) * w[2];
+                            convex = turn >= -this->plane_tolerance * std::sqrt(u[0] * u[0] + u[1] * u[1] + u[2] * u[2]);
+                            convex = convex && this->distance(plane, this->dest(this->edges[this->edges[e].twin].next)) <= this->plane_tolerance;
+                            e = next;
+                        } while(convex && e != boundary[0]);
+                        if(convex && length == boundary.size())
+                            continue;
+
+                        // Not a convex polygon with a single boundary: keep the triangles
+                        for(std::size_t m = 1; m < members.size(); ++m)
+                            cluster[members[m]] = clusters++;
+                    }
+                return clusters;
+            }
+        };
+
+        // Support function: Newell normal and offset of the polygon `polygon` of `vertices`
+        static void polygon_plane(const std::vector<Vec3>& vertices, const std::vector<int>& polygon, Vec3& normal, float& offset) {
+            Vec3 c;
+            for(int v : polygon)
+                c += vertices[v];
+            c = c / static_cast<float>(polygon.size());
+            Vec3 n;
+            for(std::size_t i = 0; i < polygon.size(); ++i)
+                n += cross(vertices[polygon[i]] - c, vertices[polygon[(i + 1) % polygon.size()]] - c);
+            float length = std::sqrt(n * n);
+            normal = length > 0.0f ? n / length : Vec3();
+            offset = normal * c;
+        }
+    }
+
+    ConvexHull QuickHull::quick_hull_3D(const std::vector<Vec3>& points, std::size_t max_vertices) {
+        return QuickHull::build_hull_3D(points, nullptr, max_vertices);
+    }
+
+    ConvexHull QuickHull::quick_hull_3D(const std::vector<Vec3>& points, ThreadPool& pool, std::size_t max_vertices) {
+        return QuickHull::build_hull_3D(points, &pool, max_vertices);
+    }
+
+    ConvexHull QuickHull::build_hull_3D(const std::vector<Vec3>& points, ThreadPool* pool, std::size_t max_vertices) {
+        if(max_vertices > 0 && max_vertices < 4)
+            throw std::invalid_argument("A 3D hull needs at least 4 vertices");
+        ConvexHull hull;
+        if(points.empty())
+            return hull;
+
+        HullBuilder3D builder(points, pool);
+        int v[4] = { 0, 0, 0, 0 };
+        Vec3 plane;
+        int dimension = builder.initial_simplex(v, plane);
+
+        if(dimension == 0) {
+            hull.vertices.push_back(points[v[0]]);
+            hull.vertex_edge.push_back(-1);
+            return hull;
+        }
+
+        if(dimension == 1) {
+            hull.vertices.push_back(points[v[0]]);
+            hull.vertices.push_back(points[v[1]]);
+            hull.vertex_edge.assign(2, -1);
+            return hull;
+        }
+
+        if(dimension == 2) {
+            // Flat hull: 2D hull (monotone chain) in a basis of the plane, counter-clockwise around `plane`
+            Vec3 u = points[v[1]] - points[v[0]];
+            u = u / std::sqrt(u * u);
+            Vec3 w = cross(plane, u);
+            std::vector<std::pair<std::pair<float, float>, int>> projected(points.size());
+            for(std::size_t i = 0; i < points.size(); ++i) {
+                Vec3 d = points[i] - points[v[0]];
+                projected[i] = std::make_pair(std::make_pair(d * u, d * w), static_cast<int>(i));
+            }
+            std::sort(projected.begin(), projected.end());
+            auto turn = [&](int o, int a, int b) {
+                const std::pair<float, float> &po = projected[o].first, &pa = projected[a].first, &pb = projected[b].first;
+                return (pa.first - po.first) * (pb.second - po.second) - (pa.second - po.second) * (pb.first - po.first);
+            };
+            std::vector<int> chain;
+            for(int pass = 0; pass < 2; ++pass) {
+                std::size_t base = chain.size();
+                for(std::size_t k = 0; k < projected.size(); ++k) {
+                    int i = pass == 0 ? static_cast<int>(k) : static_cast<int>(projected.size() - 1 - k);
+                    while(chain.size() >= base + 2 && turn(chain[chain.size() - 2], chain.back(), i) <= 0.0f)
+                        chain.pop_back();
+                    chain.push_back(i);
+                }
+                // The last point of a pass is the first of the other one
+                chain.pop_back();
+            }
+
+            if(max_vertices > 0 && chain.size() > max_vertices) {
+                // Same order as the 3D construction: from the extreme points along u, add the vertex farthest from the polygon kept so far
+                std::size_t last = 0;
+                for(std::size_t k = 1; k < chain.size(); ++k)
+                    if(projected[chain[k]].first.first > projected[chain[last]].first.first)
+                        last = k;
+                std::vector<std::size_t> kept = { 0, last };
+                while(kept.size() < max_vertices) {
+                    std::size_t best = 0, slot = 0;
+                    float best_distance = 0.0f;
+                    for(std::size_t j = 0; j < kept.size(); ++j) {
+                        // The vertices between two kept ones are on the outer side of their chord
+                        std::size_t from = kept[j], to = j + 1 < kept.size() ? kept[j + 1] : kept[0] + chain.size();
+                        const std::pair<float, float> &pa = projected[chain[from]].first, &pb = projected[chain[to % chain.size()]].first;
+                        float length = std::sqrt((pb.first - pa.first) * (pb.first - pa.first) + (pb.second - pa.second) * (pb.second - pa.second));
+                        for(std::size_t k = from + 1; k < to; ++k) {
+                            float d = -turn(chain[from], chain[to % chain.size()], chain[k]) / length;
+                            if(d > best_distance) {
+                                best_distance = d;
+                                best = k;
+                                slot = j + 1;
+                            }
+                        }
+                    }
+                    if(best_distance <= 0.0f)
+                        break;
+                    kept.insert(kept.begin() + slot, best);
+                }
+                std::vector<int> limited;
+                for(std::size_t k : kept)
+                    limited.push_back(chain[k]);
+                chain.swap(limited);
+            }
+
+            int n = static_cast<int>(chain.size());
+            for(int i : chain)
+                hull.vertices.push_back(points[projected[i].second]);
+            hull.vertex_edge.resize(n);
+            for(int i = 0; i < n; ++i) {
+                hull.edges.push_back({ i, n + i, (i + 1) % n, 0 });
+                hull.vertex_edge[i] = i;
+            }
+            for(int i = 0; i < n; ++i)
+                hull.edges.push_back({ (i + 1) % n, i, n + (i + n - 1) % n, 1 });
+            float offset = plane * hull.vertices[0];
+            hull.faces.push_back({ 0, plane, offset });
+            hull.faces.push_back({ n, -plane, -offset });
+            return hull;
+        }
+
+        builder.build(v, max_vertices);
+        const std::vector<BuildEdge>& edges = builder.edges;
+        const std::vector<BuildFace>& faces = builder.faces;
+
+        // Merge the coplanar triangles into convex polygons
+        std::vector<int> cluster;
+        int clusters = builder.merge_coplanar(cluster);
+
+        // The half-edges between different polygons are the half-edges of the hull
+        std::vector<int> edge_map(edges.size(), -1), vertex_map(points.size(), -1);
+        hull.faces.assign(clusters, ConvexHull::Face{ -1, Vec3(), 0.0f });
+        for(std::size_t f = 0; f < faces.size(); ++f) {
+            if(!faces[f].alive)
+                continue;
+            int e = faces[f].edge;
+            for(int k = 0; k < 3; ++k, e = edges[e].next) {
+                if(cluster[edges[edges[e].twin].face] == cluster[f])
+                    continue;
+                int origin = edges[e].origin;
+                if(vertex_map[origin] < 0) {
+                    vertex_map[origin] = static_cast<int>(hull.vertices.size());
+                    hull.vertices.push_back(points[origin]);
+                }
+                edge_map[e] = static_cast<int>(hull.edges.size());
+                hull.edges.push_back({ vertex_map[origin], -1, -1, cluster[f] });
+                if(hull.faces[cluster[f]].edge < 0)
+                    hull.faces[cluster[f]].edge = edge_map[e];
+            }
+        }
+        for(std::size_t e = 0; e < edges.size(); ++e) {
+            if(edge_map[e] < 0)
+                continue;
+            // Rotate around the end vertex through the merged triangles until the next boundary half-edge
+            int next = edges[e].next;
+            while(edge_map[next] < 0)
+                next = edges[edges[next].twin].next;
+            hull.edges[edge_map[e]].next = edge_map[next];
+            hull.edges[edge_map[e]].twin = edge_map[edges[e].twin];
+        }
+
+        // Remove the vertices left in the middle of a straight edge between two polygons (exactly two edges leave them, and they lie on the line through their two neighbours)
+        std::vector<ConvexHull::HalfEdge>& out = hull.edges;
+        std::vector<int> degree(hull.vertices.size(), 0), leaving(hull.vertices.size(), -1);
+        for(std::size_t e = 0; e < out.size(); ++e) {
+            ++degree[out[e].origin];
+            leaving[out[e].origin] = static_cast<int>(e);
+        }
+        std::vector<bool> dead_edge(out.size(), false), dead_vertex(hull.vertices.size(), false);
+        for(std::size_t vertex = 0; vertex < hull.vertices.size(); ++vertex) {
+            if(degree[vertex] != 2)
+                continue;
+            int o1 = leaving[vertex];
+            int b = out[o1].twin;
+            int o2 = out[b].next;
+            int a = out[o2].twin;
+            // Keep the polygons at least triangles
+            if(out[out[o1].next].next == a || out[out[o2].next].next == b)
+                continue;
+            const Vec3& u = hull.vertices[out[out[o1].next].origin];
+            const Vec3& w = hull.vertices[out[out[o2].next].origin];
+            const Vec3& p = hull.vertices[vertex];
+            double line[3] = { static_cast<double>(w.x) - u.x, static_cast<double>(w.y) - u.y, static_cast<double>(w.z) - u.z };
+            double to[3] = { static_cast<double>(p.x) - u.x, static_cast<double>(p.y) - u.y, static_cast<double>(p.z) - u.z };
+            double side[3] = { line[1] * to[2] - line[2] * to[1], line[2] * to[0] - line[0] * to[2], line[0] * to[1] - line[1] * to[0] };
+            double squared = line[0] * line[0] + line[1] * line[1] + line[2] * line[2];
+            if(side[0] * side[0] + side[1] * side[1] + side[2] * side[2] > builder.plane_tolerance * builder.plane_tolerance * squared)
+                continue;
+            out[a].next = out[o1].next;
+            out[b].next = out[o2].next;
+            out[a].twin = b;
+            out[b].twin = a;
+            dead_edge[o1] = dead_edge[o2] = true;
+            dead_vertex[vertex] = true;
+            hull.faces[out[a].face].edge = a;
+            hull.faces[out[b].face].edge = b;
+        }
+        std::vector<int> new_vertex(hull.vertices.size(), -1), new_edge(out.size(), -1);
+        std::size_t vertex_count = 0, edge_count = 0;
+        for(std::size_t i = 0; i < hull.vertices.size(); ++i)
+            if(!dead_vertex[i]) {
+                new_vertex[i] = static_cast<int>(vertex_count);
+                hull.vertices[vertex_count++] = hull.vertices[i];
+            }
+        for(std::size_t e = 0; e < out.size(); ++e)
+            if(!dead_edge[e])
+                new_edge[e] = static_cast<int>(edge_count++);
+        for(std::size_t e = 0; e < out.size(); ++e)
+            if(!dead_edge[e]) {
+                ConvexHull::HalfEdge h = out[e];
+                out[new_edge[e]] = { new_vertex[h.origin], new_edge[h.twin], new_edge[h.next], h.face };
+            }
+        hull.vertices.resize(vertex_count);
+        out.resize(edge_count);
+
+        hull.vertex_edge.assign(vertex_count, -1);
+        for(std::size_t e = 0; e < out.size(); ++e)
+            hull.vertex_edge[out[e].origin] = static_cast<int>(e);
+        for(std::size_t f = 0; f < hull.faces.size(); ++f) {
+            ConvexHull::Face& face = hull.faces[f];
+            face.edge = new_edge[face.edge];
+            polygon_plane(hull.vertices, hull.face_vertices(f), face.normal, face.offset);
+        }
+        return hull;
+    }
+}
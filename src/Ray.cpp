@@ -0,0 +1,223 @@
+#include "../include/Ray.hh"
+#include "../include/GeometricUtils.hh"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace Geometry {
+
+    // Support function: unit vector along v, or `fallback` when v is (almost) null
+    static inline Vec3 normalize_or(const Vec3& v, const Vec3& fallback) {
+        float len2 = v * v;
+        return len2 > 0.0f ? v / std::sqrt(len2) : fallback;
+    }
+
+    // Support function: distance of the first entry of the ray (o, d), d unit, into the
+    // sphere (c, r). The origin is assumed to be outside the sphere
+    static inline bool ray_sphere(const Vec3& o, const Vec3& d, const Vec3& c, float r, float& t) {
+        Vec3 m = o - c;
+        float b = m * d;
+        float k = m * m - r * r;
+        // Exit if the origin is outside the sphere and the ray points away from it
+        if(k > 0.0f && b > 0.0f)
+            return false;
+        float disc = b * b - k;
+        // A negative discriminant corresponds to the ray missing the sphere
+        if(disc < 0.0f)
+            return false;
+        t = -b - std::sqrt(disc);
+        return true;
+    }
+
+    Ray::Ray(const Vec3& origin, const Vec3& direction, float max_distance) : origin(origin) {
+        float len2 = direction * direction;
+        if(!(len2 > 0.0f))
+            throw std::invalid_argument("Ray direction must not be the null vector");
+        this->direction = direction / std::sqrt(len2);
+        this->setMaxDistance(max_distance);
+    }
+
+    Ray::Ray(const Point3D& origin, const Point3D& direction, float max_distance) : Ray(Vec3(origin), Vec3(direction), max_distance) {}
+
+    Vec3 Ray::getOrigin() const {
+        return this->origin;
+    }
+
+    Vec3 Ray::getDirection() const {
+        return this->direction;
+    }
+
+    float Ray::getMaxDistance() const {
+        return this->max_distance;
+    }
+
+    void Ray::setMaxDistance(float max_distance) {
+        if(!(max_distance >= 0.0f))
+            throw std::invalid_argument("Ray maximum distance must be non-negative");
+        this->max_distance = max_distance;
+    }
+
+    Vec3 Ray::at(float t) const {
+        return this->origin + this->direction * t;
+    }
+
+    bool Ray::intersect(const Sphere& sphere, RayHit& hit) const {
+        Vec3 c(sphere.getCenter());
+        float r = sphere.getRadius();
+        Vec3 m = this->origin - c;
+        if(m * m - r * r <= 0.0f) {
+            // Origin inside the sphere
+            hit.distance = 0.0f;
+            hit.normal = -this->direction;
+            return true;
+        }
+        float t;
+        if(!ray_sphere(this->origin, this->direction, c, r, t) || t > this->max_distance)
+            return false;
+        hit.distance = t;
+        hit.normal = normalize_or(this->at(t) - c, -this->direction);
+        return true;
+    }
+
+    bool Ray::intersect_slabs(const Vec3& center, const Vec3 axes[3], const Vec3& halfwidth, float& t, int& axis, float& sign) const {
+        const float epsilon = std::numeric_limits<float>::epsilon();
+        Vec3 p = this->origin - center;
+        float tmin = 0.0f, tmax = this->max_distance;
+        axis = -1;
+        sign = 0.0f;
+        for(int i = 0; i < 3; ++i) {
+            float o = p * axes[i];
+            float d = this->direction * axes[i];
+            float e = halfwidth[i];
+            if(std::abs(d) < epsilon) {
+                // Ray parallel to the slab: no hit if the origin is not within it
+                if(o < -e || o > e)
+                    return false;
+                continue;
+            }
+            // Distances of the ray entering and exiting the slab
+            float ood = 1.0f / d;
+            float t1 = (-e - o) * ood;
+            float t2 = (e - o) * ood;
+            float s = -1.0f;
+            if(t1 > t2) {
+                std::swap(t1, t2);
+                s = 1.0f;
+            }
+            if(t1 > tmin) {
+                tmin = t1;
+                axis = i;
+                sign = s;
+            }
+            if(t2 < tmax)
+                tmax = t2;
+            // Exit as soon as the slab intersection becomes empty
+            if(tmin > tmax)
+                return false;
+        }
+        t = tmin;
+        return true;
+    }
+
+    bool Ray::intersect(const AABB& box, RayHit& hit) const {
+        static const Vec3 axes[3] = { Vec3(1, 0, 0), Vec3(0, 1, 0), Vec3(0, 0, 1) };
+        float t, sign;
+        int axis;
+        if(!this->intersect_slabs(Vec3(box.getCenter()), axes, Vec3(box[0], box[1], box[2]), t, axis, sign))
+            return false;
+        hit.distance = t;
+        hit.normal = axis < 0 ? -this->direction : axes[axis] * sign;
+        return true;
+    }
+
+    bool Ray::intersect(const OBB& box, RayHit& hit) const {
+        Vec3 axes[3] = { Vec3(box.getAxis(0)), Vec3(box.getAxis(1)), Vec3(box.getAxis(2)) };
+        float t, sign;
+        int axis;
+        if(!this->intersect_slabs(Vec3(box.getCenter()), axes, Vec3(box.getHalfwidth()), t, axis, sign))
+            return false;
+        hit.distance = t;
+        hit.normal = axis < 0 ? -this->direction : axes[axis] * sign;
+        return true;
+    }
+
+    bool Ray::intersect(const Capsule& capsule, RayHit& hit) const {
+        const float epsilon = std::numeric_limits<float>::epsilon();
+        Vec3 p(capsule.getStart()), q(capsule.getEnd());
+        float r = capsule.getRadius();
+        if(GeometryUtils::sq_dist_point_segment(p, q, this->origin) <= r * r) {
+            // Origin inside the capsule
+            hit.distance = 0.0f;
+            hit.normal = -this->direction;
+            return true;
+        }
+
+        float best = std::numeric_limits<float>::infinity();
+        Vec3 normal;
+
+        // Cylinder wall: solve |(x - p) x axis|^2 = r^2 |axis|^2 for x = o + t*d,
+        // keeping only the hits whose projection falls between the two caps
+        Vec3 axis = q - p, m = this->origin - p;
+        float dd = axis * axis, nd = this->direction * axis, md = m * axis;
+        float a = dd - nd * nd;
+        if(dd > epsilon && a > epsilon * dd) {
+            float k = m * m - r * r;
+            float c = dd * k - md * md;
+            float b = dd * (m * this->direction) - nd * md;
+            float disc = b * b - a * c;
+            if(disc >= 0.0f) {
+                float t = (-b - std::sqrt(disc)) / a;
+                float s = md + t * nd;
+                if(t >= 0.0f && s >= 0.0f && s <= dd) {
+                    best = t;
+                    normal = normalize_or(this->at(t) - (p + axis * (s / dd)), -this->direction);
+                }
+            }
+        }
+
+        // End caps
+        const Vec3 caps[2] = { p, q };
+        for(int i = 0; i < 2; ++i) {
+            float t;
+            if(ray_sphere(this->origin, this->direction, caps[i], r, t) && t < best) {
+                best = t;
+                normal = normalize_or(this->at(t) - caps[i], -this->direction);
+            }
+        }
+
+        if(best == std::numeric_limits<float>::infinity() || best > this->max_distance)
+            return false;
+        hit.distance = best;
+        hit.normal = normal;
+        return true;
+    }
+
+    bool Ray::intersect(const Triangle& triangle, RayHit& hit) const {
+        const float epsilon = std::numeric_limits<float>::epsilon();
+        Vec3 a(triangle.getA()), b(triangle.getB()), c(triangle.getC());
+        Vec3 e1 = b - a, e2 = c - a;
+        Vec3 n = cross(e1, e2);
+        Vec3 pv = cross(this->direction, e2);
+        float det = e1 * pv;
+        // Ray parallel to the plane of the triangle, or degenerate triangle
+        if(std::abs(det) <= epsilon * std::sqrt(n * n))
+            return false;
+        float inv = 1.0f / det;
+        // Barycentric coordinates (u, v) of the hit point
+        Vec3 s = this->origin - a;
+        float u = (s * pv) * inv;
+        if(u < 0.0f || u > 1.0f)
+            return false;
+        Vec3 qv = cross(s, e1);
+        float v = (this->direction * qv) * inv;
+        if(v < 0.0f || u + v > 1.0f)
+            return false;
+        float t = (e2 * qv) * inv;
+        if(t < 0.0f || t > this->max_distance)
+            return false;
+        n = n / std::sqrt(n * n);
+        hit.distance = t;
+        hit.normal = (n * this->direction) > 0.0f ? -n : n;
+        return true;
+    }
+}
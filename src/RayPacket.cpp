@@ -0,0 +1,148 @@
+#include "../include/RayPacket.hh"
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace Geometry {
+
+    RayPacket::RayPacket() {
+        this->clear();
+    }
+
+    std::size_t RayPacket::add(const Ray& ray) {
+        if(this->count == LANES)
+            throw std::length_error("RayPacket is full");
+        Vec3 o = ray.getOrigin(), d = ray.getDirection();
+        for(int i = 0; i < 3; ++i) {
+            this->origin[i][this->count] = o[i];
+            this->direction[i][this->count] = d[i];
+        }
+        this->max_distance[this->count] = ray.getMaxDistance();
+        return this->count++;
+    }
+
+    Ray RayPacket::get(std::size_t lane) const {
+        if(lane >= this->count)
+            throw std::out_of_range("Index out of range");
+        return Ray(Vec3(this->origin[0][lane], this->origin[1][lane], this->origin[2][lane]),
+                   Vec3(this->direction[0][lane], this->direction[1][lane], this->direction[2][lane]),
+                   this->max_distance[lane]);
+    }
+
+    void RayPacket::setMaxDistance(std::size_t lane, float max_distance) {
+        if(lane >= this->count)
+            throw std::out_of_range("Index out of range");
+        if(!(max_distance >= 0.0f))
+            throw std::invalid_argument("Ray maximum distance must be non-negative");
+        this->max_distance[lane] = max_distance;
+    }
+
+    void RayPacket::clear() {
+        // Unused lanes hold a valid ray, so that the kernels never divide by zero
+        for(std::size_t l = 0; l < LANES; ++l) {
+            for(int i = 0; i < 3; ++i) {
+                this->origin[i][l] = 0.0f;
+                this->direction[i][l] = (i == 0) ? 1.0f : 0.0f;
+            }
+            this->max_distance[l] = 0.0f;
+        }
+        this->count = 0;
+    }
+
+    std::size_t RayPacket::size() const {
+        return this->count;
+    }
+
+    std::uint32_t RayPacket::active_mask() const {
+        return (1u << this->count) - 1u;
+    }
+
+    std::uint32_t RayPacket::intersect(const Sphere& sphere, float* distance) const {
+        Vec3 c(sphere.getCenter());
+        float r2 = sphere.getRadius() * sphere.getRadius();
+
+        // Same steps of Ray::intersect, with the early exits turned into lane selects
+        std::uint32_t mask = 0;
+        for(std::size_t l = 0; l < LANES; ++l) {
+            float mx = this->origin[0][l] - c.x, my = this->origin[1][l] - c.y, mz = this->origin[2][l] - c.z;
+            float b = mx * this->direction[0][l] + my * this->direction[1][l] + mz * this->direction[2][l];
+            float k = mx * mx + my * my + mz * mz - r2;
+            float disc = b * b - k;
+            float t = -b - std::sqrt(disc > 0.0f ? disc : 0.0f);
+            bool inside = k <= 0.0f;
+            bool hit = inside | (!((k > 0.0f) & (b > 0.0f)) & (disc >= 0.0f) & (t <= this->max_distance[l]));
+            if(distance != nullptr)
+                distance[l] = inside ? 0.0f : t;
+            mask |= static_cast<std::uint32_t>(hit) << l;
+        }
+        return mask & this->active_mask();
+    }
+
+    std::uint32_t RayPacket::intersect_slabs(const Vec3& center, const Vec3 axes[3], const Vec3& halfwidth, float* distance) const {
+        const float epsilon = std::numeric_limits<float>::epsilon();
+        const float infinity = std::numeric_limits<float>::infinity();
+
+        std::uint32_t mask = 0;
+        for(std::size_t l = 0; l < LANES; ++l) {
+            float px = this->origin[0][l] - center.x, py = this->origin[1][l] - center.y, pz = this->origin[2][l] - center.z;
+            float tmin = 0.0f, tmax = this->max_distance[l];
+            bool miss = false;
+            for(int i = 0; i < 3; ++i) {
+                float o = px * axes[i].x + py * axes[i].y + pz * axes[i].z;
+                float d = this->direction[0][l] * axes[i].x + this->direction[1][l] * axes[i].y + this->direction[2][l] * axes[i].z;
+                float e = halfwidth[i];
+                // A lane parallel to the slab misses if its origin is outside it, and is not clipped otherwise
+                bool parallel = std::abs(d) < epsilon;
+                float ood = 1.0f / (parallel ? 1.0f : d);
+                float t1 = (-e - o) * ood, t2 = (e - o) * ood;
+                float lo = parallel ? -infinity : (t1 < t2 ? t1 : t2);
+                float hi = parallel ? infinity : (t1 < t2 ? t2 : t1);
+                miss |= parallel & ((o < -e) | (o > e));
+                tmin = lo > tmin ? lo : tmin;
+                tmax = hi < tmax ? hi : tmax;
+            }
+            if(distance != nullptr)
+                distance[l] = tmin;
+            mask |= static_cast<std::uint32_t>(!miss & (tmin <= tmax)) << l;
+        }
+        return mask & this->active_mask();
+    }
+
+    std::uint32_t RayPacket::intersect(const AABB& box, float* distance) const {
+        static const Vec3 axes[3] = { Vec3(1, 0, 0), Vec3(0, 1, 0), Vec3(0, 0, 1) };
+        return this->intersect_slabs(Vec3(box.getCenter()), axes, Vec3(box[0], box[1], box[2]), distance);
+    }
+
+    std::uint32_t RayPacket::intersect(const OBB& box, float* distance) const {
+        Vec3 axes[3] = { Vec3(box.getAxis(0)), Vec3(box.getAxis(1)), Vec3(box.getAxis(2)) };
+        return this->intersect_slabs(Vec3(box.getCenter()), axes, Vec3(box.getHalfwidth()), distance);
+    }
+
+    std::uint32_t RayPacket::intersect(const Triangle& triangle, float* distance) const {
+        const float epsilon = std::numeric_limits<float>::epsilon();
+        // The edges are shared by all the lanes
+        Vec3 a(triangle.getA());
+        Vec3 e1 = Vec3(triangle.getB()) - a, e2 = Vec3(triangle.getC()) - a;
+        Vec3 n = cross(e1, e2);
+        float min_det = epsilon * std::sqrt(n * n);
+
+        std::uint32_t mask = 0;
+        for(std::size_t l = 0; l < LANES; ++l) {
+            Vec3 d(this->direction[0][l], this->direction[1][l], this->direction[2][l]);
+            Vec3 s(this->origin[0][l] - a.x, this->origin[1][l] - a.y, this->origin[2][l] - a.z);
+            Vec3 pv = cross(d, e2);
+            float det = e1 * pv;
+            bool valid = std::abs(det) > min_det;
+            float inv = 1.0f / (valid ? det : 1.0f);
+            Vec3 qv = cross(s, e1);
+            float u = (s * pv) * inv;
+            float v = (d * qv) * inv;
+            float t = (e2 * qv) * inv;
+            bool hit = valid & (u >= 0.0f) & (u <= 1.0f) & (v >= 0.0f) & (u + v <= 1.0f) & (t >= 0.0f) & (t <= this->max_distance[l]);
+            if(distance != nullptr)
+                distance[l] = t;
+            mask |= static_cast<std::uint32_t>(hit) << l;
+        }
+        return mask & this->active_mask();
+    }
+}
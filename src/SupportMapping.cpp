@@ -0,0 +1,127 @@
+#include "../include/SupportMapping.hh"
+#include <cmath>
+#include <stdexcept>
+
+namespace Geometry {
+
+    // Support function: offset of length `radius` along `direction` (null if the direction is null)
+    static inline Vec3 radial_offset(const Vec3& direction, float radius) {
+        float len2 = direction * direction;
+        return len2 > 0.0f ? direction * (radius / std::sqrt(len2)) : Vec3();
+    }
+
+    SphereSupport::SphereSupport(const Sphere& sphere) : center(sphere.getCenter()), radius(sphere.getRadius()) {}
+
+    Vec3 SphereSupport::support(const Vec3& direction) const {
+        return this->center + radial_offset(direction, this->radius);
+    }
+
+    Vec3 SphereSupport::getCenter() const {
+        return this->center;
+    }
+
+    CapsuleSupport::CapsuleSupport(const Capsule& capsule) : start(capsule.getStart()), end(capsule.getEnd()), radius(capsule.getRadius()) {}
+
+    Vec3 CapsuleSupport::support(const Vec3& direction) const {
+        const Vec3& p = (direction * this->start >= direction * this->end) ? this->start : this->end;
+        return p + radial_offset(direction, this->radius);
+    }
+
+    Vec3 CapsuleSupport::getCenter() const {
+        return (this->start + this->end) * 0.5f;
+    }
+
+    LozengeSupport::LozengeSupport(const Lozenge& lozenge) : origin(lozenge.getCenter()), radius(lozenge.getRadius()) {
+        this->edge[0] = Vec3(lozenge.getEdge(0));
+        this->edge[1] = Vec3(lozenge.getEdge(1));
+    }
+
+    Vec3 LozengeSupport::support(const Vec3& direction) const {
+        Vec3 p = this->origin;
+        for(int i = 0; i < 2; ++i)
+            if(direction * this->edge[i] > 0.0f)
+                p += this->edge[i];
+        return p + radial_offset(direction, this->radius);
+    }
+
+    Vec3 LozengeSupport::getCenter() const {
+        return this->origin + (this->edge[0] + this->edge[1]) * 0.5f;
+    }
+
+    OBBSupport::OBBSupport(const OBB& box) : center(box.getCenter()), halfwidth(box.getHalfwidth()) {
+        for(int i = 0; i < 3; ++i)
+            this->axis[i] = Vec3(box.getAxis(i));
+    }
+
+    Vec3 OBBSupport::support(const Vec3& direction) const {
+        Vec3 p = this->center;
+        for(int i = 0; i < 3; ++i)
+            p += this->axis[i] * (direction * this->axis[i] >= 0.0f ? this->halfwidth[i] : -this->halfwidth[i]);
+        return p;
+    }
+
+    Vec3 OBBSupport::getCenter() const {
+        return this->center;
+    }
+
+    AABBSupport::AABBSupport(const AABB& box) : center(box.getCenter()), radius(box[0], box[1], box[2]) {}
+
+    Vec3 AABBSupport::support(const Vec3& direction) const {
+        return Vec3(this->center.x + (direction.x >= 0.0f ? this->radius.x : -this->radius.x),
+                    this->center.y + (direction.y >= 0.0f ? this->radius.y : -this->radius.y),
+                    this->center.z + (direction.z >= 0.0f ? this->radius.z : -this->radius.z));
+    }
+
+    Vec3 AABBSupport::getCenter() const {
+        return this->center;
+    }
+
+    TriangleSupport::TriangleSupport(const Triangle& triangle) {
+        this->vertex[0] = Vec3(triangle.getA());
+        this->vertex[1] = Vec3(triangle.getB());
+        this->vertex[2] = Vec3(triangle.getC());
+    }
+
+    Vec3 TriangleSupport::support(const Vec3& direction) const {
+        float d0 = direction * this->vertex[0], d1 = direction * this->vertex[1], d2 = direction * this->vertex[2];
+        if(d0 >= d1 && d0 >= d2)
+            return this->vertex[0];
+        return d1 >= d2 ? this->vertex[1] : this->vertex[2];
+    }
+
+    Vec3 TriangleSupport::getCenter() const {
+        return (this->vertex[0] + this->vertex[1] + this->vertex[2]) / 3.0f;
+    }
+
+    HullSupport::HullSupport(const std::vector<Point2D>& hull, float z) {
+        for(const Point2D& p : hull)
+            this->vertices.push_back(Vec3(p.getX(), p.getY(), z));
+        this->init_center();
+    }
+
+    void HullSupport::init_center() {
+        if(this->vertices.empty())
+            throw std::invalid_argument("HullSupport needs at least one vertex");
+        Vec3 sum;
+        for(const Vec3& v : this->vertices)
+            sum += v;
+        this->center = sum / static_cast<float>(this->vertices.size());
+    }
+
+    Vec3 HullSupport::support(const Vec3& direction) const {
+        std::size_t best = 0;
+        float best_dot = direction * this->vertices[0];
+        for(std::size_t i = 1; i < this->vertices.size(); ++i) {
+            float d = direction * this->vertices[i];
+            if(d > best_dot) {
+                best_dot = d;
+                best = i;
+            }
+        }
+        return this->vertices[best];
+    }
+
+    Vec3 HullSupport::getCenter() const {
+        return this->center;
+    }
+}
@@ -0,0 +1,100 @@
+#include "../include/ThreadPool.hh"
+
+namespace Geometry {
+
+    ThreadPool::ThreadPool(std::size_t threads) : body(nullptr), remaining(0), generation(0), stop(false) {
+        if(threads == 0)
+            threads = std::thread::hardware_concurrency();
+        if(threads == 0)
+            threads = 1;
+        for(std::size_t i = 0; i < threads; ++i)
+            this->queues.emplace_back(new WorkerQueue());
+        for(std::size_t i = 0; i < threads; ++i)
+            this->workers.emplace_back(&ThreadPool::worker_loop, this, i);
+    }
+
+    ThreadPool::~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(this->state_mutex);
+            this->stop = true;
+        }
+        this->work_ready.notify_all();
+        for(std::thread& worker : this->workers)
+            worker.join();
+    }
+
+    std::size_t ThreadPool::size() const {
+        return this->workers.size();
+    }
+
+    bool ThreadPool::take_task(std::size_t id, std::size_t& task) {
+        // Own deque: LIFO end
+        {
+            WorkerQueue& own = *this->queues[id];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if(!own.tasks.empty()) {
+                task = own.tasks.back();
+                own.tasks.pop_back();
+                return true;
+            }
+        }
+        // Steal from the FIFO end of the others, starting from the next worker
+        std::size_t n = this->queues.size();
+        for(std::size_t k = 1; k < n; ++k) {
+            WorkerQueue& victim = *this->queues[(id + k) % n];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if(!victim.tasks.empty()) {
+                task = victim.tasks.front();
+                victim.tasks.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void ThreadPool::worker_loop(std::size_t id) {
+        std::size_t seen = 0;
+        for(;;) {
+            {
+                std::unique_lock<std::mutex> lock(this->state_mutex);
+                this->work_ready.wait(lock, [this, seen] { return this->stop || this->generation != seen; });
+                if(this->stop)
+                    return;
+                seen = this->generation;
+            }
+
+            std::size_t task;
+            while(this->take_task(id, task)) {
+                (*this->body)(task, id);
+                if(this->remaining.fetch_sub(1) == 1) {
+                    std::lock_guard<std::mutex> lock(this->state_mutex);
+                    this->work_done.notify_all();
+                }
+            }
+        }
+    }
+
+    void ThreadPool::parallel_for(std::size_t count, const Task& body) {
+        if(count == 0)
+            return;
+
+        this->body = &body;
+        this->remaining = count;
+
+        // Deal contiguous blocks of indices so that neighbouring tasks start on the same worker
+        std::size_t n = this->queues.size();
+        for(std::size_t w = 0; w < n; ++w) {
+            std::size_t first = count * w / n;
+            std::size_t last = count * (w + 1) / n;
+            std::lock_guard<std::mutex> lock(this->queues[w]->mutex);
+            for(std::size_t i = last; i > first; --i)
+                this->queues[w]->tasks.push_back(i - 1);
+        }
+
+        std::unique_lock<std::mutex> lock(this->state_mutex);
+        ++this->generation;
+        this->work_ready.notify_all();
+        this->work_done.wait(lock, [this] { return this->remaining.load() == 0; });
+        this->body = nullptr;
+    }
+}
@@ -0,0 +1,241 @@
+#include "../include/TimeOfImpact.hh"
+#include "../include/GeometricUtils.hh"
+#include "../include/GJK.hh"
+#include "../include/Ray.hh"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace Geometry {
+
+    // Support function: rotation matrix of the rotation vector `w` (Rodrigues' formula)
+    static Mat3 rotation_matrix(const Vec3& w) {
+        float angle = std::sqrt(w * w);
+        if(angle == 0.0f)
+            return Mat3::identity();
+        Vec3 k = w / angle;
+        float s = std::sin(angle), c = 1.0f - std::cos(angle);
+        return Mat3(1.0f - c * (k.y * k.y + k.z * k.z), c * k.x * k.y - s * k.z, c * k.x * k.z + s * k.y,
+                    c * k.x * k.y + s * k.z, 1.0f - c * (k.x * k.x + k.z * k.z), c * k.y * k.z - s * k.x,
+                    c * k.x * k.z - s * k.y, c * k.y * k.z + s * k.x, 1.0f - c * (k.x * k.x + k.y * k.y));
+    }
+
+    // Support function: rotation vector of the rotation matrix `r` (inverse of `rotation_matrix`)
+    static Vec3 rotation_vector(const Mat3& r) {
+        const float pi = 3.14159265358979f;
+        float c = 0.5f * (r(0, 0) + r(1, 1) + r(2, 2) - 1.0f);
+        c = std::min(1.0f, std::max(-1.0f, c));
+        float angle = std::acos(c);
+        Vec3 skew(r(2, 1) - r(1, 2), r(0, 2) - r(2, 0), r(1, 0) - r(0, 1));
+        if(angle < 1e-4f)
+            return skew * 0.5f;
+        if(angle < pi - 1e-3f)
+            return skew * (angle / (2.0f * std::sin(angle)));
+
+        // Close to a half turn the skew part vanishes: the axis comes from the symmetric part, r = 2 k k^T - I
+        int i = 0;
+        if(r(1, 1) > r(i, i)) i = 1;
+        if(r(2, 2) > r(i, i)) i = 2;
+        float k[3];
+        k[i] = std::sqrt(std::max(0.0f, (r(i, i) - c) / (1.0f - c)));
+        for(int j = 0; j < 3; ++j)
+            if(j != i)
+                k[j] = (r(i, j) + r(j, i)) / (2.0f * (1.0f - c) * k[i]);
+        Vec3 axis(k[0], k[1], k[2]);
+        // Keep the sign consistent with the (small) skew part
+        if(axis * skew < 0.0f)
+            axis = -axis;
+        return axis * angle;
+    }
+
+    Motion Motion::from_transforms(const Mat3& r0, const Vec3& t0, const Mat3& r1, const Vec3& t1, const Vec3& center) {
+        // x -> r1 * r0^T * (x - t0) + t1, rewritten as a rotation about `center` followed by a translation
+        Mat3 r = r1 * r0.transpose();
+        Motion motion;
+        motion.linear = r * (center - t0) + t1 - center;
+        motion.angular = rotation_vector(r);
+        return motion;
+    }
+
+    /**
+     * @brief Support mapping of a shape moved by a `Motion` at a given time: it rotates the direction into the start pose, queries the wrapped shape and moves the support point back.
+     */
+    class MovedSupport : public SupportMapping {
+    private:
+        const SupportMapping& shape;
+        Vec3 center, offset;
+        Mat3 rotation;
+    public:
+        MovedSupport(const SupportMapping& shape, const Motion& motion, float t) : shape(shape), center(shape.getCenter()), offset(motion.linear * t), rotation(rotation_matrix(motion.angular * t)) {}
+
+        Vec3 support(const Vec3& direction) const override {
+            Vec3 p = this->shape.support(this->rotation.transpose() * direction);
+            return this->rotation * (p - this->center) + this->center + this->offset;
+        }
+
+        Vec3 getCenter() const override {
+            return this->center + this->offset;
+        }
+    };
+
+    // Support function: upper bound of the distance of the points of `shape` from its center, from its bounding box
+    static float bounding_radius(const SupportMapping& shape) {
+        Vec3 c = shape.getCenter(), extent;
+        for(int i = 0; i < 3; ++i) {
+            Vec3 axis;
+            axis[i] = 1.0f;
+            float hi = shape.support(axis)[i] - c[i], lo = c[i] - shape.support(-axis)[i];
+            extent[i] = std::max(hi, lo);
+        }
+        return std::sqrt(extent * extent);
+    }
+
+    bool TimeOfImpact::sphere_sphere(const Sphere& a_start, const Sphere& a_end, const Sphere& b_start, const Sphere& b_end, float& toi) {
+        Vec3 a0(a_start.getCenter()), b0(b_start.getCenter());
+        // Relative motion: b moves with velocity v against a static a
+        Vec3 s = b0 - a0;
+        Vec3 v = (Vec3(b_end.getCenter()) - b0) - (Vec3(a_end.getCenter()) - a0);
+        float r = a_start.getRadius() + b_start.getRadius();
+        float c = s * s - r * r;
+        if(c <= 0.0f) {
+            toi = 0.0f;
+            return true;
+        }
+        float a = v * v;
+        if(a <= std::numeric_limits<float>::min())
+            return false;
+        float b = v * s;
+        // Moving apart
+        if(b >= 0.0f)
+            return false;
+        float d = b * b - a * c;
+        if(d < 0.0f)
+            return false;
+        float t = (-b - std::sqrt(d)) / a;
+        if(t > 1.0f)
+            return false;
+        toi = t;
+        return true;
+    }
+
+    bool TimeOfImpact::sphere_box(const Vec3& c0, const Vec3& c1, float radius, const Vec3& halfwidth, float& toi) {
+        // Overlapping at the start
+        float d2 = 0.0f;
+        for(int i = 0; i < 3; ++i) {
+            float excess = std::abs(c0[i]) - halfwidth[i];
+            if(excess > 0.0f)
+                d2 += excess * excess;
+        }
+        if(d2 <= radius * radius) {
+            toi = 0.0f;
+            return true;
+        }
+        Vec3 d = c1 - c0;
+        float length = std::sqrt(d * d);
+        if(length == 0.0f)
+            return false;
+
+        // The swept volume hits the box when the path of the center hits the box rounded by the radius: first clip the path against the box grown by the radius
+        Ray ray(c0, d, length);
+        RayHit hit;
+        Point3D e(halfwidth.x + radius, halfwidth.y + radius, halfwidth.z + radius);
+        if(!ray.intersect(OBB(Point3D(0, 0, 0), Point3D(1, 0, 0), Point3D(0, 1, 0), Point3D(0, 0, 1), e), hit))
+            return false;
+
+        // Face region: the grown box and the rounded box coincide there
+        Vec3 p = ray.at(hit.distance), sign;
+        int outside = 0;
+        for(int i = 0; i < 3; ++i) {
+            sign[i] = p[i] < 0.0f ? -1.0f : 1.0f;
+            if(std::abs(p[i]) > halfwidth[i])
+                ++outside;
+        }
+        if(outside < 2) {
+            toi = hit.distance / length;
+            return true;
+        }
+
+        // Edge or vertex region: the rounded box is bounded there by the capsules around the box edges
+        Vec3 corner(sign.x * halfwidth.x, sign.y * halfwidth.y, sign.z * halfwidth.z);
+        float best = std::numeric_limits<float>::infinity();
+        for(int k = 0; k < 3; ++k) {
+            // Edge along axis k; in an edge region only the edge of the two outside axes is tested
+            int i = (k + 1) % 3, j = (k + 2) % 3;
+            if(outside == 2 && (std::abs(p[i]) <= halfwidth[i] || std::abs(p[j]) <= halfwidth[j]))
+                continue;
+            Vec3 other = corner;
+            other[k] = -other[k];
+            if(ray.intersect(Capsule(corner.toPoint3D(), other.toPoint3D(), radius), hit) && hit.distance < best)
+                best = hit.distance;
+        }
+        if(best == std::numeric_limits<float>::infinity())
+            return false;
+        toi = best / length;
+        return true;
+    }
+
+    bool TimeOfImpact::sphere_AABB(const Sphere& start, const Sphere& end, const AABB& box, float& toi) {
+        Vec3 c(box.getCenter());
+        return sphere_box(Vec3(start.getCenter()) - c, Vec3(end.getCenter()) - c, start.getRadius(), Vec3(box[0], box[1], box[2]), toi);
+    }
+
+    bool TimeOfImpact::sphere_OBB(const Sphere& start, const Sphere& end, const OBB& box, float& toi) {
+        Vec3 c(box.getCenter()), u[3] = { Vec3(box.getAxis(0)), Vec3(box.getAxis(1)), Vec3(box.getAxis(2)) };
+        Vec3 s = Vec3(start.getCenter()) - c, e = Vec3(end.getCenter()) - c;
+        return sphere_box(Vec3(s * u[0], s * u[1], s * u[2]), Vec3(e * u[0], e * u[1], e * u[2]), start.getRadius(), Vec3(box.getHalfwidth()), toi);
+    }
+
+    bool TimeOfImpact::capsule_capsule(const Capsule& a_start, const Capsule& a_end, const Capsule& b_start, const Capsule& b_end, float& toi, float tolerance) {
+        Vec3 pa(a_start.getStart()), qa(a_start.getEnd()), pb(b_start.getStart()), qb(b_start.getEnd());
+        Vec3 vpa = Vec3(a_end.getStart()) - pa, vqa = Vec3(a_end.getEnd()) - qa;
+        Vec3 vpb = Vec3(b_end.getStart()) - pb, vqb = Vec3(b_end.getEnd()) - qb;
+        float r = a_start.getRadius() + b_start.getRadius();
+
+        float t = 0.0f;
+        for(int iteration = 0; iteration < MAX_ITERATIONS; ++iteration) {
+            float s, u;
+            Vec3 c1, c2;
+            float d2 = GeometryUtils::closest_point_segment_segment(pa + vpa * t, qa + vqa * t, pb + vpb * t, qb + vqb * t, s, u, c1, c2);
+            float distance = std::sqrt(d2) - r;
+            if(distance <= tolerance) {
+                toi = t;
+                return true;
+            }
+            // A point of a segment moves with the interpolation of the endpoint velocities, so its speed along n is bounded by the endpoints
+            Vec3 n = (c2 - c1) / std::sqrt(d2);
+            float approach = std::max(vpa * n, vqa * n) - std::min(vpb * n, vqb * n);
+            if(approach <= 0.0f)
+                return false;
+            t += distance / approach;
+            if(t > 1.0f)
+                return false;
+        }
+        toi = t;
+        return true;
+    }
+
+    bool TimeOfImpact::conservative_advancement(const SupportMapping& a, const Motion& motion_a, const SupportMapping& b, const Motion& motion_b, float& toi, float tolerance) {
+        float spin = std::sqrt(motion_a.angular * motion_a.angular) * bounding_radius(a) + std::sqrt(motion_b.angular * motion_b.angular) * bounding_radius(b);
+        Vec3 v = motion_a.linear - motion_b.linear;
+
+        GJKCache cache;
+        float t = 0.0f;
+        for(int iteration = 0; iteration < MAX_ITERATIONS; ++iteration) {
+            MovedSupport moved_a(a, motion_a, t), moved_b(b, motion_b, t);
+            GJKResult r = GJK::query(moved_a, moved_b, &cache);
+            if(r.intersecting || r.distance <= tolerance) {
+                toi = t;
+                return true;
+            }
+            // Upper bound of the speed at which the distance along the current normal shrinks
+            float approach = v * r.normal + spin;
+            if(approach <= 0.0f)
+                return false;
+            t += r.distance / approach;
+            if(t > 1.0f)
+                return false;
+        }
+        toi = t;
+        return true;
+    }
+}
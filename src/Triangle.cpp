@@ -6,6 +6,16 @@ namespace Geometry {
 
     // Constructors
     Triangle::Triangle(const Point3D& v1, const Point3D& v2, const Point3D& v3) : a(v1), b(v2), c(v3) {}
+    // Getters
+    Point3D Triangle::getA() const {
+        return a;
+    }
+    Point3D Triangle::getB() const {
+        return b;
+    }
+    Point3D Triangle::getC() const {
+        return c;
+    }
     // Operations with triangles
     float Triangle::getArea() const {
         float s = (getPerimeter() / 2);
@@ -1,4 +1,5 @@
 #include "../include/data_structures/AABB.hh"
+#include <algorithm>
 
 namespace Geometry {
     
@@ -27,24 +28,64 @@ namespace Geometry {
         }
     }
 
+    Point3D AABB::getCenter() const {
+        return this->center;
+    }
+
     bool AABB::test_AABB_AABB_intersection(const AABB& other) const {
-        if(abs(this->center.getX() - other.center.getX()) > (this->radius[0] + other.radius[0]))
+        if(std::abs(this->center.getX() - other.center.getX()) > (this->radius[0] + other.radius[0]))
             return false;
-        if(abs(this->center.getY() - other.center.getY()) > (this->radius[1] + other.radius[1]))
+        if(std::abs(this->center.getY() - other.center.getY()) > (this->radius[1] + other.radius[1]))
             return false;
-        if(abs(this->center.getZ() - other.center.getZ()) > (this->radius[2] + other.radius[2]))
+        if(std::abs(this->center.getZ() - other.center.getZ()) > (this->radius[2] + other.radius[2]))
             return false;
         return true;
     }
 
-    void AABB::update_AABB(Matrix M, float T[3], AABB& other) {
+    void AABB::update_AABB(const Matrix& M, const float T[3], AABB& other) const {
         for(int i = 0; i < 3; ++i) {
             other.center[i] = T[i];
             other.radius[i] = 0.0f;
             for(int j = 0; j < 3; ++j) {
                 other.center[i] += M[i][j] * this->center[j];
-                other.radius[i] += abs(M[i][j]) * this->radius[j];
+                other.radius[i] += std::abs(M[i][j]) * this->radius[j];
+            }
+        }
+    }
+
+    void AABB::update_AABB(const Transform& transform, AABB& other) const {
+        for(int i = 0; i < 3; ++i) {
+            other.center[i] = transform.translation[i];
+            other.radius[i] = 0.0f;
+            for(int j = 0; j < 3; ++j) {
+                other.center[i] += transform.rotation(i, j) * this->center[j];
+                other.radius[i] += std::abs(transform.rotation(i, j)) * this->radius[j];
             }
         }
     }
-}
\ No newline at end of file
+
+    bool AABB::contains(const AABB& other) const {
+        for(int i = 0; i < 3; ++i) {
+            if(other.center[i] - other.radius[i] < this->center[i] - this->radius[i])
+                return false;
+            if(other.center[i] + other.radius[i] > this->center[i] + this->radius[i])
+                return false;
+        }
+        return true;
+    }
+
+    float AABB::surface_area() const {
+        return 8.0f * (this->radius[0] * this->radius[1] + this->radius[1] * this->radius[2] + this->radius[2] * this->radius[0]);
+    }
+
+    AABB AABB::merge(const AABB& a, const AABB& b) {
+        AABB result;
+        for(int i = 0; i < 3; ++i) {
+            float min = std::min(a.center[i] - a.radius[i], b.center[i] - b.radius[i]);
+            float max = std::max(a.center[i] + a.radius[i], b.center[i] + b.radius[i]);
+            result.center[i] = (min + max) * 0.5f;
+            result.radius[i] = (max - min) * 0.5f;
+        }
+        return result;
+    }
+}
@@ -0,0 +1,162 @@
+#include "../include/data_structures/AABBBatch.hh"
+#include <cmath>
+#include <stdexcept>
+
+namespace Geometry {
+
+    AABBBatch::AABBBatch() : count(0) {}
+
+    std::size_t AABBBatch::add(const AABB& box) {
+        // Grow the arrays by a whole block so that the kernel never reads out of bounds
+        if(this->count % LANES == 0) {
+            for(int i = 0; i < 3; ++i) {
+                this->center[i].resize(this->count + LANES, 0.0f);
+                this->radius[i].resize(this->count + LANES, 0.0f);
+            }
+        }
+        ++this->count;
+        this->set(this->count - 1, box);
+        return this->count - 1;
+    }
+
+    void AABBBatch::set(std::size_t index, const AABB& box) {
+        if(index >= this->count)
+            throw std::out_of_range("Index out of range");
+        Point3D c = box.getCenter();
+        for(int i = 0; i < 3; ++i) {
+            this->center[i][index] = c[i];
+            this->radius[i][index] = box[i];
+        }
+    }
+
+    AABB AABBBatch::get(std::size_t index) const {
+        if(index >= this->count)
+            throw std::out_of_range("Index out of range");
+        return AABB(Point3D(this->center[0][index], this->center[1][index], this->center[2][index]),
+                    this->radius[0][index], this->radius[1][index], this->radius[2][index]);
+    }
+
+    void AABBBatch::reserve(std::size_t n) {
+        std::size_t padded = (n + LANES - 1) / LANES * LANES;
+        for(int i = 0; i < 3; ++i) {
+            this->center[i].reserve(padded);
+            this->radius[i].reserve(padded);
+        }
+    }
+
+    void AABBBatch::clear() {
+        for(int i = 0; i < 3; ++i) {
+            this->center[i].clear();
+            this->radius[i].clear();
+        }
+        this->count = 0;
+    }
+
+    std::size_t AABBBatch::size() const {
+        return this->count;
+    }
+
+    std::uint32_t AABBBatch::overlap_block(std::size_t first, float cx, float cy, float cz, float rx, float ry, float rz) const {
+        const float* bcx = this->center[0].data() + first;
+        const float* bcy = this->center[1].data() + first;
+        const float* bcz = this->center[2].data() + first;
+        const float* brx = this->radius[0].data() + first;
+        const float* bry = this->radius[1].data() + first;
+        const float* brz = this->radius[2].data() + first;
+
+        // Branch-free body: the compiler maps the lanes onto one SIMD register
+        std::uint32_t mask = 0;
+        for(std::size_t l = 0; l < LANES; ++l) {
+            bool hit = (std::abs(cx - bcx[l]) <= rx + brx[l])
+                     & (std::abs(cy - bcy[l]) <= ry + bry[l])
+                     & (std::abs(cz - bcz[l]) <= rz + brz[l]);
+            mask |= static_cast<std::uint32_t>(hit) << l;
+        }
+
+        // Clear the padding lanes of the last block
+        if(first + LANES > this->count)
+            mask &= (1u << (this->count - first)) - 1u;
+        return mask;
+    }
+
+    std::size_t AABBBatch::query(const AABB& box, std::uint32_t* out) const {
+        Point3D c = box.getCenter();
+        float cx = c.getX(), cy = c.getY(), cz = c.getZ();
+        float rx = box[0], ry = box[1], rz = box[2];
+
+        std::size_t hits = 0;
+        for(std::size_t first = 0; first < this->count; first += LANES) {
+            std::uint32_t mask = this->overlap_block(first, cx, cy, cz, rx, ry, rz);
+            // Branch-free compaction: always write, advance only on a hit.
+            // hits <= first + l < size(), so the write is always in bounds
+            for(std::size_t l = 0; l < LANES && first + l < this->count; ++l) {
+                out[hits] = static_cast<std::uint32_t>(first + l);
+                hits += (mask >> l) & 1u;
+            }
+        }
+        return hits;
+    }
+
+    std::size_t AABBBatch::query_block(const AABB* boxes, std::size_t n, std::uint32_t* out_query, std::uint32_t* out_index, std::size_t capacity) const {
+        std::size_t hits = 0;
+        for(std::size_t q = 0; q < n; ++q) {
+            Point3D c = boxes[q].getCenter();
+            float cx = c.getX(), cy = c.getY(), cz = c.getZ();
+            float rx = boxes[q][0], ry = boxes[q][1], rz = boxes[q][2];
+
+            for(std::size_t first = 0; first < this->count; first += LANES) {
+                std::uint32_t mask = this->overlap_block(first, cx, cy, cz, rx, ry, rz);
+                for(std::size_t l = 0; mask != 0; ++l, mask >>= 1) {
+                    if((mask & 1u) == 0)
+                        continue;
+                    if(hits < capacity) {
+                        out_query[hits] = static_cast<std::uint32_t>(q);
+                        out_index[hits] = static_cast<std::uint32_t>(first + l);
+                    }
+                    ++hits;
+                }
+            }
+        }
+        return hits;
+    }
+
+    void AABBBatch::transform(const Transform* transforms, AABBBatch& out) const {
+        if(&out == this)
+            throw std::invalid_argument("AABBBatch::transform needs a distinct output batch");
+        for(int i = 0; i < 3; ++i) {
+            out.center[i].resize(this->center[i].size());
+            out.radius[i].resize(this->radius[i].size());
+        }
+        out.count = this->count;
+
+        const float* c[3] = { this->center[0].data(), this->center[1].data(), this->center[2].data() };
+        const float* r[3] = { this->radius[0].data(), this->radius[1].data(), this->radius[2].data() };
+        float* oc[3] = { out.center[0].data(), out.center[1].data(), out.center[2].data() };
+        float* orad[3] = { out.radius[0].data(), out.radius[1].data(), out.radius[2].data() };
+
+        // Blocks of LANES boxes are computed into lane arrays, which cannot alias the batch
+        // arrays, so the branch-free body (same arithmetic of `AABB::update_AABB`) is vectorized
+        // without run-time alias checks; the lanes are then copied out
+        for(std::size_t first = 0; first < this->count; first += LANES) {
+            std::size_t lanes = (this->count - first < LANES) ? this->count - first : LANES;
+            const Transform* T = transforms + first;
+            float lc[3][LANES], lr[3][LANES];
+            for(std::size_t l = 0; l < lanes; ++l) {
+                const Mat3& R = T[l].rotation;
+                const Vec3& t = T[l].translation;
+                std::size_t k = first + l;
+                float cx = c[0][k], cy = c[1][k], cz = c[2][k];
+                float rx = r[0][k], ry = r[1][k], rz = r[2][k];
+                for(int i = 0; i < 3; ++i) {
+                    lc[i][l] = t[i] + R(i, 0) * cx + R(i, 1) * cy + R(i, 2) * cz;
+                    lr[i][l] = std::abs(R(i, 0)) * rx + std::abs(R(i, 1)) * ry + std::abs(R(i, 2)) * rz;
+                }
+            }
+            for(std::size_t l = 0; l < lanes; ++l)
+                for(int i = 0; i < 3; ++i) {
+                    oc[i][first + l] = lc[i][l];
+                    orad[i][first + l] = lr[i][l];
+                }
+        }
+    }
+}
@@ -9,23 +9,43 @@ namespace Geometry {
         this->radius = r;
     }
 
+    Point3D Capsule::getStart() const {
+        return this->start;
+    }
+
+    Point3D Capsule::getEnd() const {
+        return this->end;
+    }
+
+    float Capsule::getRadius() const {
+        return this->radius;
+    }
+
     bool Capsule::test_capsule_sphere_intersection(const Sphere& s) const {
+        return Capsule::test_capsule_sphere_intersection(Vec3(this->start), Vec3(this->end), this->radius, Vec3(s.getCenter()), s.getRadius());
+    }
+
+    bool Capsule::test_capsule_intersection(const Capsule& other) const {
+        return Capsule::test_capsule_intersection(Vec3(this->start), Vec3(this->end), this->radius, Vec3(other.start), Vec3(other.end), other.radius);
+    }
+
+    bool Capsule::test_capsule_sphere_intersection(const Vec3& start, const Vec3& end, float radius, const Vec3& center, float sphere_radius) {
 
         // Compute (squared) distance between sphere center and capsule line segment
-        float dist2 = GeometryUtils::sq_dist_point_segment(this->start, this->end, s.getCenter());
+        float dist2 = GeometryUtils::sq_dist_point_segment(start, end, center);
         // If (squared) distance smaller than (squared) sum of radii, they collide
-        float radius_sc = s.getRadius() + this->radius;
+        float radius_sc = sphere_radius + radius;
         return dist2 <= radius_sc * radius_sc;
     }
     
-    bool Capsule::test_capsule_intersection(const Capsule& other) const {
+    bool Capsule::test_capsule_intersection(const Vec3& s0, const Vec3& e0, float r0, const Vec3& s1, const Vec3& e1, float r1) {
 
         // Compute (squared) distance between the inner structures of the capsules
         float s, t;
-        Point3D c1, c2;
-        float dist2 = GeometryUtils::closest_point_segment_segment(this->start, this->end, other.start, other.end, s, t, c1, c2);
+        Vec3 c1, c2;
+        float dist2 = GeometryUtils::closest_point_segment_segment(s0, e0, s1, e1, s, t, c1, c2);
         // If (squared) distance smaller than (squared sum) of radii, they collide
-        float radius_cc = this->radius + other.radius;
-        return dist2 <= radius * radius;
+        float radius_cc = r0 + r1;
+        return dist2 <= radius_cc * radius_cc;
     }
 }
\ No newline at end of file
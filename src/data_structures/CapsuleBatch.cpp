@@ -0,0 +1,280 @@
+#include "../include/data_structures/CapsuleBatch.hh"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace Geometry {
+
+    // Branch-free clamp to [0, 1]; same result of GeometryUtils::clamp(n, 0, 1)
+    static inline float clamp01(float n) {
+        return n < 0.0f ? 0.0f : (n > 1.0f ? 1.0f : n);
+    }
+
+    CapsuleBatch::CapsuleBatch() {}
+
+    std::size_t CapsuleBatch::add(const Capsule& capsule) {
+        for(int i = 0; i < 3; ++i) {
+            this->start[i].push_back(0.0f);
+            this->end[i].push_back(0.0f);
+        }
+        this->radius.push_back(0.0f);
+        this->set(this->size() - 1, capsule);
+        return this->size() - 1;
+    }
+
+    void CapsuleBatch::set(std::size_t index, const Capsule& capsule) {
+        if(index >= this->size())
+            throw std::out_of_range("Index out of range");
+        Point3D s = capsule.getStart();
+        Point3D e = capsule.getEnd();
+        for(int i = 0; i < 3; ++i) {
+            this->start[i][index] = s[i];
+            this->end[i][index] = e[i];
+        }
+        this->radius[index] = capsule.getRadius();
+    }
+
+    Capsule CapsuleBatch::get(std::size_t index) const {
+        if(index >= this->size())
+            throw std::out_of_range("Index out of range");
+        return Capsule(Point3D(this->start[0][index], this->start[1][index], this->start[2][index]),
+                       Point3D(this->end[0][index], this->end[1][index], this->end[2][index]),
+                       this->radius[index]);
+    }
+
+    void CapsuleBatch::clear() {
+        for(int i = 0; i < 3; ++i) {
+            this->start[i].clear();
+            this->end[i].clear();
+        }
+        this->radius.clear();
+    }
+
+    std::size_t CapsuleBatch::size() const {
+        return this->radius.size();
+    }
+
+    std::uint32_t CapsuleBatch::capsule_block(const std::uint32_t* a, const std::uint32_t* b, std::size_t count, float* dist2) const {
+        const float epsilon = std::numeric_limits<float>::epsilon();
+
+        // Gather the pairs into lane arrays. Unused lanes repeat the last pair
+        float p1[3][LANES], q1[3][LANES], p2[3][LANES], q2[3][LANES], rr[LANES];
+        for(std::size_t l = 0; l < LANES; ++l) {
+            std::uint32_t ia = a[l < count ? l : count - 1];
+            std::uint32_t ib = b[l < count ? l : count - 1];
+            for(int i = 0; i < 3; ++i) {
+                p1[i][l] = this->start[i][ia];
+                q1[i][l] = this->end[i][ia];
+                p2[i][l] = this->start[i][ib];
+                q2[i][l] = this->end[i][ib];
+            }
+            rr[l] = this->radius[ia] + this->radius[ib];
+        }
+
+        // Every lane evaluates all the cases of GeometryUtils::closest_point_segment_segment
+        // with guarded denominators, then the right (s, t) is selected per lane. The quotients
+        // go through lane arrays: a division used by one case only would be moved behind a
+        // branch (it might trap) and the loops would not vectorize
+        float a_len[LANES], e_len[LANES], b_dot[LANES], f_dot[LANES], denom[LANES];
+        float s_div[LANES], s_low[LANES], s_high[LANES], t_first[LANES];
+        for(std::size_t l = 0; l < LANES; ++l) {
+            float d1[3], d2[3], r[3];
+            for(int i = 0; i < 3; ++i) {
+                d1[i] = q1[i][l] - p1[i][l];
+                d2[i] = q2[i][l] - p2[i][l];
+                r[i] = p1[i][l] - p2[i][l];
+            }
+            float a_ = d1[0] * d1[0] + d1[1] * d1[1] + d1[2] * d1[2];
+            float e = d2[0] * d2[0] + d2[1] * d2[1] + d2[2] * d2[2];
+            float f = d2[0] * r[0] + d2[1] * r[1] + d2[2] * r[2];
+            float c = d1[0] * r[0] + d1[1] * r[1] + d1[2] * r[2];
+            float b_ = d1[0] * d2[0] + d1[1] * d2[1] + d1[2] * d2[2];
+            float dn = a_ * e - b_ * b_;
+
+            // Only used when the segment is not a point, where they equal a_ and e. A constant
+            // would let the compiler split the division into two paths
+            float safe_a = std::max(a_, epsilon);
+            float safe_e = std::max(e, epsilon);
+            float safe_denom = dn != 0.0f ? dn : 1.0f;
+            a_len[l] = a_;
+            e_len[l] = e;
+            b_dot[l] = b_;
+            f_dot[l] = f;
+            denom[l] = dn;
+            s_div[l] = clamp01((b_ * f - c * e) / safe_denom);
+            s_low[l] = clamp01(-c / safe_a);
+            s_high[l] = clamp01((b_ - c) / safe_a);
+            t_first[l] = clamp01(f / safe_e);
+        }
+
+        // General case: t of the closest point to the line at s, before clamping s
+        float s_gen[LANES], tnom[LANES], t_div[LANES];
+        for(std::size_t l = 0; l < LANES; ++l) {
+            s_gen[l] = denom[l] != 0.0f ? s_div[l] : 0.0f;
+            tnom[l] = b_dot[l] * s_gen[l] + f_dot[l];
+            t_div[l] = tnom[l] / std::max(e_len[l], epsilon);
+        }
+
+        // Selection; degenerate cases: first segment a point (s = 0), second segment a point (t = 0)
+        std::uint32_t hit[LANES];
+        for(std::size_t l = 0; l < LANES; ++l) {
+            bool a_point = a_len[l] <= epsilon, e_point = e_len[l] <= epsilon;
+            float e = e_len[l], tn = tnom[l];
+            float t_gen = tn < 0.0f ? 0.0f : (tn > e ? 1.0f : t_div[l]);
+            float s_clamped = tn < 0.0f ? s_low[l] : (tn > e ? s_high[l] : s_gen[l]);
+            float s = a_point ? 0.0f : (e_point ? s_low[l] : s_clamped);
+            float t = a_point ? (e_point ? 0.0f : t_first[l]) : (e_point ? 0.0f : t_gen);
+
+            float d = 0.0f;
+            for(int i = 0; i < 3; ++i) {
+                float v = (p1[i][l] + (q1[i][l] - p1[i][l]) * s) - (p2[i][l] + (q2[i][l] - p2[i][l]) * t);
+                d += v * v;
+            }
+            dist2[l] = d;
+            hit[l] = d <= rr[l] * rr[l] ? 1u : 0u;
+        }
+
+        std::uint32_t mask = 0;
+        for(std::size_t l = 0; l < LANES; ++l)
+            mask |= hit[l] << l;
+
+        if(count < LANES)
+            mask &= (1u << count) - 1u;
+        return mask;
+    }
+
+    std::uint32_t CapsuleBatch::sphere_block(const std::uint32_t* capsule, const float* sx, const float* sy, const float* sz, const float* sr, const std::uint32_t* sphere, std::size_t count, float* dist2) const {
+        // Gather the pairs into lane arrays. Unused lanes repeat the last pair
+        float p[3][LANES], q[3][LANES], cc[3][LANES], rr[LANES];
+        for(std::size_t l = 0; l < LANES; ++l) {
+            std::uint32_t ic = capsule[l < count ? l : count - 1];
+            std::uint32_t is = sphere[l < count ? l : count - 1];
+            for(int i = 0; i < 3; ++i) {
+                p[i][l] = this->start[i][ic];
+                q[i][l] = this->end[i][ic];
+            }
+            cc[0][l] = sx[is];
+            cc[1][l] = sy[is];
+            cc[2][l] = sz[is];
+            rr[l] = sr[is] + this->radius[ic];
+        }
+
+        // Same three cases of GeometryUtils::sq_dist_point_segment, evaluated into lane arrays
+        // and then selected per lane (see capsule_block)
+        float e_dot[LANES], f_len[LANES], ac_len[LANES], bc_len[LANES], inside[LANES];
+        for(std::size_t l = 0; l < LANES; ++l) {
+            float ab[3], ac[3], bc[3];
+            for(int i = 0; i < 3; ++i) {
+                ab[i] = q[i][l] - p[i][l];
+                ac[i] = cc[i][l] - p[i][l];
+                bc[i] = q[i][l] - cc[i][l];
+            }
+            float e = ac[0] * ab[0] + ac[1] * ab[1] + ac[2] * ab[2];
+            float f = ab[0] * ab[0] + ab[1] * ab[1] + ab[2] * ab[2];
+            float acac = ac[0] * ac[0] + ac[1] * ac[1] + ac[2] * ac[2];
+            float bcbc = bc[0] * bc[0] + bc[1] * bc[1] + bc[2] * bc[2];
+            float safe_f = f > 0.0f ? f : 1.0f;
+            e_dot[l] = e;
+            f_len[l] = f;
+            ac_len[l] = acac;
+            bc_len[l] = bcbc;
+            inside[l] = acac - e * e / safe_f;
+        }
+
+        std::uint32_t hit[LANES];
+        for(std::size_t l = 0; l < LANES; ++l) {
+            float d = e_dot[l] <= 0.0f ? ac_len[l] : (e_dot[l] >= f_len[l] ? bc_len[l] : inside[l]);
+            dist2[l] = d;
+            hit[l] = d <= rr[l] * rr[l] ? 1u : 0u;
+        }
+
+        std::uint32_t mask = 0;
+        for(std::size_t l = 0; l < LANES; ++l)
+            mask |= hit[l] << l;
+
+        if(count < LANES)
+            mask &= (1u << count) - 1u;
+        return mask;
+    }
+
+    std::size_t CapsuleBatch::test_capsule_pairs(const std::uint32_t* a, const std::uint32_t* b, std::size_t n, std::uint32_t* mask, float* dist2) const {
+        std::size_t hits = 0;
+        for(std::size_t w = 0; w < (n + 31) / 32; ++w)
+            mask[w] = 0;
+        for(std::size_t first = 0; first < n; first += LANES) {
+            std::size_t count = (n - first < LANES) ? n - first : LANES;
+            float block_dist2[LANES];
+            std::uint32_t block = this->capsule_block(a + first, b + first, count, block_dist2);
+            // LANES divides 32, so a block never straddles two words
+            mask[first / 32] |= block << (first % 32);
+            for(std::uint32_t m = block; m != 0; m &= m - 1)
+                ++hits;
+            if(dist2 != nullptr)
+                for(std::size_t l = 0; l < count; ++l)
+                    dist2[first + l] = block_dist2[l];
+        }
+        return hits;
+    }
+
+    std::size_t CapsuleBatch::test_sphere_pairs(const std::uint32_t* capsule, const float* sx, const float* sy, const float* sz, const float* sr, const std::uint32_t* sphere, std::size_t n, std::uint32_t* mask, float* dist2) const {
+        std::size_t hits = 0;
+        for(std::size_t w = 0; w < (n + 31) / 32; ++w)
+            mask[w] = 0;
+        for(std::size_t first = 0; first < n; first += LANES) {
+            std::size_t count = (n - first < LANES) ? n - first : LANES;
+            float block_dist2[LANES];
+            std::uint32_t block = this->sphere_block(capsule + first, sx, sy, sz, sr, sphere + first, count, block_dist2);
+            mask[first / 32] |= block << (first % 32);
+            for(std::uint32_t m = block; m != 0; m &= m - 1)
+                ++hits;
+            if(dist2 != nullptr)
+                for(std::size_t l = 0; l < count; ++l)
+                    dist2[first + l] = block_dist2[l];
+        }
+        return hits;
+    }
+
+    std::size_t CapsuleBatch::test_sphere_pairs(const std::uint32_t* capsule, const SphereBatch& spheres, const std::uint32_t* sphere, std::size_t n, std::uint32_t* mask, float* dist2) const {
+        return this->test_sphere_pairs(capsule, spheres.getCenterData(0), spheres.getCenterData(1), spheres.getCenterData(2), spheres.getRadiusData(), sphere, n, mask, dist2);
+    }
+
+    void CapsuleBatch::transform(const Transform* transforms, CapsuleBatch& out) const {
+        if(&out == this)
+            throw std::invalid_argument("CapsuleBatch::transform needs a distinct output batch");
+        std::size_t n = this->size();
+        for(int i = 0; i < 3; ++i) {
+            out.start[i].resize(n);
+            out.end[i].resize(n);
+        }
+        out.radius = this->radius;
+
+        const float* s[3] = { this->start[0].data(), this->start[1].data(), this->start[2].data() };
+        const float* e[3] = { this->end[0].data(), this->end[1].data(), this->end[2].data() };
+        float* os[3] = { out.start[0].data(), out.start[1].data(), out.start[2].data() };
+        float* oe[3] = { out.end[0].data(), out.end[1].data(), out.end[2].data() };
+
+        // Blocks of LANES capsules are computed into lane arrays, so that the branch-free body
+        // is vectorized without run-time alias checks (see AABBBatch::transform), then copied out
+        for(std::size_t first = 0; first < n; first += LANES) {
+            std::size_t lanes = (n - first < LANES) ? n - first : LANES;
+            const Transform* T = transforms + first;
+            float ls[3][LANES], le[3][LANES];
+            for(std::size_t l = 0; l < lanes; ++l) {
+                const Mat3& R = T[l].rotation;
+                const Vec3& t = T[l].translation;
+                std::size_t k = first + l;
+                float sx = s[0][k], sy = s[1][k], sz = s[2][k];
+                float ex = e[0][k], ey = e[1][k], ez = e[2][k];
+                for(int i = 0; i < 3; ++i) {
+                    ls[i][l] = t[i] + R(i, 0) * sx + R(i, 1) * sy + R(i, 2) * sz;
+                    le[i][l] = t[i] + R(i, 0) * ex + R(i, 1) * ey + R(i, 2) * ez;
+                }
+            }
+            for(std::size_t l = 0; l < lanes; ++l)
+                for(int i = 0; i < 3; ++i) {
+                    os[i][first + l] = ls[i][l];
+                    oe[i][first + l] = le[i][l];
+                }
+        }
+    }
+}
@@ -0,0 +1,96 @@
+#include "../include/data_structures/ContactCache.hh"
+#include <stdexcept>
+
+namespace Geometry {
+
+    ContactCache::ContactCache(float breaking_distance) : breaking_distance(breaking_distance) {
+        if(!(breaking_distance > 0.0f))
+            throw std::invalid_argument("ContactCache breaking distance must be positive");
+    }
+
+    std::uint64_t ContactCache::pair_key(std::uint32_t a, std::uint32_t b) {
+        return (static_cast<std::uint64_t>(a) << 32) | b;
+    }
+
+    bool ContactCache::refresh(std::uint32_t a, std::uint32_t b, const Transform& pose_a, const Transform& pose_b) {
+        auto it = this->entries.find(ContactCache::pair_key(a, b));
+        if(it == this->entries.end())
+            return false;
+        Entry& entry = it->second;
+        ContactManifold& m = entry.manifold;
+        float breaking2 = this->breaking_distance * this->breaking_distance;
+
+        m.normal = pose_a.rotate(entry.local_normal);
+        int kept = 0;
+        for(int i = 0; i < m.count; ++i) {
+            Vec3 pa = pose_a.apply(entry.local_a[i]), pb = pose_b.apply(entry.local_b[i]);
+            Vec3 d = pa - pb;
+            float depth = d * m.normal;
+            Vec3 drift = d - m.normal * depth;
+            // Separated along the normal, or slid apart in the tangent plane
+            if(depth < -this->breaking_distance || drift * drift > breaking2)
+                continue;
+            m.points[kept].point_a = pa;
+            m.points[kept].point_b = pb;
+            m.points[kept].depth = depth;
+            entry.local_a[kept] = entry.local_a[i];
+            entry.local_b[kept] = entry.local_b[i];
+            ++kept;
+        }
+        bool valid = kept == m.count;
+        m.count = kept;
+        if(kept == 0)
+            this->entries.erase(it);
+        return valid && kept > 0;
+    }
+
+    const ContactManifold& ContactCache::merge(std::uint32_t a, std::uint32_t b, const ContactManifold& manifold, const Transform& pose_a, const Transform& pose_b) {
+        Entry& entry = this->entries[ContactCache::pair_key(a, b)];
+        ContactManifold& m = entry.manifold;
+        float breaking2 = this->breaking_distance * this->breaking_distance;
+
+        m.normal = manifold.normal;
+        entry.local_normal = pose_a.rotate_inverse(manifold.normal);
+        for(int i = 0; i < manifold.count; ++i) {
+            const ContactPoint& p = manifold.points[i];
+            Vec3 la = pose_a.apply_inverse(p.point_a), lb = pose_b.apply_inverse(p.point_b);
+
+            // A new point close to a cached one is the same contact: replace it, keeping its slot
+            int slot = -1;
+            float best = breaking2;
+            for(int j = 0; j < m.count; ++j) {
+                Vec3 d = entry.local_a[j] - la;
+                if(d * d < best) {
+                    best = d * d;
+                    slot = j;
+                }
+            }
+            if(slot >= 0)
+                m.points[slot] = p;
+            else
+                slot = m.add(p);
+            if(slot >= 0) {
+                entry.local_a[slot] = la;
+                entry.local_b[slot] = lb;
+            }
+        }
+        return m;
+    }
+
+    const ContactManifold* ContactCache::find(std::uint32_t a, std::uint32_t b) const {
+        auto it = this->entries.find(ContactCache::pair_key(a, b));
+        return it == this->entries.end() ? nullptr : &it->second.manifold;
+    }
+
+    void ContactCache::remove(std::uint32_t a, std::uint32_t b) {
+        this->entries.erase(ContactCache::pair_key(a, b));
+    }
+
+    void ContactCache::clear() {
+        this->entries.clear();
+    }
+
+    std::size_t ContactCache::size() const {
+        return this->entries.size();
+    }
+}
@@ -0,0 +1,103 @@
+#include "../include/data_structures/ConvexHull.hh"
+#include <cmath>
+#include <stdexcept>
+
+namespace Geometry {
+
+    const std::vector<Vec3>& ConvexHull::getVertices() const {
+        return this->vertices;
+    }
+
+    const std::vector<ConvexHull::HalfEdge>& ConvexHull::getEdges() const {
+        return this->edges;
+    }
+
+    const std::vector<ConvexHull::Face>& ConvexHull::getFaces() const {
+        return this->faces;
+    }
+
+    std::size_t ConvexHull::vertex_count() const {
+        return this->vertices.size();
+    }
+
+    std::size_t ConvexHull::face_count() const {
+        return this->faces.size();
+    }
+
+    std::vector<int> ConvexHull::face_vertices(std::size_t face) const {
+        if(face >= this->faces.size())
+            throw std::out_of_range("Index out of range");
+        std::vector<int> polygon;
+        int start = this->faces[face].edge, e = start;
+        do {
+            polygon.push_back(this->edges[e].origin);
+            e = this->edges[e].next;
+        } while(e != start);
+        return polygon;
+    }
+
+    int ConvexHull::support_index(const Vec3& direction, int start) const {
+        if(start < 0 || static_cast<std::size_t>(start) >= this->vertices.size())
+            throw std::out_of_range("Index out of range");
+
+        // Hulls with no faces have at most two vertices
+        if(this->edges.empty()) {
+            int best = 0;
+            for(std::size_t i = 1; i < this->vertices.size(); ++i)
+                if(direction * this->vertices[i] > direction * this->vertices[best])
+                    best = static_cast<int>(i);
+            return best;
+        }
+
+        int best = start;
+        float best_dot = direction * this->vertices[best];
+        bool improved = true;
+        while(improved) {
+            improved = false;
+            // Walk the one-ring of `best`: twin of an outgoing edge, then its next edge, is the following outgoing edge
+            int first = this->vertex_edge[best], e = first;
+            do {
+                int neighbor = this->edges[this->edges[e].next].origin;
+                float d = direction * this->vertices[neighbor];
+                if(d > best_dot) {
+                    best_dot = d;
+                    best = neighbor;
+                    improved = true;
+                    break;
+                }
+                e = this->edges[this->edges[e].twin].next;
+            } while(e != first);
+        }
+        return best;
+    }
+
+    Vec3 ConvexHull::support(const Vec3& direction) const {
+        if(this->vertices.empty())
+            throw std::out_of_range("ConvexHull is empty");
+        return this->vertices[this->support_index(direction)];
+    }
+
+    bool ConvexHull::contains(const Vec3& p, float tolerance) const {
+        if(this->faces.empty())
+            return false;
+        for(const Face& f : this->faces)
+            if(f.normal * p - f.offset > tolerance)
+                return false;
+        if(this->faces.size() > 2)
+            return true;
+
+        // Flat hull: the two planes only bound the thickness, the edges bound the polygon
+        const Vec3& n = this->faces[0].normal;
+        int start = this->faces[0].edge, e = start;
+        do {
+            const Vec3& a = this->vertices[this->edges[e].origin];
+            const Vec3& b = this->vertices[this->edges[this->edges[e].next].origin];
+            Vec3 inward = cross(n, b - a);
+            float length = std::sqrt(inward * inward);
+            if(inward * (p - a) < -tolerance * length)
+                return false;
+            e = this->edges[e].next;
+        } while(e != start);
+        return true;
+    }
+}
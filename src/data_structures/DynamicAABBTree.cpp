@@ -0,0 +1,274 @@
+#include "../include/data_structures/DynamicAABBTree.hh"
+#include <algorithm>
+
+namespace Geometry {
+
+    DynamicAABBTree::DynamicAABBTree(float margin) : root(NULL_NODE), free_list(NULL_NODE), proxy_count(0), margin(margin) {}
+
+    int DynamicAABBTree::allocate_node() {
+        if(this->free_list == NULL_NODE) {
+            // Grow the pool and thread the new nodes into the free list
+            int first = static_cast<int>(this->nodes.size());
+            int capacity = std::max(16, first * 2);
+            this->nodes.resize(capacity);
+            for(int i = first; i < capacity - 1; ++i)
+                this->nodes[i].parent = i + 1;
+            this->nodes[capacity - 1].parent = NULL_NODE;
+            for(int i = first; i < capacity; ++i)
+                this->nodes[i].height = -1;
+            this->free_list = first;
+        }
+        int node = this->free_list;
+        this->free_list = this->nodes[node].parent;
+        this->nodes[node].parent = NULL_NODE;
+        this->nodes[node].left = NULL_NODE;
+        this->nodes[node].right = NULL_NODE;
+        this->nodes[node].height = 0;
+        return node;
+    }
+
+    void DynamicAABBTree::free_node(int node) {
+        this->nodes[node].parent = this->free_list;
+        this->nodes[node].height = -1;
+        this->free_list = node;
+    }
+
+    AABB DynamicAABBTree::fatten(const AABB& box) const {
+        return AABB(box.getCenter(), box[0] + this->margin, box[1] + this->margin, box[2] + this->margin);
+    }
+
+    void DynamicAABBTree::check_proxy(int proxy) const {
+        if(proxy < 0 || proxy >= static_cast<int>(this->nodes.size()) || this->nodes[proxy].height != 0)
+            throw std::out_of_range("Proxy id out of range");
+    }
+
+    int DynamicAABBTree::insert(const AABB& box) {
+        int proxy = this->allocate_node();
+        this->nodes[proxy].box = this->fatten(box);
+        this->insert_leaf(proxy);
+        ++this->proxy_count;
+        return proxy;
+    }
+
+    void DynamicAABBTree::remove(int proxy) {
+        this->check_proxy(proxy);
+        this->remove_leaf(proxy);
+        this->free_node(proxy);
+        --this->proxy_count;
+    }
+
+    bool DynamicAABBTree::move(int proxy, const AABB& box, const Point3D& displacement) {
+        this->check_proxy(proxy);
+        if(this->nodes[proxy].box.contains(box))
+            return false;
+
+        this->remove_leaf(proxy);
+
+        // Extend the fat box along the predicted displacement
+        AABB fat = this->fatten(box);
+        AABB moved(fat.getCenter() + displacement, fat[0], fat[1], fat[2]);
+        this->nodes[proxy].box = AABB::merge(fat, moved);
+
+        this->insert_leaf(proxy);
+        return true;
+    }
+
+    const AABB& DynamicAABBTree::get_fat_AABB(int proxy) const {
+        this->check_proxy(proxy);
+        return this->nodes[proxy].box;
+    }
+
+    std::size_t DynamicAABBTree::size() const {
+        return this->proxy_count;
+    }
+
+    int DynamicAABBTree::height() const {
+        return this->root == NULL_NODE ? -1 : this->nodes[this->root].height;
+    }
+
+    void DynamicAABBTree::insert_leaf(int leaf) {
+        if(this->root == NULL_NODE) {
+            this->root = leaf;
+            this->nodes[leaf].parent = NULL_NODE;
+            return;
+        }
+
+        // Find the best sibling: descend while the cost of pushing the leaf down
+        // (area growth inherited by the ancestors) is lower than pairing here
+        AABB leaf_box = this->nodes[leaf].box;
+        int index = this->root;
+        while(!this->nodes[index].is_leaf()) {
+            int left = this->nodes[index].left;
+            int right = this->nodes[index].right;
+
+            float area = this->nodes[index].box.surface_area();
+            float combined_area = AABB::merge(this->nodes[index].box, leaf_box).surface_area();
+
+            // Cost of creating a new parent for this node and the new leaf
+            float cost = 2.0f * combined_area;
+            // Minimum cost of pushing the leaf further down the tree
+            float inheritance_cost = 2.0f * (combined_area - area);
+
+            float cost_left = AABB::merge(leaf_box, this->nodes[left].box).surface_area() + inheritance_cost;
+            if(!this->nodes[left].is_leaf())
+                cost_left -= this->nodes[left].box.surface_area();
+            float cost_right = AABB::merge(leaf_box, this->nodes[right].box).surface_area() + inheritance_cost;
+            if(!this->nodes[right].is_leaf())
+                cost_right -= this->nodes[right].box.surface_area();
+
+            if(cost < cost_left && cost < cost_right)
+                break;
+            index = (cost_left < cost_right) ? left : right;
+        }
+        int sibling = index;
+
+        // Create a new parent for the sibling and the leaf
+        int old_parent = this->nodes[sibling].parent;
+        int new_parent = this->allocate_node();
+        this->nodes[new_parent].parent = old_parent;
+        this->nodes[new_parent].box = AABB::merge(leaf_box, this->nodes[sibling].box);
+        this->nodes[new_parent].height = this->nodes[sibling].height + 1;
+        this->nodes[new_parent].left = sibling;
+        this->nodes[new_parent].right = leaf;
+        this->nodes[sibling].parent = new_parent;
+        this->nodes[leaf].parent = new_parent;
+
+        if(old_parent != NULL_NODE) {
+            if(this->nodes[old_parent].left == sibling)
+                this->nodes[old_parent].left = new_parent;
+            else
+                this->nodes[old_parent].right = new_parent;
+        } else
+            this->root = new_parent;
+
+        this->refit(this->nodes[leaf].parent);
+    }
+
+    void DynamicAABBTree::remove_leaf(int leaf) {
+        if(leaf == this->root) {
+            this->root = NULL_NODE;
+            return;
+        }
+
+        int parent = this->nodes[leaf].parent;
+        int grand_parent = this->nodes[parent].parent;
+        int sibling = (this->nodes[parent].left == leaf) ? this->nodes[parent].right : this->nodes[parent].left;
+
+        // The sibling takes the place of the parent
+        if(grand_parent != NULL_NODE) {
+            if(this->nodes[grand_parent].left == parent)
+                this->nodes[grand_parent].left = sibling;
+            else
+                this->nodes[grand_parent].right = sibling;
+            this->nodes[sibling].parent = grand_parent;
+            this->free_node(parent);
+            this->refit(grand_parent);
+        } else {
+            this->root = sibling;
+            this->nodes[sibling].parent = NULL_NODE;
+            this->free_node(parent);
+        }
+    }
+
+    void DynamicAABBTree::refit(int node) {
+        while(node != NULL_NODE) {
+            node = this->balance(node);
+            int left = this->nodes[node].left;
+            int right = this->nodes[node].right;
+            this->nodes[node].height = 1 + std::max(this->nodes[left].height, this->nodes[right].height);
+            this->nodes[node].box = AABB::merge(this->nodes[left].box, this->nodes[right].box);
+            node = this->nodes[node].parent;
+        }
+    }
+
+    int DynamicAABBTree::balance(int a) {
+        Node& A = this->nodes[a];
+        if(A.is_leaf() || A.height < 2)
+            return a;
+
+        int b = A.left;
+        int c = A.right;
+        Node& B = this->nodes[b];
+        Node& C = this->nodes[c];
+        int diff = C.height - B.height;
+
+        if(diff > 1) {
+            // Rotate C up
+            int f = C.left;
+            int g = C.right;
+            Node& F = this->nodes[f];
+            Node& G = this->nodes[g];
+
+            C.left = a;
+            C.parent = A.parent;
+            A.parent = c;
+            if(C.parent != NULL_NODE) {
+                if(this->nodes[C.parent].left == a)
+                    this->nodes[C.parent].left = c;
+                else
+                    this->nodes[C.parent].right = c;
+            } else
+                this->root = c;
+
+            // The taller grandchild stays under C, the other one moves under A
+            if(F.height > G.height) {
+                C.right = f;
+                A.right = g;
+                G.parent = a;
+                A.box = AABB::merge(B.box, G.box);
+                C.box = AABB::merge(A.box, F.box);
+                A.height = 1 + std::max(B.height, G.height);
+                C.height = 1 + std::max(A.height, F.height);
+            } else {
+                C.right = g;
+                A.right = f;
+                F.parent = a;
+                A.box = AABB::merge(B.box, F.box);
+                C.box = AABB::merge(A.box, G.box);
+                A.height = 1 + std::max(B.height, F.height);
+                C.height = 1 + std::max(A.height, G.height);
+            }
+            return c;
+        }
+
+        if(diff < -1) {
+            // Rotate B up
+            int d = B.left;
+            int e = B.right;
+            Node& D = this->nodes[d];
+            Node& E = this->nodes[e];
+
+            B.left = a;
+            B.parent = A.parent;
+            A.parent = b;
+            if(B.parent != NULL_NODE) {
+                if(this->nodes[B.parent].left == a)
+                    this->nodes[B.parent].left = b;
+                else
+                    this->nodes[B.parent].right = b;
+            } else
+                this->root = b;
+
+            if(D.height > E.height) {
+                B.right = d;
+                A.left = e;
+                E.parent = a;
+                A.box = AABB::merge(C.box, E.box);
+                B.box = AABB::merge(A.box, D.box);
+                A.height = 1 + std::max(C.height, E.height);
+                B.height = 1 + std::max(A.height, D.height);
+            } else {
+                B.right = e;
+                A.left = d;
+                D.parent = a;
+                A.box = AABB::merge(C.box, D.box);
+                B.box = AABB::merge(A.box, E.box);
+                A.height = 1 + std::max(C.height, D.height);
+                B.height = 1 + std::max(A.height, E.height);
+            }
+            return b;
+        }
+
+        return a;
+    }
+}
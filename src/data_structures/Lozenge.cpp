@@ -1,4 +1,5 @@
 #include "../include/data_structures/Lozenge.hh"
+#include <stdexcept>
 
 namespace Geometry {
     Lozenge::Lozenge(Point3D c, Point3D e0, Point3D e1, float r) {
@@ -7,4 +8,18 @@ namespace Geometry {
         this->edge[1] = e1;
         this->radius = r;
     }
-}
\ No newline at end of file
+
+    Point3D Lozenge::getCenter() const {
+        return this->center;
+    }
+
+    Point3D Lozenge::getEdge(int index) const {
+        if(index < 0 || index > 1)
+            throw std::out_of_range("Index out of range");
+        return this->edge[index];
+    }
+
+    float Lozenge::getRadius() const {
+        return this->radius;
+    }
+}
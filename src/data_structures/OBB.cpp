@@ -1,5 +1,8 @@
 #include "../include/data_structures/OBB.hh"
-#include "../include/Matrix.hh"
+#include "../include/Mat3.hh"
+#include "../include/GeometricUtils.hh"
+#include "../include/QuickHull.hh"
+#include <algorithm>
 #include <cmath>
 #include <limits>
 
@@ -12,101 +15,234 @@ namespace Geometry {
         this->halfwidth = halfwidth;
     }
 
+    Point3D OBB::getCenter() const {
+        return this->center;
+    }
+
+    Point3D OBB::getAxis(int index) const {
+        if(index < 0 || index > 2)
+            throw std::out_of_range("Index out of range");
+        return this->local_axes[index];
+    }
+
+    Point3D OBB::getHalfwidth() const {
+        return this->halfwidth;
+    }
+
+    void OBB::min_volume(const std::vector<Vec3>& points, std::size_t max_faces) {
+        ConvexHull hull = QuickHull::quick_hull_3D(points);
+        // Fewer than three independent points: nothing to be flush with
+        if(hull.face_count() == 0) {
+            this->eigen_OBB(points.begin(), points.end());
+            return;
+        }
+        const std::vector<Vec3>& vertices = hull.getVertices();
+
+        // Candidate directions: principal axes of the hull vertices, then face normals, largest faces first
+        std::vector<Vec3> directions;
+        Vec3 values;
+        Mat3 vectors;
+        Moments(vertices.begin(), vertices.end()).covariance().symmetric_eigen(values, vectors);
+        for(int i = 0; i < 3; ++i)
+            directions.push_back(Vec3(vectors(0, i), vectors(1, i), vectors(2, i)));
+        std::vector<std::pair<float, std::size_t>> faces;
+        for(std::size_t f = 0; f < hull.face_count(); ++f) {
+            std::vector<int> polygon = hull.face_vertices(f);
+            Vec3 twice_area;
+            for(std::size_t i = 1; i + 1 < polygon.size(); ++i)
+                twice_area += cross(vertices[polygon[i]] - vertices[polygon[0]], vertices[polygon[i + 1]] - vertices[polygon[0]]);
+            faces.push_back(std::make_pair(-(twice_area * twice_area), f));
+        }
+        std::size_t count = max_faces == 0 ? faces.size() : std::min(max_faces, faces.size());
+        std::partial_sort(faces.begin(), faces.begin() + count, faces.end());
+        for(std::size_t i = 0; i < count; ++i)
+            directions.push_back(hull.getFaces()[faces[i].second].normal);
+
+        float best_volume = std::numeric_limits<float>::max(), best_surface = std::numeric_limits<float>::max();
+        std::vector<Point2D> projected(vertices.size());
+        for(const Vec3& n : directions) {
+            // Orthonormal basis (u, v, n), right-handed
+            Vec3 u = cross(n, std::abs(n.x) < 0.6f ? Vec3(1.0f, 0.0f, 0.0f) : Vec3(0.0f, 1.0f, 0.0f));
+            u = u / std::sqrt(u * u);
+            Vec3 v = cross(n, u);
+
+            // Minimum area rectangle of the hull projected along n; its axes are counter-clockwise in (u, v)
+            for(std::size_t i = 0; i < vertices.size(); ++i)
+                projected[i] = Point2D(vertices[i] * u, vertices[i] * v);
+            Point2D c;
+            std::pair<Point2D, Point2D> rectangle(Point2D(1.0f, 0.0f), Point2D(0.0f, 1.0f));
+            GeometryUtils::min_area_rectangle_of_points(projected.begin(), projected.end(), c, rectangle);
+            Vec3 axes[3] = { u * rectangle.first.getX() + v * rectangle.first.getY(),
+                             u * rectangle.second.getX() + v * rectangle.second.getY(),
+                             n };
+
+            // Keep the smallest box; flat boxes are compared by surface
+            OBB candidate;
+            float volume = candidate.fit_to_axes(vertices.begin(), vertices.end(), axes);
+            Point3D h = candidate.halfwidth;
+            float surface = h.getX() * h.getY() + h.getY() * h.getZ() + h.getZ() * h.getX();
+            if(volume < best_volume || (volume == best_volume && surface < best_surface)) {
+                best_volume = volume;
+                best_surface = surface;
+                *this = candidate;
+            }
+        }
+    }
+
     bool OBB::test_OBB_OBB_intersection(const OBB& other) const {
+        Vec3 ua[3] = { Vec3(this->local_axes[0]), Vec3(this->local_axes[1]), Vec3(this->local_axes[2]) };
+        Vec3 ub[3] = { Vec3(other.local_axes[0]), Vec3(other.local_axes[1]), Vec3(other.local_axes[2]) };
+        return OBB::test_OBB_OBB_intersection(Vec3(this->center), ua, Vec3(this->halfwidth), Vec3(other.center), ub, Vec3(other.halfwidth));
+    }
+
+    // Support function: separating axis test returning the index of the first separating axis (numbered as in `SeparatingAxisCache`), or -1 if the boxes intersect
+    static inline int first_separating_axis(const Vec3& ca, const Vec3 ua[3], const Vec3& ea, const Vec3& cb, const Vec3 ub[3], const Vec3& eb) {
         
         // Get the machine epsilon for the float type
         float epsilon = std::numeric_limits<float>::epsilon();
         float ra, rb;
-        Matrix R, AbsR;
+        // Stack-allocated: the test does no heap allocation
+        Mat3 R;
 
         // Compute rotation matrix expressing 'other' in 'this' 's coordinate frame
         for(int i = 0; i < 3; ++i) 
             for(int j = 0; j < 3; ++j)
-                R[i][j] = this->local_axes[i] * other.local_axes[j];
+                R[i][j] = ua[i] * ub[j];
         
         // Compute translation vector t
-        Point3D t = other.center - this->center;
+        Vec3 t = cb - ca;
         // Bring transaltion into a's coordinate frame
-        t = Point3D(t * this->local_axes[0], t * this->local_axes[2], t * this->local_axes[3]);
+        t = Vec3(t * ua[0], t * ua[1], t * ua[2]);
 
         // Compute common subexpressions. Add in an epsilon term to
         // counteract arithmetic errors when two edges are parallel and
         // their product is (near) null
-        for(int i = 0; i< 3; ++i)
-            for(int j = 0; j < 3; ++j)
-                AbsR[i][j] = abs(R[i][j]) + epsilon;
+        const Mat3 AbsR = R.abs(epsilon);
 
         // Test axes L = A0, L = A1, L = A2
         for(int i = 0; i < 3; ++i) {
-            ra = this->halfwidth[i];
-            rb = other.halfwidth[0] * AbsR[i][0] + other.halfwidth[1] * AbsR[i][1] + other.halfwidth[2] * AbsR[i][2];
-            if(abs(t[i]) > ra + rb)
-                return false;
+            ra = ea[i];
+            rb = eb[0] * AbsR[i][0] + eb[1] * AbsR[i][1] + eb[2] * AbsR[i][2];
+            if(std::abs(t[i]) > ra + rb)
+                return i;
         }
 
         // Test axes L = B0, L = B1, L = B2
         for(int i = 0; i < 3; ++i) {
-            ra = this->halfwidth[0] * AbsR[0][i] + this->halfwidth[1] * AbsR[1][i] + this->halfwidth[2] * AbsR[2][i];
-            rb = other.halfwidth[i];
-            if(abs(t[0] * R[0][i] + t[1] * R[1][i] + t[2] * R[2][i]) > ra + rb)
-                return false;
+            ra = ea[0] * AbsR[0][i] + ea[1] * AbsR[1][i] + ea[2] * AbsR[2][i];
+            rb = eb[i];
+            if(std::abs(t[0] * R[0][i] + t[1] * R[1][i] + t[2] * R[2][i]) > ra + rb)
+                return 3 + i;
         }
 
         // Test axes L = A0 x B0
-        ra = this->halfwidth[1] * AbsR[2][0] + this->halfwidth[2] * AbsR[1][0];
-        rb = other.halfwidth[1] * AbsR[0][2] + other.halfwidth[2] * AbsR[0][1];
-        if(abs(t[2] * R[1][0] - t[1] * R[2][0]) > ra + rb)
-            return false;
+        ra = ea[1] * AbsR[2][0] + ea[2] * AbsR[1][0];
+        rb = eb[1] * AbsR[0][2] + eb[2] * AbsR[0][1];
+        if(std::abs(t[2] * R[1][0] - t[1] * R[2][0]) > ra + rb)
+            return 6;
 
         // Test axis L = A0 x B1
-        ra = this->halfwidth[1] * AbsR[2][1] + this->halfwidth[2] * AbsR[1][1];
-        rb = other.halfwidth[0] * AbsR[0][2] + other.halfwidth[2] * AbsR[0][0];
-        if(abs(t[2] * R[1][1] - t[1] * R[2][1]) > ra + rb)
-            return false;
+        ra = ea[1] * AbsR[2][1] + ea[2] * AbsR[1][1];
+        rb = eb[0] * AbsR[0][2] + eb[2] * AbsR[0][0];
+        if(std::abs(t[2] * R[1][1] - t[1] * R[2][1]) > ra + rb)
+            return 7;
 
         // Test axis L = A0 x B2
-        ra = this->halfwidth[1] * AbsR[2][2] + this->halfwidth[2] * AbsR[1][2];
-        rb = other.halfwidth[0] * AbsR[0][1] + other.halfwidth[1] * AbsR[0][0];
-        if(abs(t[2] * R[1][2] - t[1] * R[2][2]) > ra + rb)
-            return false;
+        ra = ea[1] * AbsR[2][2] + ea[2] * AbsR[1][2];
+        rb = eb[0] * AbsR[0][1] + eb[1] * AbsR[0][0];
+        if(std::abs(t[2] * R[1][2] - t[1] * R[2][2]) > ra + rb)
+            return 8;
 
         // Test axis L = A1 x B0
-        ra = this->halfwidth[0] * AbsR[2][0] + this->halfwidth[2] * AbsR[0][0];
-        rb = other.halfwidth[1] * AbsR[1][2] + other.halfwidth[2] * AbsR[1][1];
-        if(abs(t[0] * R[2][0] - t[2] * R[0][0]) > ra + rb)
-            return false;
+        ra = ea[0] * AbsR[2][0] + ea[2] * AbsR[0][0];
+        rb = eb[1] * AbsR[1][2] + eb[2] * AbsR[1][1];
+        if(std::abs(t[0] * R[2][0] - t[2] * R[0][0]) > ra + rb)
+            return 9;
 
         // Test axis L = A1 x B1
-        ra = this->halfwidth[0] * AbsR[2][1] + this->halfwidth[2] * AbsR[0][1];
-        rb = other.halfwidth[0] * AbsR[1][2] + other.halfwidth[2] * AbsR[1][0];
-        if(abs(t[0] * R[2][1] - t[2] * R[0][1]) > ra + rb)
-            return false;
+        ra = ea[0] * AbsR[2][1] + ea[2] * AbsR[0][1];
+        rb = eb[0] * AbsR[1][2] + eb[2] * AbsR[1][0];
+        if(std::abs(t[0] * R[2][1] - t[2] * R[0][1]) > ra + rb)
+            return 10;
 
         // Test axis L = A1 x B2
-        ra = this->halfwidth[0] * AbsR[2][2] + this->halfwidth[2] * AbsR[0][2];
-        rb = other.halfwidth[0] * AbsR[1][1] + other.halfwidth[1] * AbsR[1][0];
-        if(abs(t[0] * R[2][2] - t[2] * R[0][2]) > ra + rb)
-            return false;
+        ra = ea[0] * AbsR[2][2] + ea[2] * AbsR[0][2];
+        rb = eb[0] * AbsR[1][1] + eb[1] * AbsR[1][0];
+        if(std::abs(t[0] * R[2][2] - t[2] * R[0][2]) > ra + rb)
+            return 11;
 
         // Test axis L = A2 x B0
-        ra = this->halfwidth[0] * AbsR[1][0] + this->halfwidth[1] * AbsR[0][0];
-        rb = other.halfwidth[1] * AbsR[2][2] + other.halfwidth[2] * AbsR[2][1];
-        if(abs(t[1] * R[0][0] - t[0] * R[1][0]) > ra + rb)
-            return false;
+        ra = ea[0] * AbsR[1][0] + ea[1] * AbsR[0][0];
+        rb = eb[1] * AbsR[2][2] + eb[2] * AbsR[2][1];
+        if(std::abs(t[1] * R[0][0] - t[0] * R[1][0]) > ra + rb)
+            return 12;
 
         // Test axis L = A2 x B1
-        ra = this->halfwidth[0] * AbsR[1][1] + this->halfwidth[1] * AbsR[0][1];
-        rb = other.halfwidth[0] * AbsR[2][2] + other.halfwidth[2] * AbsR[2][0];
-        if(abs(t[1] * R[0][1] - t[0] * R[1][1]) > ra + rb)
-            return false;
+        ra = ea[0] * AbsR[1][1] + ea[1] * AbsR[0][1];
+        rb = eb[0] * AbsR[2][2] + eb[2] * AbsR[2][0];
+        if(std::abs(t[1] * R[0][1] - t[0] * R[1][1]) > ra + rb)
+            return 13;
         
         // Test axis L = A2 x B2
-        ra = this->halfwidth[0] * AbsR[1][2] + this->halfwidth[1] * AbsR[0][2];
-        rb = other.halfwidth[0] * AbsR[2][1] + other.halfwidth[1] * AbsR[2][0];
-        if(abs(t[1] * R[0][2] - t[0] * R[1][2]) > ra + rb)
-            return false;
+        ra = ea[0] * AbsR[1][2] + ea[1] * AbsR[0][2];
+        rb = eb[0] * AbsR[2][1] + eb[1] * AbsR[2][0];
+        if(std::abs(t[1] * R[0][2] - t[0] * R[1][2]) > ra + rb)
+            return 14;
 
         // Since no separating axis is found, The OBBs must be intersecting
+        return -1;
+    }
+
+    bool OBB::test_OBB_OBB_intersection(const Vec3& ca, const Vec3 ua[3], const Vec3& ea, const Vec3& cb, const Vec3 ub[3], const Vec3& eb) {
+        return first_separating_axis(ca, ua, ea, cb, ub, eb) < 0;
+    }
+
+    bool OBB::test_OBB_OBB_intersection(const OBB& other, SeparatingAxisCache& cache) const {
+        Vec3 ua[3] = { Vec3(this->local_axes[0]), Vec3(this->local_axes[1]), Vec3(this->local_axes[2]) };
+        Vec3 ub[3] = { Vec3(other.local_axes[0]), Vec3(other.local_axes[1]), Vec3(other.local_axes[2]) };
+        return OBB::test_OBB_OBB_intersection(Vec3(this->center), ua, Vec3(this->halfwidth), Vec3(other.center), ub, Vec3(other.halfwidth), cache);
+    }
+
+    // Support function: test of the single axis `axis` of `first_separating_axis`, computing only the entries of R and t it needs (with the same arithmetic, so the result is identical)
+    static inline bool separated_on_cached_axis(int axis, const Vec3& ca, const Vec3 ua[3], const Vec3& ea, const Vec3& cb, const Vec3 ub[3], const Vec3& eb) {
+        const float epsilon = std::numeric_limits<float>::epsilon();
+        Vec3 d = cb - ca;
+        float ra, rb, dist;
+        if(axis < 3) {
+            ra = ea[axis];
+            rb = eb[0] * (std::abs(ua[axis] * ub[0]) + epsilon) + eb[1] * (std::abs(ua[axis] * ub[1]) + epsilon) + eb[2] * (std::abs(ua[axis] * ub[2]) + epsilon);
+            dist = d * ua[axis];
+        }
+        else if(axis < 6) {
+            int j = axis - 3;
+            float r0 = ua[0] * ub[j], r1 = ua[1] * ub[j], r2 = ua[2] * ub[j];
+            ra = ea[0] * (std::abs(r0) + epsilon) + ea[1] * (std::abs(r1) + epsilon) + ea[2] * (std::abs(r2) + epsilon);
+            rb = eb[j];
+            dist = (d * ua[0]) * r0 + (d * ua[1]) * r1 + (d * ua[2]) * r2;
+        }
+        else {
+            int i = (axis - 6) / 3, j = (axis - 6) % 3;
+            int i1 = (i + 1) % 3, i2 = (i + 2) % 3, j1 = (j + 1) % 3, j2 = (j + 2) % 3;
+            float r1j = ua[i1] * ub[j], r2j = ua[i2] * ub[j];
+            ra = ea[i1] * (std::abs(r2j) + epsilon) + ea[i2] * (std::abs(r1j) + epsilon);
+            rb = eb[j1] * (std::abs(ua[i] * ub[j2]) + epsilon) + eb[j2] * (std::abs(ua[i] * ub[j1]) + epsilon);
+            dist = (d * ua[i2]) * r1j - (d * ua[i1]) * r2j;
+        }
+        return std::abs(dist) > ra + rb;
+    }
+
+    bool OBB::test_OBB_OBB_intersection(const Vec3& ca, const Vec3 ua[3], const Vec3& ea, const Vec3& cb, const Vec3 ub[3], const Vec3& eb, SeparatingAxisCache& cache) {
+        // Last frame's separating axis first: for a persistent separated pair this is usually the only test
+        int cached = cache.axis;
+        if(cached != SeparatingAxisCache::NONE && separated_on_cached_axis(cached, ca, ua, ea, cb, ub, eb))
+            return false;
+
+        int axis = first_separating_axis(ca, ua, ea, cb, ub, eb);
+        if(axis >= 0) {
+            cache.axis = static_cast<std::uint8_t>(axis);
+            return false;
+        }
+        cache.axis = SeparatingAxisCache::NONE;
         return true;
     }
 }
\ No newline at end of file
@@ -0,0 +1,203 @@
+#include "../include/data_structures/OBBBatch.hh"
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace Geometry {
+
+    OBBBatch::OBBBatch() {}
+
+    std::size_t OBBBatch::add(const OBB& box) {
+        for(int i = 0; i < 3; ++i) {
+            this->center[i].push_back(0.0f);
+            this->halfwidth[i].push_back(0.0f);
+            for(int k = 0; k < 3; ++k)
+                this->axis[i][k].push_back(0.0f);
+        }
+        this->set(this->size() - 1, box);
+        return this->size() - 1;
+    }
+
+    void OBBBatch::set(std::size_t index, const OBB& box) {
+        if(index >= this->size())
+            throw std::out_of_range("Index out of range");
+        Point3D c = box.getCenter();
+        Point3D h = box.getHalfwidth();
+        for(int i = 0; i < 3; ++i) {
+            Point3D u = box.getAxis(i);
+            this->center[i][index] = c[i];
+            this->halfwidth[i][index] = h[i];
+            for(int k = 0; k < 3; ++k)
+                this->axis[i][k][index] = u[k];
+        }
+    }
+
+    OBB OBBBatch::get(std::size_t index) const {
+        if(index >= this->size())
+            throw std::out_of_range("Index out of range");
+        Point3D u[3];
+        for(int i = 0; i < 3; ++i)
+            u[i] = Point3D(this->axis[i][0][index], this->axis[i][1][index], this->axis[i][2][index]);
+        return OBB(Point3D(this->center[0][index], this->center[1][index], this->center[2][index]), u[0], u[1], u[2],
+                   Point3D(this->halfwidth[0][index], this->halfwidth[1][index], this->halfwidth[2][index]));
+    }
+
+    void OBBBatch::clear() {
+        for(int i = 0; i < 3; ++i) {
+            this->center[i].clear();
+            this->halfwidth[i].clear();
+            for(int k = 0; k < 3; ++k)
+                this->axis[i][k].clear();
+        }
+    }
+
+    std::size_t OBBBatch::size() const {
+        return this->center[0].size();
+    }
+
+    std::uint32_t OBBBatch::test_block(const std::uint32_t* a, const std::uint32_t* b, std::size_t count) const {
+        const float epsilon = std::numeric_limits<float>::epsilon();
+
+        // Gather the pairs into lane arrays. Unused lanes repeat the last pair
+        float ac[3][LANES], bc[3][LANES], ae[3][LANES], be[3][LANES];
+        float au[3][3][LANES], bu[3][3][LANES];
+        for(std::size_t l = 0; l < LANES; ++l) {
+            std::uint32_t ia = a[l < count ? l : count - 1];
+            std::uint32_t ib = b[l < count ? l : count - 1];
+            for(int i = 0; i < 3; ++i) {
+                ac[i][l] = this->center[i][ia];
+                bc[i][l] = this->center[i][ib];
+                ae[i][l] = this->halfwidth[i][ia];
+                be[i][l] = this->halfwidth[i][ib];
+                for(int k = 0; k < 3; ++k) {
+                    au[i][k][l] = this->axis[i][k][ia];
+                    bu[i][k][l] = this->axis[i][k][ib];
+                }
+            }
+        }
+
+        // Branch-free SAT: every lane evaluates all the 15 axes with the same
+        // operations of OBB::test_OBB_OBB_intersection and ORs the separations
+        std::uint32_t mask = 0;
+        for(std::size_t l = 0; l < LANES; ++l) {
+            float R[3][3], AbsR[3][3], t[3];
+            for(int i = 0; i < 3; ++i)
+                for(int j = 0; j < 3; ++j) {
+                    R[i][j] = au[i][0][l] * bu[j][0][l] + au[i][1][l] * bu[j][1][l] + au[i][2][l] * bu[j][2][l];
+                    AbsR[i][j] = std::abs(R[i][j]) + epsilon;
+                }
+            float tx = bc[0][l] - ac[0][l], ty = bc[1][l] - ac[1][l], tz = bc[2][l] - ac[2][l];
+            for(int i = 0; i < 3; ++i)
+                t[i] = tx * au[i][0][l] + ty * au[i][1][l] + tz * au[i][2][l];
+            float a0 = ae[0][l], a1 = ae[1][l], a2 = ae[2][l];
+            float b0 = be[0][l], b1 = be[1][l], b2 = be[2][l];
+
+            bool separated = false;
+            // L = A0, A1, A2
+            for(int i = 0; i < 3; ++i)
+                separated |= std::abs(t[i]) > ae[i][l] + (b0 * AbsR[i][0] + b1 * AbsR[i][1] + b2 * AbsR[i][2]);
+            // L = B0, B1, B2
+            for(int i = 0; i < 3; ++i)
+                separated |= std::abs(t[0] * R[0][i] + t[1] * R[1][i] + t[2] * R[2][i]) > (a0 * AbsR[0][i] + a1 * AbsR[1][i] + a2 * AbsR[2][i]) + be[i][l];
+            // L = A0 x B0, A0 x B1, A0 x B2
+            separated |= std::abs(t[2] * R[1][0] - t[1] * R[2][0]) > (a1 * AbsR[2][0] + a2 * AbsR[1][0]) + (b1 * AbsR[0][2] + b2 * AbsR[0][1]);
+            separated |= std::abs(t[2] * R[1][1] - t[1] * R[2][1]) > (a1 * AbsR[2][1] + a2 * AbsR[1][1]) + (b0 * AbsR[0][2] + b2 * AbsR[0][0]);
+            separated |= std::abs(t[2] * R[1][2] - t[1] * R[2][2]) > (a1 * AbsR[2][2] + a2 * AbsR[1][2]) + (b0 * AbsR[0][1] + b1 * AbsR[0][0]);
+            // L = A1 x B0, A1 x B1, A1 x B2
+            separated |= std::abs(t[0] * R[2][0] - t[2] * R[0][0]) > (a0 * AbsR[2][0] + a2 * AbsR[0][0]) + (b1 * AbsR[1][2] + b2 * AbsR[1][1]);
+            separated |= std::abs(t[0] * R[2][1] - t[2] * R[0][1]) > (a0 * AbsR[2][1] + a2 * AbsR[0][1]) + (b0 * AbsR[1][2] + b2 * AbsR[1][0]);
+            separated |= std::abs(t[0] * R[2][2] - t[2] * R[0][2]) > (a0 * AbsR[2][2] + a2 * AbsR[0][2]) + (b0 * AbsR[1][1] + b1 * AbsR[1][0]);
+            // L = A2 x B0, A2 x B1, A2 x B2
+            separated |= std::abs(t[1] * R[0][0] - t[0] * R[1][0]) > (a0 * AbsR[1][0] + a1 * AbsR[0][0]) + (b1 * AbsR[2][2] + b2 * AbsR[2][1]);
+            separated |= std::abs(t[1] * R[0][1] - t[0] * R[1][1]) > (a0 * AbsR[1][1] + a1 * AbsR[0][1]) + (b0 * AbsR[2][2] + b2 * AbsR[2][0]);
+            separated |= std::abs(t[1] * R[0][2] - t[0] * R[1][2]) > (a0 * AbsR[1][2] + a1 * AbsR[0][2]) + (b0 * AbsR[2][1] + b1 * AbsR[2][0]);
+
+            mask |= static_cast<std::uint32_t>(!separated) << l;
+        }
+
+        if(count < LANES)
+            mask &= (1u << count) - 1u;
+        return mask;
+    }
+
+    std::size_t OBBBatch::test_pairs(const std::uint32_t* a, const std::uint32_t* b, std::size_t n, std::uint32_t* mask) const {
+        std::size_t hits = 0;
+        for(std::size_t w = 0; w < (n + 31) / 32; ++w)
+            mask[w] = 0;
+        for(std::size_t first = 0; first < n; first += LANES) {
+            std::size_t count = (n - first < LANES) ? n - first : LANES;
+            std::uint32_t block = this->test_block(a + first, b + first, count);
+            // LANES divides 32, so a block never straddles two words
+            mask[first / 32] |= block << (first % 32);
+            for(std::uint32_t m = block; m != 0; m &= m - 1)
+                ++hits;
+        }
+        return hits;
+    }
+
+    std::size_t OBBBatch::filter_pairs(const std::uint32_t* a, const std::uint32_t* b, std::size_t n, std::uint32_t* out_a, std::uint32_t* out_b) const {
+        std::size_t hits = 0;
+        for(std::size_t first = 0; first < n; first += LANES) {
+            std::size_t count = (n - first < LANES) ? n - first : LANES;
+            std::uint32_t block = this->test_block(a + first, b + first, count);
+            // Branch-free compaction; hits <= first + l, so in-place filtering is safe
+            for(std::size_t l = 0; l < count; ++l) {
+                std::uint32_t ia = a[first + l], ib = b[first + l];
+                out_a[hits] = ia;
+                out_b[hits] = ib;
+                hits += (block >> l) & 1u;
+            }
+        }
+        return hits;
+    }
+
+    void OBBBatch::transform(const Transform* transforms, OBBBatch& out) const {
+        if(&out == this)
+            throw std::invalid_argument("OBBBatch::transform needs a distinct output batch");
+        std::size_t n = this->size();
+        for(int i = 0; i < 3; ++i) {
+            out.center[i].resize(n);
+            out.halfwidth[i] = this->halfwidth[i];
+            for(int k = 0; k < 3; ++k)
+                out.axis[i][k].resize(n);
+        }
+
+        const float* c[3] = { this->center[0].data(), this->center[1].data(), this->center[2].data() };
+        float* oc[3] = { out.center[0].data(), out.center[1].data(), out.center[2].data() };
+        const float* u[3][3];
+        float* ou[3][3];
+        for(int a = 0; a < 3; ++a)
+            for(int i = 0; i < 3; ++i) {
+                u[a][i] = this->axis[a][i].data();
+                ou[a][i] = out.axis[a][i].data();
+            }
+
+        // Blocks of LANES boxes are computed into lane arrays, so that the branch-free body
+        // is vectorized without run-time alias checks (see AABBBatch::transform), then copied out
+        for(std::size_t first = 0; first < n; first += LANES) {
+            std::size_t lanes = (n - first < LANES) ? n - first : LANES;
+            const Transform* T = transforms + first;
+            float lc[3][LANES], lu[3][3][LANES];
+            for(std::size_t l = 0; l < lanes; ++l) {
+                const Mat3& R = T[l].rotation;
+                const Vec3& t = T[l].translation;
+                std::size_t k = first + l;
+                float cx = c[0][k], cy = c[1][k], cz = c[2][k];
+                for(int i = 0; i < 3; ++i)
+                    lc[i][l] = t[i] + R(i, 0) * cx + R(i, 1) * cy + R(i, 2) * cz;
+                // The axes are directions: rotated, not translated
+                for(int a = 0; a < 3; ++a) {
+                    float ux = u[a][0][k], uy = u[a][1][k], uz = u[a][2][k];
+                    for(int i = 0; i < 3; ++i)
+                        lu[a][i][l] = R(i, 0) * ux + R(i, 1) * uy + R(i, 2) * uz;
+                }
+            }
+            for(std::size_t l = 0; l < lanes; ++l)
+                for(int i = 0; i < 3; ++i) {
+                    oc[i][first + l] = lc[i][l];
+                    for(int a = 0; a < 3; ++a)
+                        ou[a][i][first + l] = lu[a][i][l];
+                }
+        }
+    }
+}
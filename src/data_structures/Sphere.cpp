@@ -1,6 +1,91 @@
 #include "../include/data_structures/Sphere.hh"
+#include <algorithm>
+#include <random>
 
 namespace Geometry {
+
+    namespace {
+
+        /**
+         * @brief Double precision vector for the circumcenters of `minimum_sphere`.
+         */
+        struct Vec3d {
+            double x, y, z;
+        };
+
+        static Vec3d to_double(const Vec3& v) { return { v.x, v.y, v.z }; }
+        static Vec3d operator+(const Vec3d& a, const Vec3d& b) { return { a.x + b.x, a.y + b.y, a.z + b.z }; }
+        static Vec3d operator-(const Vec3d& a, const Vec3d& b) { return { a.x - b.x, a.y - b.y, a.z - b.z }; }
+        static Vec3d operator*(const Vec3d& a, double k) { return { a.x * k, a.y * k, a.z * k }; }
+        static double dot(const Vec3d& a, const Vec3d& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+        static Vec3d cross(const Vec3d& a, const Vec3d& b) { return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x }; }
+
+        /**
+         * @brief Sphere in double precision; a negative squared radius is the empty sphere.
+         */
+        struct Ball {
+            Vec3d center;
+            double r2;
+
+            bool contains(const Vec3& p) const {
+                Vec3d d = to_double(p) - this->center;
+                // Relative slack for the rounding of the boundary points
+                return dot(d, d) <= this->r2 * (1.0 + 1e-10);
+            }
+        };
+
+        static Ball ball_from(const Vec3* support, int count);
+
+        // Smallest of the spheres of the subsets of `support` (all but one point) that contains every point; used when the points are affinely dependent
+        static Ball ball_from_subsets(const Vec3* support, int count) {
+            Ball best = { { 0.0, 0.0, 0.0 }, -1.0 };
+            Ball largest = best;
+            for(int skip = 0; skip < count; ++skip) {
+                Vec3 subset[3];
+                int k = 0;
+                for(int i = 0; i < count; ++i)
+                    if(i != skip)
+                        subset[k++] = support[i];
+                Ball b = ball_from(subset, k);
+                if(b.contains(support[skip]) && (best.r2 < 0.0 || b.r2 < best.r2))
+                    best = b;
+                if(b.r2 > largest.r2)
+                    largest = b;
+            }
+            return best.r2 >= 0.0 ? best : largest;
+        }
+
+        // Smallest sphere with the `count` (0 to 4) points of `support` on its boundary
+        static Ball ball_from(const Vec3* support, int count) {
+            if(count == 0)
+                return { { 0.0, 0.0, 0.0 }, -1.0 };
+            Vec3d a = to_double(support[0]);
+            Vec3d offset = { 0.0, 0.0, 0.0 };
+            if(count == 2)
+                offset = (to_double(support[1]) - a) * 0.5;
+            else if(count == 3) {
+                Vec3d u = to_double(support[1]) - a, v = to_double(support[2]) - a;
+                Vec3d w = cross(u, v);
+                double uu = dot(u, u), vv = dot(v, v), ww = dot(w, w);
+                if(ww <= 1e-14 * uu * vv)
+                    return ball_from_subsets(support, count);
+                // Circumcenter: a + (|u|^2 (v x w) + |v|^2 (w x u)) / (2 |w|^2)
+                offset = (cross(v, w) * uu + cross(w, u) * vv) * (0.5 / ww);
+            }
+            else if(count == 4) {
+                Vec3d u = to_double(support[1]) - a, v = to_double(support[2]) - a, w = to_double(support[3]) - a;
+                Vec3d vw = cross(v, w);
+                double uu = dot(u, u), vv = dot(v, v), ww = dot(w, w);
+                double det = dot(u, vw);
+                if(det * det <= 1e-14 * uu * vv * ww)
+                    return ball_from_subsets(support, count);
+                // Circumcenter: a + (|u|^2 (v x w) + |v|^2 (w x u) + |w|^2 (u x v)) / (2 u . (v x w))
+                offset = (vw * uu + cross(w, u) * vv + cross(u, v) * ww) * (0.5 / det);
+            }
+            return { a + offset, dot(offset, offset) };
+        }
+    }
+
     Sphere::Sphere(Point3D c, float r) {
         this->center = c;
         this->radius = r;
@@ -14,13 +99,91 @@ namespace Geometry {
     }
 
     bool Sphere::test_sphere_sphere_intersection(const Sphere& other) const {
-        Point3D d = this->center - other.center;
+        return Sphere::test_sphere_sphere_intersection(Vec3(this->center), this->radius, Vec3(other.center), other.radius);
+    }
+
+    bool Sphere::test_sphere_sphere_intersection(const Vec3& c0, float r0, const Vec3& c1, float r1) {
+        Vec3 d = c0 - c1;
         float dist2 = d * d;
         // Spheres intersect if squared distance is less than squared sum of radii
-        float radiusSum = this->radius + other.radius;
+        float radiusSum = r0 + r1;
         return dist2 <= radiusSum * radiusSum;
     }
 
+    void Sphere::minimum_sphere(std::vector<Vec3>& points) {
+        if(points.empty()) {
+            this->center = Point3D(0.0f, 0.0f, 0.0f);
+            this->radius = 0.0f;
+            return;
+        }
+
+        // A random order gives the expected linear time; a fixed seed keeps the result reproducible
+        std::minstd_rand random(0x5eed);
+        std::shuffle(points.begin(), points.end(), random);
+
+        // Doubly linked list of the points, for the move-to-front
+        int n = static_cast<int>(points.size());
+        std::vector<int> next(n), prev(n);
+        for(int i = 0; i < n; ++i) {
+            next[i] = i + 1 < n ? i + 1 : -1;
+            prev[i] = i - 1;
+        }
+        int head = 0;
+
+        // Frame of level `s` (with `s` boundary points): the sphere of the boundary points and of the points before `end`, and the point being visited
+        struct Frame {
+            int current, end;
+        };
+        Frame frames[5];
+        Ball balls[5];
+        Vec3 support[4];
+        int s = 0;
+        balls[0] = ball_from(support, 0);
+        frames[0] = { head, -1 };
+        for(;;) {
+            Frame& frame = frames[s];
+            if(s == 4 || frame.current == frame.end) {
+                if(s == 0)
+                    break;
+                // Back to the parent: its sphere is the one found with its point on the boundary, and the point moves to the front
+                Ball found = balls[s];
+                --s;
+                balls[s] = found;
+                int i = frames[s].current;
+                frames[s].current = next[i];
+                if(i != head) {
+                    next[prev[i]] = next[i];
+                    if(next[i] >= 0)
+                        prev[next[i]] = prev[i];
+                    prev[i] = -1;
+                    next[i] = head;
+                    prev[head] = i;
+                    head = i;
+                }
+                continue;
+            }
+            int i = frame.current;
+            if(balls[s].contains(points[i])) {
+                frame.current = next[i];
+                continue;
+            }
+            // The sphere of the points before `i`, with `i` on the boundary
+            support[s] = points[i];
+            balls[s + 1] = ball_from(support, s + 1);
+            frames[s + 1] = { head, i };
+            ++s;
+        }
+
+        const Ball& b = balls[0];
+        Vec3 c(static_cast<float>(b.center.x), static_cast<float>(b.center.y), static_cast<float>(b.center.z));
+        // Grow the rounded sphere to the farthest point, so that all the points are inside in single precision too
+        float r2 = static_cast<float>(b.r2);
+        for(const Vec3& p : points)
+            r2 = std::max(r2, (p - c) * (p - c));
+        this->center = c.toPoint3D();
+        this->radius = std::sqrt(r2);
+    }
+
     void Sphere::update_sphere_with_outer_point(Point3D& point) {
         // Compute squared distance between point and sphere center
         Point3D d = point - this->center;
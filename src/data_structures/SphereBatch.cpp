@@ -0,0 +1,190 @@
+#include "../include/data_structures/SphereBatch.hh"
+#include <cmath>
+#include <stdexcept>
+
+namespace Geometry {
+
+    // Contact of two overlapping spheres given the offset (dx, dy, dz) from the
+    // first center to the second one, its squared length and the sum of the radii
+    static inline Vec4 sphere_contact(float dx, float dy, float dz, float dist2, float radius_sum) {
+        float dist = std::sqrt(dist2);
+        float inv = dist > 0.0f ? 1.0f / dist : 0.0f;
+        return Vec4(dist > 0.0f ? dx * inv : 1.0f, dy * inv, dz * inv, radius_sum - dist);
+    }
+
+    SphereBatch::SphereBatch() : count(0) {}
+
+    std::size_t SphereBatch::add(const Sphere& sphere) {
+        // Grow the arrays by a whole block so that the kernels never read out of bounds
+        if(this->count % LANES == 0) {
+            for(int i = 0; i < 3; ++i)
+                this->center[i].resize(this->count + LANES, 0.0f);
+            this->radius.resize(this->count + LANES, 0.0f);
+        }
+        ++this->count;
+        this->set(this->count - 1, sphere);
+        return this->count - 1;
+    }
+
+    void SphereBatch::set(std::size_t index, const Sphere& sphere) {
+        if(index >= this->count)
+            throw std::out_of_range("Index out of range");
+        Point3D c = sphere.getCenter();
+        for(int i = 0; i < 3; ++i)
+            this->center[i][index] = c[i];
+        this->radius[index] = sphere.getRadius();
+    }
+
+    Sphere SphereBatch::get(std::size_t index) const {
+        if(index >= this->count)
+            throw std::out_of_range("Index out of range");
+        return Sphere(Point3D(this->center[0][index], this->center[1][index], this->center[2][index]), this->radius[index]);
+    }
+
+    void SphereBatch::reserve(std::size_t n) {
+        std::size_t padded = (n + LANES - 1) / LANES * LANES;
+        for(int i = 0; i < 3; ++i)
+            this->center[i].reserve(padded);
+        this->radius.reserve(padded);
+    }
+
+    void SphereBatch::clear() {
+        for(int i = 0; i < 3; ++i)
+            this->center[i].clear();
+        this->radius.clear();
+        this->count = 0;
+    }
+
+    std::size_t SphereBatch::size() const {
+        return this->count;
+    }
+
+    const float* SphereBatch::getCenterData(int axis) const {
+        if(axis < 0 || axis > 2)
+            throw std::out_of_range("Index out of range");
+        return this->center[axis].data();
+    }
+
+    const float* SphereBatch::getRadiusData() const {
+        return this->radius.data();
+    }
+
+    std::uint32_t SphereBatch::overlap_block(std::size_t first, float cx, float cy, float cz, float r, Vec4* contacts) const {
+        const float* bx = this->center[0].data() + first;
+        const float* by = this->center[1].data() + first;
+        const float* bz = this->center[2].data() + first;
+        const float* br = this->radius.data() + first;
+
+        // Branch-free body: the compiler maps the lanes onto one SIMD register
+        std::uint32_t mask = 0;
+        for(std::size_t l = 0; l < LANES; ++l) {
+            float dx = bx[l] - cx, dy = by[l] - cy, dz = bz[l] - cz;
+            float dist2 = dx * dx + dy * dy + dz * dz;
+            float radius_sum = r + br[l];
+            mask |= static_cast<std::uint32_t>(dist2 <= radius_sum * radius_sum) << l;
+            if(contacts != nullptr)
+                contacts[l] = sphere_contact(dx, dy, dz, dist2, radius_sum);
+        }
+
+        // Clear the padding lanes of the last block
+        if(first + LANES > this->count)
+            mask &= (1u << (this->count - first)) - 1u;
+        return mask;
+    }
+
+    std::uint32_t SphereBatch::pair_block(const std::uint32_t* a, const std::uint32_t* b, std::size_t count, Vec4* contacts) const {
+        // Gather the pairs into lane arrays. Unused lanes repeat the last pair
+        float ac[3][LANES], bc[3][LANES], rs[LANES];
+        for(std::size_t l = 0; l < LANES; ++l) {
+            std::uint32_t ia = a[l < count ? l : count - 1];
+            std::uint32_t ib = b[l < count ? l : count - 1];
+            for(int i = 0; i < 3; ++i) {
+                ac[i][l] = this->center[i][ia];
+                bc[i][l] = this->center[i][ib];
+            }
+            rs[l] = this->radius[ia] + this->radius[ib];
+        }
+
+        std::uint32_t mask = 0;
+        for(std::size_t l = 0; l < LANES; ++l) {
+            float dx = bc[0][l] - ac[0][l], dy = bc[1][l] - ac[1][l], dz = bc[2][l] - ac[2][l];
+            float dist2 = dx * dx + dy * dy + dz * dz;
+            mask |= static_cast<std::uint32_t>(dist2 <= rs[l] * rs[l]) << l;
+            if(contacts != nullptr)
+                contacts[l] = sphere_contact(dx, dy, dz, dist2, rs[l]);
+        }
+
+        if(count < LANES)
+            mask &= (1u << count) - 1u;
+        return mask;
+    }
+
+    std::size_t SphereBatch::query(const Sphere& sphere, std::uint32_t* out, Vec4* contacts) const {
+        Point3D c = sphere.getCenter();
+        float cx = c.getX(), cy = c.getY(), cz = c.getZ(), r = sphere.getRadius();
+
+        std::size_t hits = 0;
+        Vec4 block_contacts[LANES];
+        for(std::size_t first = 0; first < this->count; first += LANES) {
+            std::uint32_t mask = this->overlap_block(first, cx, cy, cz, r, contacts != nullptr ? block_contacts : nullptr);
+            // Branch-free compaction: always write, advance only on a hit.
+            // hits <= first + l < size(), so the writes are always in bounds
+            for(std::size_t l = 0; l < LANES && first + l < this->count; ++l) {
+                out[hits] = static_cast<std::uint32_t>(first + l);
+                if(contacts != nullptr)
+                    contacts[hits] = block_contacts[l];
+                hits += (mask >> l) & 1u;
+            }
+        }
+        return hits;
+    }
+
+    std::size_t SphereBatch::test_pairs(const std::uint32_t* a, const std::uint32_t* b, std::size_t n, std::uint32_t* mask, Vec4* contacts) const {
+        std::size_t hits = 0;
+        for(std::size_t w = 0; w < (n + 31) / 32; ++w)
+            mask[w] = 0;
+        for(std::size_t first = 0; first < n; first += LANES) {
+            std::size_t count = (n - first < LANES) ? n - first : LANES;
+            Vec4 block_contacts[LANES];
+            std::uint32_t block = this->pair_block(a + first, b + first, count, contacts != nullptr ? block_contacts : nullptr);
+            // LANES divides 32, so a block never straddles two words
+            mask[first / 32] |= block << (first % 32);
+            for(std::uint32_t m = block; m != 0; m &= m - 1)
+                ++hits;
+            if(contacts != nullptr)
+                for(std::size_t l = 0; l < count; ++l)
+                    contacts[first + l] = block_contacts[l];
+        }
+        return hits;
+    }
+
+    void SphereBatch::transform(const Transform* transforms, SphereBatch& out) const {
+        if(&out == this)
+            throw std::invalid_argument("SphereBatch::transform needs a distinct output batch");
+        for(int i = 0; i < 3; ++i)
+            out.center[i].resize(this->center[i].size());
+        out.radius = this->radius;
+        out.count = this->count;
+
+        const float* c[3] = { this->center[0].data(), this->center[1].data(), this->center[2].data() };
+        float* oc[3] = { out.center[0].data(), out.center[1].data(), out.center[2].data() };
+
+        // Blocks of LANES spheres are computed into lane arrays, so that the branch-free body
+        // is vectorized without run-time alias checks (see AABBBatch::transform), then copied out
+        for(std::size_t first = 0; first < this->count; first += LANES) {
+            std::size_t lanes = (this->count - first < LANES) ? this->count - first : LANES;
+            const Transform* T = transforms + first;
+            float lc[3][LANES];
+            for(std::size_t l = 0; l < lanes; ++l) {
+                const Mat3& R = T[l].rotation;
+                const Vec3& t = T[l].translation;
+                float cx = c[0][first + l], cy = c[1][first + l], cz = c[2][first + l];
+                for(int i = 0; i < 3; ++i)
+                    lc[i][l] = t[i] + R(i, 0) * cx + R(i, 1) * cy + R(i, 2) * cz;
+            }
+            for(std::size_t l = 0; l < lanes; ++l)
+                for(int i = 0; i < 3; ++i)
+                    oc[i][first + l] = lc[i][l];
+        }
+    }
+}
@@ -0,0 +1,178 @@
+#include "../include/data_structures/SphereHashGrid.hh"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace Geometry {
+
+    SphereHashGrid::SphereHashGrid(float cell_size) : max_radius(0.0f), stamp(0) {
+        this->setCellSize(cell_size);
+    }
+
+    float SphereHashGrid::getCellSize() const {
+        return this->cell_size;
+    }
+
+    void SphereHashGrid::setCellSize(float cell_size) {
+        if(!(cell_size > 0.0f))
+            throw std::invalid_argument("Cell size must be positive");
+        this->cell_size = cell_size;
+    }
+
+    std::size_t SphereHashGrid::size() const {
+        return this->spheres.size();
+    }
+
+    int SphereHashGrid::cell_coordinate(float value) const {
+        double cell = std::floor(static_cast<double>(value) / this->cell_size);
+        // Also maps NaN to 0: every comparison with it is false
+        if(!(cell > -MAX_CELL))
+            return cell < 0.0 ? -MAX_CELL : 0;
+        if(cell > MAX_CELL)
+            return MAX_CELL;
+        return static_cast<int>(cell);
+    }
+
+    std::uint32_t SphereHashGrid::hash_cell(int x, int y, int z) const {
+        // Large primes spread neighbouring cells over the table; its size is a power of two
+        std::uint32_t h = static_cast<std::uint32_t>(x) * 73856093u
+                        ^ static_cast<std::uint32_t>(y) * 19349663u
+                        ^ static_cast<std::uint32_t>(z) * 83492791u;
+        return h & static_cast<std::uint32_t>(this->bucket_start.size() - 2);
+    }
+
+    void SphereHashGrid::rebuild() {
+        std::size_t n = this->spheres.size();
+
+        // Table with at least 2n buckets (power of two) plus one sentinel for the prefix sums
+        std::size_t buckets = 16;
+        while(buckets < 2 * n)
+            buckets <<= 1;
+        this->bucket_start.assign(buckets + 1, 0);
+        this->bucket_stamp.assign(buckets, 0);
+        this->stamp = 0;
+        this->bucket_of.resize(n);
+        this->sorted.clear();
+        this->large.clear();
+        this->max_radius = 0.0f;
+        const float large_radius = this->cell_size * LARGE_RADIUS;
+
+        // Counting sort, pass 1: histogram of the buckets; the large spheres go to their own list
+        for(std::size_t i = 0; i < n; ++i) {
+            float r = this->spheres[i].getRadius();
+            if(r > large_radius) {
+                this->large.push_back(static_cast<std::uint32_t>(i));
+                continue;
+            }
+            Point3D c = this->spheres[i].getCenter();
+            std::uint32_t b = this->hash_cell(this->cell_coordinate(c.getX()), this->cell_coordinate(c.getY()), this->cell_coordinate(c.getZ()));
+            this->bucket_of[i] = b;
+            ++this->bucket_start[b + 1];
+            this->max_radius = std::max(this->max_radius, r);
+        }
+        this->sorted.resize(n - this->large.size());
+
+        // Pass 2: prefix sums give the first slot of every bucket
+        for(std::size_t b = 0; b < buckets; ++b)
+            this->bucket_start[b + 1] += this->bucket_start[b];
+
+        // Pass 3: scatter, using the end of the previous bucket as write cursor
+        std::size_t next_large = 0;
+        for(std::size_t i = 0; i < n; ++i) {
+            if(next_large < this->large.size() && this->large[next_large] == i) {
+                ++next_large;
+                continue;
+            }
+            this->sorted[this->bucket_start[this->bucket_of[i]]++] = static_cast<std::uint32_t>(i);
+        }
+        // The scatter shifted every start to the next bucket: shift them back
+        for(std::size_t b = buckets; b > 0; --b)
+            this->bucket_start[b] = this->bucket_start[b - 1];
+        this->bucket_start[0] = 0;
+    }
+
+    void SphereHashGrid::gather_buckets(const int lo[3], const int hi[3]) const {
+        std::size_t buckets = this->bucket_stamp.size();
+        this->visited.clear();
+
+        double cells = 1.0;
+        for(int k = 0; k < 3; ++k)
+            cells *= static_cast<double>(hi[k]) - lo[k] + 1.0;
+        if(cells >= static_cast<double>(buckets)) {
+            for(std::size_t b = 0; b < buckets; ++b)
+                this->visited.push_back(static_cast<std::uint32_t>(b));
+            return;
+        }
+
+        // Two cells may share a bucket: the stamp keeps the first one only
+        if(++this->stamp == 0) {
+            std::fill(this->bucket_stamp.begin(), this->bucket_stamp.end(), 0);
+            this->stamp = 1;
+        }
+        for(int x = lo[0]; x <= hi[0]; ++x)
+            for(int y = lo[1]; y <= hi[1]; ++y)
+                for(int z = lo[2]; z <= hi[2]; ++z) {
+                    std::uint32_t b = this->hash_cell(x, y, z);
+                    if(this->bucket_stamp[b] != this->stamp) {
+                        this->bucket_stamp[b] = this->stamp;
+                        this->visited.push_back(b);
+                    }
+                }
+    }
+
+    void SphereHashGrid::candidate_pairs(std::vector<std::pair<std::uint32_t, std::uint32_t>>& out) const {
+        // Bounding cube rejection before the exact test
+        auto cubes_overlap = [this](std::uint32_t i, std::uint32_t j) {
+            Point3D ci = this->spheres[i].getCenter(), cj = this->spheres[j].getCenter();
+            float r = this->spheres[i].getRadius() + this->spheres[j].getRadius();
+            return std::abs(ci.getX() - cj.getX()) <= r && std::abs(ci.getY() - cj.getY()) <= r && std::abs(ci.getZ() - cj.getZ()) <= r;
+        };
+
+        // Grid spheres against grid spheres: the neighbourhood is sized by the sphere's own radius
+        for(std::uint32_t i : this->sorted) {
+            Point3D ci = this->spheres[i].getCenter();
+            float reach = this->spheres[i].getRadius() + this->max_radius;
+
+            int lo[3], hi[3];
+            for(int k = 0; k < 3; ++k) {
+                lo[k] = this->cell_coordinate(ci[k] - reach);
+                hi[k] = this->cell_coordinate(ci[k] + reach);
+            }
+            this->gather_buckets(lo, hi);
+
+            for(std::uint32_t b : this->visited) {
+                for(std::uint32_t s = this->bucket_start[b]; s < this->bucket_start[b + 1]; ++s) {
+                    std::uint32_t j = this->sorted[s];
+                    if(j > i && cubes_overlap(i, j))
+                        out.push_back(std::make_pair(i, j));
+                }
+            }
+        }
+
+        // Large spheres against every other sphere, each pair once
+        for(std::size_t a = 0; a < this->large.size(); ++a) {
+            std::uint32_t i = this->large[a];
+            for(std::uint32_t j : this->sorted)
+                if(cubes_overlap(i, j))
+                    out.push_back(std::make_pair(std::min(i, j), std::max(i, j)));
+            for(std::size_t b = a + 1; b < this->large.size(); ++b) {
+                std::uint32_t j = this->large[b];
+                if(cubes_overlap(i, j))
+                    out.push_back(std::make_pair(std::min(i, j), std::max(i, j)));
+            }
+        }
+    }
+
+    void SphereHashGrid::find_pairs(std::vector<std::pair<std::uint32_t, std::uint32_t>>& out) const {
+        std::size_t first = out.size();
+        this->candidate_pairs(out);
+
+        // Keep only the confirmed pairs, compacting in place
+        std::size_t kept = first;
+        for(std::size_t k = first; k < out.size(); ++k) {
+            if(this->spheres[out[k].first].test_sphere_sphere_intersection(this->spheres[out[k].second]))
+                out[kept++] = out[k];
+        }
+        out.resize(kept);
+    }
+}
@@ -0,0 +1,146 @@
+#include "../include/data_structures/SweepAndPrune.hh"
+#include <algorithm>
+#include <stdexcept>
+
+namespace Geometry {
+
+    SweepAndPrune::SweepAndPrune(PairCallback on_add, PairCallback on_remove) : on_add(on_add), on_remove(on_remove) {}
+
+    std::uint64_t SweepAndPrune::pair_key(std::uint32_t a, std::uint32_t b) {
+        if(a > b)
+            std::swap(a, b);
+        return (static_cast<std::uint64_t>(a) << 32) | b;
+    }
+
+    bool SweepAndPrune::test_proxy_overlap(std::uint32_t a, std::uint32_t b) const {
+        const Proxy& pa = this->proxies[a];
+        const Proxy& pb = this->proxies[b];
+        for(int i = 0; i < 3; ++i) {
+            if(pa.min[i] > pb.max[i] || pb.min[i] > pa.max[i])
+                return false;
+        }
+        return true;
+    }
+
+    void SweepAndPrune::refresh_pair(std::uint32_t a, std::uint32_t b) {
+        std::uint64_t key = SweepAndPrune::pair_key(a, b);
+        std::uint32_t lo = static_cast<std::uint32_t>(key >> 32);
+        std::uint32_t hi = static_cast<std::uint32_t>(key);
+        // The bounds are already final, so the test is idempotent: several swaps
+        // between the same two proxies in one update converge on the right state
+        if(this->test_proxy_overlap(a, b)) {
+            if(this->pair_set.insert(key).second && this->on_add)
+                this->on_add(lo, hi);
+        } else {
+            if(this->pair_set.erase(key) != 0 && this->on_remove)
+                this->on_remove(lo, hi);
+        }
+    }
+
+    std::uint32_t SweepAndPrune::add(const AABB& box) {
+        std::uint32_t id;
+        if(!this->free_ids.empty()) {
+            id = this->free_ids.back();
+            this->free_ids.pop_back();
+        } else {
+            id = static_cast<std::uint32_t>(this->proxies.size());
+            this->proxies.push_back(Proxy());
+        }
+        this->proxies[id].active = true;
+        this->move(id, box);
+
+        // Append min before max: the next update() sorts them into place, and every
+        // overlapping proxy is met along the way
+        for(int axis = 0; axis < 3; ++axis) {
+            this->endpoints[axis].push_back({this->proxies[id].min[axis], id << 1});
+            this->endpoints[axis].push_back({this->proxies[id].max[axis], (id << 1) | 1u});
+        }
+        return id;
+    }
+
+    void SweepAndPrune::remove(std::uint32_t id) {
+        if(id >= this->proxies.size() || !this->proxies[id].active)
+            throw std::out_of_range("Proxy id out of range");
+
+        for(int axis = 0; axis < 3; ++axis) {
+            std::vector<Endpoint>& list = this->endpoints[axis];
+            list.erase(std::remove_if(list.begin(), list.end(), [id](const Endpoint& e) { return (e.data >> 1) == id; }), list.end());
+        }
+
+        for(auto it = this->pair_set.begin(); it != this->pair_set.end();) {
+            std::uint32_t lo = static_cast<std::uint32_t>(*it >> 32);
+            std::uint32_t hi = static_cast<std::uint32_t>(*it);
+            if(lo == id || hi == id) {
+                it = this->pair_set.erase(it);
+                if(this->on_remove)
+                    this->on_remove(lo, hi);
+            } else
+                ++it;
+        }
+
+        this->proxies[id].active = false;
+        this->free_ids.push_back(id);
+    }
+
+    void SweepAndPrune::move(std::uint32_t id, const AABB& box) {
+        if(id >= this->proxies.size() || !this->proxies[id].active)
+            throw std::out_of_range("Proxy id out of range");
+        Point3D c = box.getCenter();
+        for(int i = 0; i < 3; ++i) {
+            this->proxies[id].min[i] = c[i] - box[i];
+            this->proxies[id].max[i] = c[i] + box[i];
+        }
+    }
+
+    void SweepAndPrune::sort_axis(int axis) {
+        std::vector<Endpoint>& list = this->endpoints[axis];
+
+        // Refresh the endpoint values from the proxies: O(n)
+        for(Endpoint& e : list) {
+            const Proxy& p = this->proxies[e.data >> 1];
+            e.value = (e.data & 1u) ? p.max[axis] : p.min[axis];
+        }
+
+        // Insertion sort: O(n + swaps). On equal values min endpoints come first,
+        // so touching boxes are reported as overlapping like test_AABB_AABB_intersection
+        for(std::size_t i = 1; i < list.size(); ++i) {
+            Endpoint key = list[i];
+            std::size_t j = i;
+            while(j > 0) {
+                const Endpoint& prev = list[j - 1];
+                bool greater = prev.value > key.value || (prev.value == key.value && (prev.data & 1u) && !(key.data & 1u));
+                if(!greater)
+                    break;
+                // A min endpoint crossing a max endpoint may start or end an overlap
+                if((prev.data & 1u) != (key.data & 1u) && (prev.data >> 1) != (key.data >> 1))
+                    this->refresh_pair(prev.data >> 1, key.data >> 1);
+                list[j] = prev;
+                --j;
+            }
+            list[j] = key;
+        }
+    }
+
+    void SweepAndPrune::update() {
+        for(int axis = 0; axis < 3; ++axis)
+            this->sort_axis(axis);
+    }
+
+    bool SweepAndPrune::is_overlapping(std::uint32_t a, std::uint32_t b) const {
+        return this->pair_set.count(SweepAndPrune::pair_key(a, b)) != 0;
+    }
+
+    std::size_t SweepAndPrune::pair_count() const {
+        return this->pair_set.size();
+    }
+
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> SweepAndPrune::get_pairs() const {
+        std::vector<std::uint64_t> keys(this->pair_set.begin(), this->pair_set.end());
+        std::sort(keys.begin(), keys.end());
+        std::vector<std::pair<std::uint32_t, std::uint32_t>> result;
+        result.reserve(keys.size());
+        for(std::uint64_t key : keys)
+            result.push_back(std::make_pair(static_cast<std::uint32_t>(key >> 32), static_cast<std::uint32_t>(key)));
+        return result;
+    }
+}